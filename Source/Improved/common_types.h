@@ -1,6 +1,8 @@
 #pragma once
 #include "constants.h"
 #include "interfaces.h"
+#include "hold_time.h"
+#include "task_executor.h"
 
 #include <chrono>
 #include <exception>
@@ -21,16 +23,19 @@ namespace NThreadSafe {
 
 		//lock bazli unordered_set'te her thread'e ait data seklinde tutulur. ilgili thread'in o lock'u ne zmaan aldigina vb dair bilgileri barindirir.
 		struct TMutexThreadData {
-			const std::chrono::steady_clock::time_point ownTime; // kilidin alinma zamani
+			const THoldStamp ownStamp; // kilidin alinma zamani, olcum moduna gore (bkz. hold_time.h)
 			std::atomic<size_t> lockCount; // mevcut kilit sayisi
-			TMutexThreadData() : ownTime(std::chrono::steady_clock::now()){
+			TMutexThreadData() : ownStamp(CHoldTimeTracker::Stamp()){
 				lockCount.store(1, std::memory_order_relaxed);
 			}
 
+			bool IsHeldTimeTracked() const noexcept {
+				return CHoldTimeTracker::IsTracked(ownStamp);
+			}
+
+			//Olcum kapaliysa ya da bu sahiplik orneklenmediyse 0.
 			uint64_t GetHeldMs() const noexcept {
-				return static_cast<uint64_t>(
-					std::chrono::duration_cast<std::chrono::milliseconds>(
-						std::chrono::steady_clock::now() - ownTime).count());
+				return CHoldTimeTracker::ElapsedMs(ownStamp);
 			}
 		};
 
@@ -48,7 +53,7 @@ namespace NThreadSafe {
 			};
 		private:
 			std::mutex m_operationMutex;
-			std::deque<TOperation> m_operations{};
+			std::optional<std::deque<TOperation>> m_operations{}; // ilk operasyonda olusturulur, bos deque de bellek ayirir.
 		public:
 			TLockData(std::shared_ptr<ILock> _ptr) : ptr(_ptr){}
 
@@ -58,23 +63,32 @@ namespace NThreadSafe {
 
 			size_t GetOperationCount() {
 				std::unique_lock<std::mutex> mute(m_operationMutex);
-				return m_operations.size();
+				return m_operations ? m_operations->size() : 0;
 			}
 
 			//Operasyonlar calisirken bir anda durdurup yeni operasyon ekleme secenegi olmalidir.
 
 			void AddOperation(OperationType&& _op, TData _data) {
 				std::unique_lock<std::mutex> mute(m_operationMutex);
-				m_operations.emplace_back(std::move(_op), _data);
+				if (!m_operations) m_operations.emplace();
+				m_operations->emplace_back(std::move(_op), _data);
 			}
 
 			//Kilit alindiktan sonra siradaki tum operasyonlar gerceklestirilir.
-			void RunOperations(std::atomic<bool>& bForce) {
+			void RunOperations(const CStopToken& bForce) {
 				std::unique_lock<std::mutex> mute(m_operationMutex);
-				while (!m_operations.empty() && !bForce) {
-					auto elem = std::move(m_operations.front());
-					m_operations.pop_front();
-					elem.op(elem.data);
+				while (m_operations && !m_operations->empty() && !bForce) {
+					auto elem = std::move(m_operations->front());
+					m_operations->pop_front();
+					//ReleaseLock (noexcept, ~CDataWrapper) da buradan calistirir: bir operasyonun hatasi digerlerini ve kilidi birakmayi engellememeli.
+					try {
+						elem.op(elem.data);
+					}
+					catch (...) {
+#ifdef LOG_THREAD_SAFE
+						LOG_ERR(LogClass::NORMAL, "Pending operation threw an exception.");
+#endif
+					}
 				}
 			}
 		};
@@ -89,7 +103,6 @@ namespace NThreadSafe {
 		static constexpr uint16_t OPERATION_TIMEOUT = 300; // 300 seconds
 		static constexpr uint16_t CLEANER_INTERVAL = 120; // 120 seconds
 		static constexpr uint32_t MAX_QUEUE_SIZE = 20000;
-		static constexpr const char* QUEUE_CLEANER_BASENAME = "ClearQueue_";
 
 		enum class EQueueState {
 			WORKING,
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <cstddef>
 
 
 //#define I_HAVE_LOG_SYSTEM
@@ -9,11 +10,32 @@
 #include <Singletons/log_manager.h>
 #endif
 
+//Toplu islemlerde siradaki kayitlarin bellegini onceden cache'e ceker. Sadece ipucudur, davranisi degistirmez.
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define THREAD_SAFE_PREFETCH(ptr) _mm_prefetch(reinterpret_cast<const char*>(ptr), _MM_HINT_T0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define THREAD_SAFE_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#define THREAD_SAFE_PREFETCH(ptr) ((void)(ptr))
+#endif
+
 namespace NThreadSafe {
 	namespace NLock {
+		using TLockID = uint32_t; //ISafeData'lara ait yogun (dense) kilit id'si
+		static constexpr TLockID INVALID_LOCK_ID = 0;
+		static constexpr TLockID MAX_LOCK_ID = UINT32_MAX;
+
 		static constexpr const char* PROGRESSER_THREADNAME = "QueueProgresser";
 		static constexpr uint16_t LOCK_ACQUIRE_TIMEOUT = 1000; //ms
 		static constexpr uint16_t LOG_HELD_MS_LIMIT = 3000;
+		static constexpr size_t CACHE_LINE_SIZE = 64;
+		static constexpr size_t READER_SLOT_COUNT = 64; // CDistributedReadLock okuyucu slot sayisi
+		static constexpr uint32_t WRITER_DRAIN_SPIN = 1024; // beklemeyen (Try) yazici, okuyucularin bitmesini bu kadar tur bekler
+		static constexpr size_t BATCH_PREFETCH_DISTANCE = 8; // toplu okumada kac kayit ileriye prefetch yapilir
+		static constexpr size_t MAX_NESTED_DRAIN = 8; // bir thread'de ic ice bekleyen operasyon calistirilan en fazla kilit sayisi
+		static constexpr uint32_t INLINE_SPIN_BEFORE_PARK = 64; // bekleyen thread inline kilidi bu kadar denedikten sonra uyutulur
+		static constexpr size_t PARKING_BUCKET_COUNT = 64; // uyuyan bekleyenlerin kilit adresine gore dagitildigi kova sayisi
 
 		enum class ELockType {
 			None,
@@ -25,12 +47,22 @@ namespace NThreadSafe {
 			AVAIL, //kilit alinabilir.
 			CANNOT,//kilit alinamaz
 			NEED_TO_CONVERT,//read kilidi sil, ayni datayla write kilit olustur. Verinin tek sahibi olmayi gerektirir.
+			DEADLOCK,//beklemek deadlock olusturuyor, istek iptal edildi (bkz. deadlock_detector.h).
 		};
 
 		enum class EWrapperResult {
 			SUCCESS, //kilit alindi data senin.
 			BUSY, // kilit alinamadi ama data valid, queue'ye operasyon eklenebilir.
 			DATA_NOT_EXISTS, //Data yok, hicbir islem yapilamaz.
+			DEADLOCK, //kilit beklemek deadlock olusturacakti, istek iptal edildi. Data valid, tutulan kilitler birakilip tekrar denenebilir.
+		};
+
+		enum class EApplyResult {
+			APPLIED, //kilit alindi, callable calisti.
+			DEFERRED, //kilit mesguldu, callable kilit musait oldugunda calistirilmak uzere operasyon olarak eklendi.
+			BUSY, //kilit mesguldu, callable calismadi.
+			DATA_NOT_EXISTS,
+			DEADLOCK, //kilit beklemek deadlock olusturacakti, callable calismadi.
 		};
 
 		enum class EAddOperationResult {
@@ -0,0 +1,136 @@
+#pragma once
+
+/*
+C++20 coroutine'ler icin kilit alma (sadece inline kilitli veriler).
+co_await tracker->Acquire(data, ELockType::Write) kilit musait degilse coroutine'i askiya alir; thread bloklanmaz.
+Kilit sirayla (FIFO) devredildiginde coroutine verilen executor'da, executor yoksa kilidi birakan thread'de devam eder.
+
+auto wrapper = co_await tracker->Acquire(person, ELockType::Write, [&pool](std::coroutine_handle<> h) { pool.Post(h); });
+if (wrapper) wrapper->m_age++;
+
+Kilit bekleyen coroutine devam ettirilmeden yok edilmemelidir.
+*/
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define THREAD_SAFE_HAS_COROUTINES 1
+
+#include "data_wrapper.h"
+#include "inline_lock.h"
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace NThreadSafe {
+	namespace NLock {
+		using TCoroutineExecutor = std::function<void(std::coroutine_handle<>)>;
+
+		//Executor verilmediginde coroutine'ler kilidi birakan thread'de devam eder.
+		//Devam eden coroutine baska bir kilidi birakip siradakini uyandirirsa ic ice cagri yerine kuyruga alinir, boylece yigin buyumez.
+		class CCoroutineTrampoline {
+		private:
+			static std::deque<std::coroutine_handle<>>*& GetQueue() noexcept {
+				thread_local std::deque<std::coroutine_handle<>>* s_queue = nullptr;
+				return s_queue;
+			}
+
+			struct TQueueScope {
+				std::deque<std::coroutine_handle<>> m_queue{};
+				TQueueScope() { GetQueue() = &m_queue; }
+				~TQueueScope() { GetQueue() = nullptr; }
+			};
+		public:
+			static void Resume(std::coroutine_handle<> _handle) {
+				if (auto* queue = GetQueue()) {
+					queue->push_back(_handle);
+					return;
+				}
+
+				TQueueScope scope{};
+				_handle.resume();
+				while (!scope.m_queue.empty()) {
+					auto next = scope.m_queue.front();
+					scope.m_queue.pop_front();
+					next.resume();
+				}
+			}
+		};
+
+		template<typename TData, typename TDiagPolicy = TDefaultDiag>
+		class CAcquireAwaitable {
+			using TElement = typename TData::element_type;
+			using TInlineAcquirer = TInlineLockAcquirer<TDiagPolicy>;
+			using TWrapper = CDataWrapper<TData, TDiagPolicy>;
+			static_assert(THasInlineLock<TElement>::value, "CAcquireAwaitable requires an inline-locked data type.");
+		private:
+			enum EState : uint8_t {
+				STATE_WAITING = 0,
+				STATE_GRANTED = 1, // kilit devredildi
+				STATE_SUSPENDED = 2, // coroutine askiya alindi
+			};
+
+			std::shared_ptr<INewThreadTracker> m_tracker;
+			TData m_data;
+			ELockType m_requestType;
+			TCoroutineExecutor m_executor;
+			TWrapper m_wrapper{};
+			std::coroutine_handle<> m_handle{};
+			std::atomic<uint8_t> m_state{ STATE_WAITING };
+		private:
+			void Resume() {
+				if (m_executor) {
+					m_executor(m_handle);
+				}
+				else {
+					CCoroutineTrampoline::Resume(m_handle);
+				}
+			}
+
+			void OnGranted() {
+				m_wrapper = TWrapper(ADOPT_LOCK, m_tracker, m_data, m_requestType);
+				//await_suspend henuz bitmediyse coroutine askiya alinmadan devam eder.
+				if (m_state.exchange(STATE_GRANTED, std::memory_order_acq_rel) == STATE_SUSPENDED) {
+					Resume();
+				}
+			}
+		public:
+			CAcquireAwaitable(std::shared_ptr<INewThreadTracker> _tracker, TData _data, ELockType _requestType, TCoroutineExecutor _executor = nullptr)
+				: m_tracker(std::move(_tracker)), m_data(std::move(_data)), m_requestType(_requestType), m_executor(std::move(_executor)) {}
+
+			CAcquireAwaitable(const CAcquireAwaitable&) = delete;
+			CAcquireAwaitable& operator=(const CAcquireAwaitable&) = delete;
+
+			bool await_ready() {
+				if (!m_data || m_requestType == ELockType::None) return true;
+
+				if (TInlineAcquirer::TryAcquireDetached(m_data->m_inlineLock, m_data->m_mutexID, m_requestType)) {
+					m_wrapper = TWrapper(ADOPT_LOCK, m_tracker, m_data, m_requestType);
+					return true;
+				}
+				return false;
+			}
+
+			bool await_suspend(std::coroutine_handle<> _handle) {
+				m_handle = _handle;
+				auto opRes = TInlineAcquirer::AddWaiter(m_data->m_inlineLock, m_data->m_mutexID, m_requestType, [this]() { OnGranted(); });
+				if (opRes == EAddOperationResult::FAILED) {
+#ifdef LOG_THREAD_SAFE
+					LOG_ERR(LogClass::NORMAL, "Acquire: waiter could not be added for mutexID(?).", m_data->m_mutexID);
+#endif
+					return false; // bos wrapper ile devam et
+				}
+
+				//Kilit bu arada devredildiyse askiya alma.
+				return m_state.exchange(STATE_SUSPENDED, std::memory_order_acq_rel) != STATE_GRANTED;
+			}
+
+			TWrapper await_resume() {
+				return std::move(m_wrapper);
+			}
+		};
+	};
+};
+#endif
@@ -0,0 +1,172 @@
+#pragma once
+#include <singleton.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/*
+CPU/NUMA topolojisi ve thread sabitleme (affinity).
+Linux'ta dugumler /sys/devices/system/node'dan okunur; diger platformlarda veya okunamazsa tum CPU'lar tek dugum sayilir.
+Sabitleme Linux (pthread_setaffinity_np) ve Windows'ta (SetThreadAffinityMask, ilk 64 CPU) yapilir, digerlerinde false doner.
+
+libnuma kullanilmaz: dugume yerel bellek "first touch" ile alinir, yani yapi o dugume sabitlenmis bir thread'de olusturulur (RunOn).
+*/
+namespace NThreadSafe {
+	using TCpuSet = std::vector<uint32_t>;
+
+	struct TNumaNode {
+		uint32_t m_id = 0;
+		TCpuSet m_cpus{};
+	};
+
+	class CCpuTopology : public CSingleton<CCpuTopology> {
+	private:
+		std::vector<TNumaNode> m_nodes{};
+		std::vector<uint32_t> m_cpuToNode{}; // cpu -> m_nodes indeksi
+	private:
+		//"0-3,8-11" bicimindeki listeyi acar.
+		static TCpuSet ParseCpuList(const std::string& _list) {
+			TCpuSet cpus{};
+			std::stringstream ss(_list);
+			std::string range{};
+			while (std::getline(ss, range, ',')) {
+				if (range.empty() || range[0] < '0' || range[0] > '9') continue;
+				const size_t dash = range.find('-');
+				try {
+					const uint32_t first = static_cast<uint32_t>(std::stoul(range.substr(0, dash)));
+					const uint32_t last = dash == std::string::npos ? first : static_cast<uint32_t>(std::stoul(range.substr(dash + 1)));
+					for (uint32_t cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+				}
+				catch (...) {}
+			}
+			return cpus;
+		}
+
+		void Detect() {
+#if defined(__linux__)
+			uint32_t misses = 0; // dugum numaralari seyrek olabilir
+			for (uint32_t node = 0; node < 1024 && misses < 64; ++node) {
+				std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+				if (!file) {
+					misses++;
+					continue;
+				}
+				misses = 0;
+				std::string list{};
+				std::getline(file, list);
+				TCpuSet cpus = ParseCpuList(list);
+				if (!cpus.empty()) m_nodes.push_back({ node, std::move(cpus) });
+			}
+#endif
+			if (m_nodes.empty()) {
+				TNumaNode node{};
+				const uint32_t cpuCount = std::max(1u, std::thread::hardware_concurrency());
+				for (uint32_t cpu = 0; cpu < cpuCount; ++cpu) node.m_cpus.push_back(cpu);
+				m_nodes.push_back(std::move(node));
+			}
+
+			for (uint32_t index = 0; index < m_nodes.size(); ++index) {
+				for (uint32_t cpu : m_nodes[index].m_cpus) {
+					if (cpu >= m_cpuToNode.size()) m_cpuToNode.resize(cpu + 1, 0);
+					m_cpuToNode[cpu] = index;
+				}
+			}
+		}
+	public:
+		CCpuTopology() {
+			Detect();
+		}
+
+		const std::vector<TNumaNode>& GetNodes() const noexcept {
+			return m_nodes;
+		}
+
+		size_t GetNodeCount() const noexcept {
+			return m_nodes.size();
+		}
+
+		//Dugum indeksi (GetNodes() sirasi), bilinmiyorsa 0.
+		uint32_t GetNodeOfCpu(uint32_t _cpu) const noexcept {
+			return _cpu < m_cpuToNode.size() ? m_cpuToNode[_cpu] : 0;
+		}
+
+		//Cagiran thread'in o an calistigi dugum. Thread sabitlenmemisse sadece bir ipucudur.
+		uint32_t GetCurrentNode() const noexcept {
+#if defined(__linux__)
+			const int cpu = sched_getcpu();
+			return cpu < 0 ? 0 : GetNodeOfCpu(static_cast<uint32_t>(cpu));
+#elif defined(_WIN32)
+			return GetNodeOfCpu(GetCurrentProcessorNumber());
+#else
+			return 0;
+#endif
+		}
+
+		static bool PinThread(std::thread::native_handle_type _thread, const TCpuSet& _cpus) {
+			if (_cpus.empty()) return false;
+#if defined(__linux__)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			for (uint32_t cpu : _cpus) {
+				if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+			}
+			return pthread_setaffinity_np(_thread, sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+			DWORD_PTR mask = 0;
+			for (uint32_t cpu : _cpus) {
+				if (cpu < sizeof(DWORD_PTR) * 8) mask |= DWORD_PTR(1) << cpu;
+			}
+			return mask != 0 && SetThreadAffinityMask(static_cast<HANDLE>(_thread), mask) != 0;
+#else
+			(void)_thread;
+			return false;
+#endif
+		}
+
+		static bool PinCurrentThread(const TCpuSet& _cpus) {
+			if (_cpus.empty()) return false;
+#if defined(__linux__)
+			return PinThread(pthread_self(), _cpus);
+#elif defined(_WIN32)
+			return PinThread(GetCurrentThread(), _cpus);
+#else
+			return false;
+#endif
+		}
+
+		//_func'i _cpus'a sabitlenmis gecici bir thread'de calistirir ve sonucunu dondurur.
+		//Dugume yerel yapilari olusturmak icin (first touch).
+		template<typename TFunc>
+		static auto RunOn(const TCpuSet& _cpus, TFunc&& _func) -> decltype(_func()) {
+			using TResult = decltype(_func());
+			if (_cpus.empty()) return _func();
+
+			if constexpr (std::is_void_v<TResult>) {
+				std::thread([&]() { PinCurrentThread(_cpus); _func(); }).join();
+			}
+			else {
+				TResult result{};
+				std::thread([&]() { PinCurrentThread(_cpus); result = _func(); }).join();
+				return result;
+			}
+		}
+	};
+#define cpuTopologyInstance NThreadSafe::CCpuTopology::getInstance()
+};
@@ -8,87 +8,167 @@ addheldlock calistirilir.
 yok olurken de removeheldlock calistirilir.
 */
 #include "interfaces.h"
+#include "inline_lock.h"
+#include "distributed_read_lock.h"
+#include "seq_lock.h"
+#include "fair_lock.h"
+#include "lock_profiler.h"
+#include "diagnostics.h"
 
 #include <type_traits>
 #include <memory>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <functional>
+#include <optional>
+#include <utility>
 
 
 namespace NThreadSafe {
 	namespace NLock {
-		//sadece shared_ptr tipindeki verileri kabul eder.
-		template<typename TData, typename std::enable_if<std::is_same_v<TData, std::shared_ptr<typename TData::element_type>>, int>::type = 0>
+		//Kilidi zaten alinmis (devredilmis) veri icin wrapper olusturmak icin kullanilir.
+		struct TAdoptLock {
+			explicit TAdoptLock() = default;
+		};
+		inline constexpr TAdoptLock ADOPT_LOCK{};
+
+		//Tracker ile yonetilen (std::shared_mutex) kilitleri alir ve birakir. CDataWrapper ve CNewThreadTracker::With kullanir.
+		//TDiagPolicy: tracker'in tanilama politikasi (bkz. diagnostics.h).
+		template<typename TDiagPolicy = TDefaultDiag>
+		class TTrackedLockAcquirer {
+			using TDiag = CDiagnostics<TDiagPolicy>;
+		private:
+			static EWrapperResult Fail(EWrapperResult _result, TLockID _mutexID, ELockType _requestType) noexcept {
+				profilerInstance.RecordBusy(_mutexID);
+				TDiag::Event(ELockEvent::Busy, _mutexID, _requestType);
+				return _result;
+			}
+		public:
+			//bWait false ise kilit baska thread'deyse beklenmez. Basarida _holdStart profilleyicinin alinma zamanidir (orneklenmediyse 0).
+			static EWrapperResult Acquire(INewThreadTracker& _tracker, std::shared_mutex& _mutex, TLockID _mutexID, ELockType _requestType, bool bWait, uint64_t& _holdStart) noexcept {
+				auto result_pair = _tracker.TryAcquireLock(_mutex, _mutexID, _requestType);
+				auto& lockData = result_pair.first;
+
+				//Kilidi asla alamayacaksak
+				if (!result_pair.second) return Fail(EWrapperResult::BUSY, _mutexID, _requestType);
+
+				//Kilit almak icin beklememiz gerekiyorsa
+				if (lockData.get()) {
+					if (!bWait) return Fail(EWrapperResult::BUSY, _mutexID, _requestType);
+
+					const uint64_t waitStart = profilerInstance.IsEnabled() ? CLockProfiler::Now() : 0;
+					const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(LOCK_ACQUIRE_TIMEOUT);
+					TDiag::Event(ELockEvent::WaitBegin, _mutexID, _requestType);
+					while (lockData) {
+						auto result = lockData->Wait(_requestType); // kilidin alinabilir olmasini bekle.
+
+						if (result == EAcquireResult::NEED_TO_CONVERT) {
+							//kilit tipini degistir.
+							profilerInstance.RecordConversion(_mutexID);
+							_tracker.ReleaseLock(_mutexID);
+							result_pair = _tracker.TryAcquireLock(_mutex, _mutexID, ELockType::Write);
+						}
+						else if (result == EAcquireResult::AVAIL) {
+							//Kilidi kendin almalisin.
+							result_pair = _tracker.TryAcquireLock(_mutex, _mutexID, _requestType);
+						}
+						else if (result == EAcquireResult::DEADLOCK) {
+							return Fail(EWrapperResult::DEADLOCK, _mutexID, _requestType);
+						}
+						else { //timeout durumu: veri gecerli, sadece kilit mesgul
+							return Fail(EWrapperResult::BUSY, _mutexID, _requestType);
+						}
+
+						if (!result_pair.second) return Fail(EWrapperResult::BUSY, _mutexID, _requestType);
+						//Uyanan baska bir thread kilidi once aldiysa yeni sahibi beklenir.
+						if (result_pair.first && std::chrono::steady_clock::now() >= deadline) return Fail(EWrapperResult::BUSY, _mutexID, _requestType);
+					}
+					profilerInstance.RecordWait(_mutexID, waitStart);
+					TDiag::Event(ELockEvent::Wait, _mutexID, _requestType);
+				}
+
+				//kilit alindi
+				profilerInstance.RecordAcquire(_mutexID);
+				_holdStart = profilerInstance.SampleHoldStart();
+				return EWrapperResult::SUCCESS;
+			}
+
+			static void Release(INewThreadTracker& _tracker, TLockID _mutexID, uint64_t _holdStart) noexcept {
+				_tracker.ReleaseLock(_mutexID);
+				profilerInstance.RecordHold(_mutexID, _holdStart);
+			}
+		};
+
+		using CTrackedLockAcquirer = TTrackedLockAcquirer<TDefaultDiag>;
+
+		//sadece shared_ptr tipindeki verileri kabul eder. TDiagPolicy, wrapper'i olusturan tracker'in tanilama politikasidir.
+		template<typename TData, typename TDiagPolicy = TDefaultDiag, typename std::enable_if<std::is_same_v<TData, std::shared_ptr<typename TData::element_type>>, int>::type = 0>
 		class CDataWrapper {
+			using TElement = typename TData::element_type;
+			using TInlineAcquirer = TInlineLockAcquirer<TDiagPolicy>;
+			using TTrackedAcquirer = TTrackedLockAcquirer<TDiagPolicy>;
+			static constexpr bool INLINE_LOCK = THasInlineLock<TElement>::value;
 		private:
 			std::shared_ptr<INewThreadTracker> m_tracker;
 			TData m_data; //Data pointer
-			uintptr_t m_mutexID; //data'ya ait mutex id'si
+			TLockID m_mutexID; //data'ya ait mutex id'si
 			std::atomic<EWrapperResult> m_result; // wrapper sonucu
+			ELockType m_detachedType = ELockType::None; // None degilse kilit thread kaydinda degildir (asenkron alinmistir)
+			uint64_t m_holdStart = 0; // profilleyici orneklediyse kilidin alinma zamani (tracker kilitleri icin)
 		public:
 			using TMutexRef = std::optional<std::reference_wrapper<std::shared_mutex>>;
 
-			CDataWrapper(std::shared_ptr<INewThreadTracker> _thTracker = nullptr, TData _data = nullptr, TMutexRef _mutex = std::nullopt, uintptr_t _mutexId = 0, ELockType _requestType = ELockType::Read)
+			CDataWrapper(std::shared_ptr<INewThreadTracker> _thTracker = nullptr, TData _data = nullptr, TMutexRef _mutex = std::nullopt, TLockID _mutexId = 0, ELockType _requestType = ELockType::Read)
 				: m_tracker(std::move(_thTracker)), m_data(std::move(_data)), m_mutexID(_mutexId) {
 				m_result.store(EWrapperResult::DATA_NOT_EXISTS, std::memory_order_release);				
+
+				if constexpr (INLINE_LOCK) {
+					//Kilit verinin icinde: tracker'a ugramadan dogrudan veri uzerinden alinir.
+					if (!m_data.get()) return;
+					m_mutexID = m_data->m_mutexID;
+					EWrapperResult result = TInlineAcquirer::Acquire(m_data->m_inlineLock, m_mutexID, _requestType);
+					if (result != EWrapperResult::SUCCESS) {
+						m_data.reset(); //data'yi invalid et cunku kilit alinamadi.
+					}
+					m_result.store(result, std::memory_order_release);
+					return;
+				}
 				
 				//Once veriye bak.
 				if (!m_tracker || !m_data.get() || m_mutexID == 0 || !_mutex.has_value()) return;
 
-				// TryAcquireLock'u structured binding kullanmadan çağır
-				auto result_pair = m_tracker->TryAcquireLock(_mutex.value().get(), m_mutexID, _requestType);
-				auto& lockData = result_pair.first;
-				auto& canAcquire = result_pair.second;
-
-				//Kilidi asla alamayacaksak
-				if (!canAcquire) {
-					m_result.store(EWrapperResult::BUSY, std::memory_order_release);
+				EWrapperResult result = TTrackedAcquirer::Acquire(*m_tracker, _mutex.value().get(), m_mutexID, _requestType, true, m_holdStart);
+				if (result != EWrapperResult::SUCCESS) {
 					m_data.reset(); //data'yi invalid et cunku kilit alinamadi.
-					return;
 				}
+				m_result.store(result, std::memory_order_release);
+			}
 
-				//Eger kilit almak icin beklememiz gerekiyorsa, hata durumlarinda wrapper'i invalid ettikten sonra return et.
-				if (lockData.get()) {
-					auto result = lockData->Wait(_requestType); // kilidin alinabilir olmasini bekle.
-
-					if (result == EAcquireResult::NEED_TO_CONVERT) {
-						//kilit tipini degistir.
-						m_tracker->ReleaseLock(m_mutexID);
-						auto result_pair = m_tracker->TryAcquireLock(_mutex.value().get(), m_mutexID, ELockType::Write);
-						bool& bSuccess = result_pair.second;
-						if (!bSuccess) {
-							m_result.store(EWrapperResult::BUSY, std::memory_order_release);
-							m_data.reset(); //data'yi invalid et cunku kilit alinamadi.
-							return;
-						}
-						//kilit alindi.
-					}
-					else if (result == EAcquireResult::AVAIL) {
-						//Kilidi kendin almalisin.
-						auto result_pair = m_tracker->TryAcquireLock(_mutex.value().get(), m_mutexID, _requestType);
-						auto& cnAcquire = result_pair.second;
-						if (!cnAcquire) {
-							m_result.store(EWrapperResult::BUSY, std::memory_order_release);
-							return;
-						}
-						//kilit alinmistir.
-					}
-					else { //timeout durumu
-						return;
-					}
-				}
-				
-				//kilidi dogrudan alabildiysek
-				m_result.store(EWrapperResult::SUCCESS, std::memory_order_release);
+			//Thread kaydina eklenmeden alinmis inline kilidi sahiplenir. Wrapper herhangi bir thread'de yok edilebilir.
+			CDataWrapper(TAdoptLock, std::shared_ptr<INewThreadTracker> _thTracker, TData _data, ELockType _heldType)
+				: m_tracker(std::move(_thTracker)), m_data(std::move(_data)), m_mutexID(0), m_detachedType(_heldType) {
+				static_assert(INLINE_LOCK, "Adopting a lock requires an inline-locked data type.");
+				m_mutexID = m_data ? m_data->m_mutexID : 0;
+				m_result.store(m_data ? EWrapperResult::SUCCESS : EWrapperResult::DATA_NOT_EXISTS, std::memory_order_release);
 			}
 		public:
 			
 			~CDataWrapper() {
 				//LOG_INFO(LogClass::NORMAL, "CDataWrapper destructor called with data: ?, result: ?, mutexId: ?", m_data.get(), m_result.load(std::memory_order_acquire), m_mutexID);
 				if (m_result == EWrapperResult::SUCCESS) {
-					//m_tracker varligini kontrol etmiyorum cunku basarili olduysa kesinlikle var olmalidir.
-					m_tracker->ReleaseLock(m_mutexID);
+					if constexpr (INLINE_LOCK) {
+						if (m_detachedType != ELockType::None) {
+							TInlineAcquirer::ReleaseDetached(m_data->m_inlineLock, m_mutexID, m_detachedType);
+						}
+						else {
+							TInlineAcquirer::Release(m_data->m_inlineLock);
+						}
+					}
+					else {
+						//m_tracker varligini kontrol etmiyorum cunku basarili olduysa kesinlikle var olmalidir.
+						TTrackedAcquirer::Release(*m_tracker, m_mutexID, m_holdStart);
+					}
 				}
 			}
 
@@ -96,7 +176,9 @@ namespace NThreadSafe {
 			CDataWrapper(CDataWrapper&& other) noexcept : 
 				m_tracker(std::move(other.m_tracker)),
 				m_data(std::move(other.m_data)), 
-				m_mutexID(other.m_mutexID) // std::move kullanmadık çünkü primitive tip 
+				m_mutexID(other.m_mutexID), // std::move kullanmadık çünkü primitive tip 
+				m_detachedType(std::exchange(other.m_detachedType, ELockType::None)),
+				m_holdStart(std::exchange(other.m_holdStart, 0))
 			{
 				//LOG_INFO(LogClass::NORMAL, "CDataWrapper move constructor called with data: ?, result: ?, mutexId: ?", m_data.get(), m_result.load(std::memory_order_acquire), m_mutexID);
 				m_result.store(other.m_result.load(std::memory_order_acquire), std::memory_order_release);
@@ -109,6 +191,8 @@ namespace NThreadSafe {
 					m_tracker = std::move(other.m_tracker);
 					m_data = std::move(other.m_data);
 					m_mutexID = other.m_mutexID; // std::move kullanmadık çünkü primitive tip	
+					m_detachedType = std::exchange(other.m_detachedType, ELockType::None);
+					m_holdStart = std::exchange(other.m_holdStart, 0);
 					m_result.store(other.m_result.load(std::memory_order_acquire), std::memory_order_release);
 					other.m_result.store(EWrapperResult::DATA_NOT_EXISTS, std::memory_order_release);
 				}
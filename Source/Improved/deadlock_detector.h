@@ -0,0 +1,206 @@
+#pragma once
+#include "constants.h"
+#include "common_types.h"
+#include "lock_watchdog.h"
+
+#include <singleton.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/*
+Calisma zamaninda deadlock tespiti (wait-for graph).
+Kilit id sirasi deadlock'u onler, fakat okuma->yazma donusumleri, operasyon closure'lari ve dogrudan mutex kullanimi yine de dongu olusturabilir.
+
+Graf sadece yavas yolda, bir thread beklemeye girerken gezilir: thread -> bekledigi kilit -> kilidin sahipleri -> onlarin bekledigi kilit...
+Kilit sahipleri ve bekledikleri kilit bekcinin kullandigi thread kayitlarindan (CHeldLockRegistry) okunur, bu yuzden tespit acikken alinan kilitler gorulur.
+Arama beklenen kilitten baslar ve sadece yol uzerindeki kilitlere bakar; global mutex yoktur. Bulunan dongu raporlanmadan once tekrar dogrulanir.
+Donguyu kapatan (en son beklemeye giren) thread raporlar; Fail modunda bu thread'in istegi DEADLOCK sonucu ile iptal edilir.
+
+Kapaliyken maliyet sadece bekleme yolunda tek bir relaxed okumadir, kilit hizli alindiginda hicbir sey yapilmaz.
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		enum class EDeadlockAction {
+			Report, // sadece raporla, bekleme timeout'a kadar devam eder
+			Fail, // donguyu kapatan istegi DEADLOCK ile iptal et
+		};
+
+		struct TDeadlockReport {
+			std::vector<TID> m_threads; // m_threads[i], m_locks[i]'yi bekler; m_locks[i]'yi m_threads[i + 1] tutar
+			std::vector<TLockID> m_locks;
+			bool m_bFailed = false; // istek iptal edildi mi (m_threads[0])
+		};
+
+		using TDeadlockCallback = std::function<void(const TDeadlockReport&)>;
+
+		class CDeadlockDetector : public CSingleton<CDeadlockDetector> {
+		private:
+			using THolders = std::vector<std::pair<TID, TLockID/*waitingFor*/>>;
+
+			std::atomic<bool> m_bEnabled{ false };
+			std::atomic<uint64_t> m_detectedCount{ 0 };
+
+			std::mutex m_mutex{}; // sadece ayarlar icin, bekleme yolunda dongu bulunmadikca alinmaz
+			EDeadlockAction m_action = EDeadlockAction::Report;
+			TDeadlockCallback m_callback{};
+		private:
+			static THolders GetHolders(TLockID _lockID) {
+				THolders holders{};
+				heldRegistryInstance.ForEachHolder(_lockID, [&](TID owner, TLockID waitingFor) { holders.emplace_back(owner, waitingFor); });
+				return holders;
+			}
+
+			//_start thread'inden baslayip tekrar _start'a donen yolu arar. Sadece yol uzerindeki kilitlerin sahiplerine bakilir. Bulunursa yol _report'a yazilir.
+			static bool FindCycle(TID _start, TLockID _lockID, TDeadlockReport& _report) {
+				struct TFrame {
+					TID m_thread;
+					TLockID m_lockID;
+					THolders m_holders;
+					size_t m_nextOwner;
+				};
+
+				std::vector<TFrame> path{};
+				path.push_back({ _start, _lockID, GetHolders(_lockID), 0 });
+				std::unordered_set<TID> visited{ _start };
+				while (!path.empty()) {
+					TFrame& top = path.back();
+					if (top.m_nextOwner >= top.m_holders.size()) {
+						path.pop_back();
+						continue;
+					}
+
+					const auto [owner, waitingFor] = top.m_holders[top.m_nextOwner++];
+					if (owner == top.m_thread) continue; // donusum bekleyen thread kendi okuma kilidini beklemez
+
+					if (owner == _start) {
+						for (const auto& frame : path) {
+							_report.m_threads.push_back(frame.m_thread);
+							_report.m_locks.push_back(frame.m_lockID);
+						}
+						return true;
+					}
+
+					if (waitingFor == INVALID_LOCK_ID) continue; // sahip beklemiyor, ilerleyecek
+					if (!visited.insert(owner).second) continue;
+					path.push_back({ owner, waitingFor, GetHolders(waitingFor), 0 });
+				}
+				return false;
+			}
+
+			//Yol farkli anlarda okunan kayitlardan kuruldu; her kenar hala gecerli mi (sahip kilidi tutuyor ve sonraki kilidi bekliyor)?
+			static bool ConfirmCycle(const TDeadlockReport& _report) {
+				const size_t count = _report.m_threads.size();
+				for (size_t i = 0; i < count; ++i) {
+					const TID next = _report.m_threads[(i + 1) % count];
+					const TLockID nextWait = _report.m_locks[(i + 1) % count];
+					bool bHeld = false;
+					heldRegistryInstance.ForEachHolder(_report.m_locks[i], [&](TID owner, TLockID waitingFor) {
+						if (owner == next && waitingFor == nextWait) bHeld = true;
+					});
+					if (!bHeld) return false;
+				}
+				return true;
+			}
+		public:
+			CDeadlockDetector() = default;
+
+			void Enable(EDeadlockAction _action = EDeadlockAction::Report, TDeadlockCallback _callback = nullptr) {
+				std::lock_guard<std::mutex> mute(m_mutex);
+				m_action = _action;
+				m_callback = std::move(_callback);
+				if (!m_bEnabled.exchange(true, std::memory_order_relaxed)) {
+					heldRegistryInstance.Activate();
+				}
+			}
+
+			void Disable() {
+				std::lock_guard<std::mutex> mute(m_mutex);
+				if (m_bEnabled.exchange(false, std::memory_order_relaxed)) {
+					heldRegistryInstance.Deactivate();
+				}
+			}
+
+			bool IsEnabled() const noexcept {
+				return m_bEnabled.load(std::memory_order_relaxed);
+			}
+
+			uint64_t GetDetectedCount() const noexcept {
+				return m_detectedCount.load(std::memory_order_relaxed);
+			}
+
+			//Thread _lockID'yi beklemeye baslar. Dongu bulunur ve Fail modundaysa thread beklememeli, true doner.
+			bool BeginWait(TLockID _lockID, bool bCanFail = true) {
+				const TID self = std::this_thread::get_id();
+				if (!heldRegistryInstance.BeginWait(_lockID)) return false;
+
+				TDeadlockReport report{};
+				try {
+					if (!FindCycle(self, _lockID, report) || !ConfirmCycle(report)) return false;
+				}
+				catch (...) {
+					return false; // tespit yapilamadi, normal bekle
+				}
+
+				m_detectedCount.fetch_add(1, std::memory_order_relaxed);
+				TDeadlockCallback callback{};
+				{
+					std::lock_guard<std::mutex> mute(m_mutex);
+					report.m_bFailed = bCanFail && m_action == EDeadlockAction::Fail;
+					try {
+						callback = m_callback;
+					}
+					catch (...) {}
+				}
+
+				if (callback) {
+					callback(report);
+				}
+#ifdef LOG_THREAD_SAFE
+				else {
+					LOG_ERR(LogClass::NORMAL, "Deadlock detected: thread(?) waiting for mutex(?), cycle length: ?, failed: ?", self, _lockID, report.m_threads.size(), report.m_bFailed);
+					for (size_t i = 0; i < report.m_threads.size(); ++i) {
+						LOG_ERR(LogClass::NORMAL, "  thread(?) waits for mutex(?)", report.m_threads[i], report.m_locks[i]);
+					}
+				}
+#endif
+				return report.m_bFailed;
+			}
+
+			void EndWait() noexcept {
+				heldRegistryInstance.EndWait();
+			}
+		};
+#define deadlockDetectorInstance NThreadSafe::NLock::CDeadlockDetector::getInstance()
+
+		//Bekleme suresince thread'i grafa ekler. Tespit kapaliysa hicbir sey yapmaz.
+		class CWaitScope {
+		private:
+			bool m_bRegistered = false;
+			bool m_bFail = false;
+		public:
+			explicit CWaitScope(TLockID _lockID, bool bCanFail = true) {
+				if (!deadlockDetectorInstance.IsEnabled()) return;
+				m_bRegistered = true;
+				m_bFail = deadlockDetectorInstance.BeginWait(_lockID, bCanFail);
+			}
+
+			~CWaitScope() {
+				if (m_bRegistered) deadlockDetectorInstance.EndWait();
+			}
+
+			CWaitScope(const CWaitScope&) = delete;
+			CWaitScope& operator=(const CWaitScope&) = delete;
+
+			//Dongu bulundu ve bu istek iptal edilmeli.
+			bool ShouldFail() const noexcept {
+				return m_bFail;
+			}
+		};
+	};
+};
@@ -0,0 +1,240 @@
+#pragma once
+#include "constants.h"
+#include "common_types.h"
+#include "lock_event.h"
+#include "lock_trace.h"
+
+#include <singleton.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/*
+Derleme zamaninda secilen tanilama (diagnostics) politikasi.
+Kapali seviyelerin cagrilari if constexpr ile tamamen silinir; sicak yolda ne dal ne de okuma kalir.
+
+None     : hicbir sey.
+Counters : olay tipi basina global sayaclar (relaxed atomic).
+Events   : Counters + olaylar asenkron halka tampona (CLockEventRing) yazilir, SetSink ile verilen fonksiyon ayri bir thread'de tuketir.
+Trace    : Events + tuketici thread olaylari loglar (LOG_THREAD_SAFE acikken). Kilit islemleri log icin hic beklemez.
+
+THREAD_SAFE_LOCK_TRACE=1 ile derlenirse olaylar seviyeden bagimsiz olarak calisma zamaninda acilan iz kaydina (lock_trace.h) da verilir;
+kayit kapaliyken maliyeti her olayda tek bir relaxed okumadir. Varsayilan 0'dir ve kayit noktasi derlemede silinir.
+
+CNewThreadTracker<TData, TDiagTrace> gibi tracker bazinda secilir; tracker politikasini CDataWrapper, TInlineLockAcquirer ve
+TTrackedLockAcquirer'a template parametresi olarak verir. Sadece tek sefer derlenen lock_types.cpp THREAD_SAFE_DIAG_LEVEL ile
+belirlenen TDefaultDiag'i kullanir (CInlineLockAcquirer/CTrackedLockAcquirer takma adlari da varsayilan politikadir).
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		enum class EDiagLevel : uint8_t {
+			None,
+			Counters,
+			Events,
+			Trace,
+		};
+
+#ifndef THREAD_SAFE_DIAG_LEVEL
+#ifdef LOG_THREAD_SAFE
+#define THREAD_SAFE_DIAG_LEVEL NThreadSafe::NLock::EDiagLevel::Trace
+#else
+#define THREAD_SAFE_DIAG_LEVEL NThreadSafe::NLock::EDiagLevel::None
+#endif
+#endif
+
+		template<EDiagLevel LEVEL>
+		struct TDiagPolicy {
+			static constexpr EDiagLevel level = LEVEL;
+		};
+
+		using TDiagNone = TDiagPolicy<EDiagLevel::None>;
+		using TDiagCounters = TDiagPolicy<EDiagLevel::Counters>;
+		using TDiagEvents = TDiagPolicy<EDiagLevel::Events>;
+		using TDiagTrace = TDiagPolicy<EDiagLevel::Trace>;
+		using TDefaultDiag = TDiagPolicy<THREAD_SAFE_DIAG_LEVEL>;
+
+		static constexpr size_t LOCK_EVENT_RING_SIZE = 1 << 14; // 2'nin kuvveti olmalidir
+
+		struct alignas(CACHE_LINE_SIZE) TDiagCounter {
+			std::atomic<uint64_t> m_value{ 0 };
+		};
+
+		class CDiagCounters {
+		private:
+			static inline std::array<TDiagCounter, LOCK_EVENT_COUNT> s_counters{};
+		public:
+			static void Increase(ELockEvent _event) noexcept {
+				s_counters[static_cast<size_t>(_event)].m_value.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			static uint64_t Get(ELockEvent _event) noexcept {
+				return s_counters[static_cast<size_t>(_event)].m_value.load(std::memory_order_relaxed);
+			}
+
+			static void Reset() noexcept {
+				for (auto& counter : s_counters) counter.m_value.store(0, std::memory_order_relaxed);
+			}
+		};
+
+		//Sinirli, kilitsiz, cok ureticili halka tampon. Dolu ise olay dusurulur, uretici asla beklemez.
+		//Tek tuketici thread ilk olayda baslatilir ve ornekle yasar; ornek yok edilirken kalan olaylari tuketip biter ve toplanir.
+		class CLockEventRing : public CSingleton<CLockEventRing> {
+		private:
+			struct TCell {
+				std::atomic<size_t> m_sequence{ 0 };
+				TLockEvent m_event{};
+			};
+
+			using TSink = std::function<void(const TLockEvent&)>;
+
+			std::unique_ptr<TCell[]> m_cells;
+			alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_enqueuePos{ 0 };
+			alignas(CACHE_LINE_SIZE) size_t m_dequeuePos = 0; // sadece tuketici
+			alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_dropped{ 0 };
+
+			std::mutex m_sinkMutex{};
+			std::shared_ptr<TSink> m_sink{};
+			std::atomic<bool> m_bLogEvents{ false };
+			std::once_flag m_startFlag{};
+			std::thread m_consumer{};
+			std::atomic<bool> m_bStop{ false };
+		private:
+			bool TryPop(TLockEvent& _event) noexcept {
+				TCell& cell = m_cells[m_dequeuePos & (LOCK_EVENT_RING_SIZE - 1)];
+				if (cell.m_sequence.load(std::memory_order_acquire) != m_dequeuePos + 1) return false;
+				_event = cell.m_event;
+				cell.m_sequence.store(m_dequeuePos + LOCK_EVENT_RING_SIZE, std::memory_order_release);
+				m_dequeuePos++;
+				return true;
+			}
+
+			void Consume(const TLockEvent& _event) {
+				std::shared_ptr<TSink> sink{};
+				{
+					std::lock_guard<std::mutex> mute(m_sinkMutex);
+					sink = m_sink;
+				}
+				if (sink && *sink) (*sink)(_event);
+
+#ifdef LOG_THREAD_SAFE
+				if (m_bLogEvents.load(std::memory_order_relaxed)) {
+					LOG_TRACE(LogClass::NORMAL, "[?] thread(?) mutex(?) type(?) arg(?)", ToString(_event.m_event), _event.m_thread, _event.m_lockID, _event.m_type, _event.m_arg);
+				}
+#endif
+			}
+
+			void Drain() {
+				TLockEvent event{};
+				for (;;) {
+					bool bAny = false;
+					while (TryPop(event)) {
+						bAny = true;
+						try {
+							Consume(event);
+						}
+						catch (...) {}
+					}
+					if (bAny) continue;
+					if (m_bStop.load(std::memory_order_acquire)) return;
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+
+			void StartConsumer() noexcept {
+				std::call_once(m_startFlag, [this]() {
+					try {
+						m_consumer = std::thread([this]() { Drain(); });
+					}
+					catch (...) {}
+				});
+			}
+		public:
+			CLockEventRing() : m_cells(new TCell[LOCK_EVENT_RING_SIZE]) {
+				for (size_t i = 0; i < LOCK_EVENT_RING_SIZE; ++i) {
+					m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+				}
+			}
+
+			//Sadece destroyAll/destroyInstance ile: olay ureten thread kalmamistir. Sink icinden yok edilmemelidir.
+			~CLockEventRing() {
+				m_bStop.store(true, std::memory_order_release);
+				if (m_consumer.joinable()) m_consumer.join();
+			}
+
+			bool TryPush(const TLockEvent& _event) noexcept {
+				StartConsumer();
+				size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+				for (;;) {
+					TCell& cell = m_cells[pos & (LOCK_EVENT_RING_SIZE - 1)];
+					const size_t seq = cell.m_sequence.load(std::memory_order_acquire);
+					const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+					if (diff == 0) {
+						if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+							cell.m_event = _event;
+							cell.m_sequence.store(pos + 1, std::memory_order_release);
+							return true;
+						}
+					}
+					else if (diff < 0) {
+						m_dropped.fetch_add(1, std::memory_order_relaxed); // dolu
+						return false;
+					}
+					else {
+						pos = m_enqueuePos.load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			//Olaylar tuketici thread'de bu fonksiyona verilir.
+			void SetSink(std::function<void(const TLockEvent&)> _sink) {
+				auto sink = _sink ? std::make_shared<TSink>(std::move(_sink)) : nullptr;
+				std::lock_guard<std::mutex> mute(m_sinkMutex);
+				m_sink = std::move(sink);
+			}
+
+			void SetLogEvents(bool bLog) noexcept {
+				m_bLogEvents.store(bLog, std::memory_order_relaxed);
+			}
+
+			uint64_t GetDroppedCount() const noexcept {
+				return m_dropped.load(std::memory_order_relaxed);
+			}
+		};
+#define lockEventRingInstance NThreadSafe::NLock::CLockEventRing::getInstance()
+
+		template<typename TPolicy>
+		class CDiagnostics {
+		public:
+			static constexpr EDiagLevel LEVEL = TPolicy::level;
+			static constexpr bool COUNTERS = LEVEL >= EDiagLevel::Counters;
+			static constexpr bool EVENTS = LEVEL >= EDiagLevel::Events;
+			static constexpr bool TRACE = LEVEL >= EDiagLevel::Trace;
+
+			static void Event(ELockEvent _event, TLockID _lockID, ELockType _type = ELockType::None, uint32_t _arg = 0) noexcept {
+#if THREAD_SAFE_LOCK_TRACE
+				CLockTraceRecorder::Record(_event, _lockID, _type, _arg);
+#endif
+				if constexpr (COUNTERS) {
+					CDiagCounters::Increase(_event);
+				}
+				if constexpr (EVENTS) {
+					if constexpr (TRACE) {
+						static const bool s_bLogging = (lockEventRingInstance.SetLogEvents(true), true);
+						(void)s_bLogging;
+					}
+					const uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+						std::chrono::steady_clock::now().time_since_epoch()).count());
+					lockEventRingInstance.TryPush({ now, std::this_thread::get_id(), _lockID, _event, _type, _arg });
+				}
+			}
+		};
+
+		using TDefaultDiagnostics = CDiagnostics<TDefaultDiag>;
+	};
+};
@@ -0,0 +1,213 @@
+#pragma once
+#include "constants.h"
+#include "inline_lock.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/*
+Okuma agirlikli (read-mostly) veriler icin dagitik okuma kilidi.
+Her thread kendine ait (cache line'a hizalanmis) bir okuyucu slot'unu arttirir; okuyucular
+ortak bir sayaci paylasmadigi icin ayni cache line'i hic yazmazlar.
+Yazici once yazici bayragini koyar, sonra tum slotlari tarayip okuyucularin bitmesini bekler.
+Bekleyen yazici (Lock) bayragi okuyucular bitene kadar birakmaz: bayrak konulduktan sonra yeni okuyucu giremez,
+surekli okuma akisi altinda da yazici zaman asimina kadar kilidi alir. Beklerken thread uyur; birakan taraf
+sadece uyuyan varsa mutex'e ugrar.
+
+Okuma cok ucuz, yazma ise slot sayisi kadar pahalidir. Sadece sicak ve cogunlukla okunan veriler icin kullanilmalidir:
+struct THotData : public IReadMostlySafeData { ... };
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		class CDistributedReadLock : public CPendingOperationStack {
+		private:
+			enum EWriterState : uint32_t {
+				WRITER_NONE = 0,
+				WRITER_PENDING = 1, // yazici okuyucularin bitmesini bekliyor
+				WRITER_HELD = 2,
+			};
+
+			struct alignas(CACHE_LINE_SIZE) TReaderSlot {
+				std::atomic<uint32_t> m_count{ 0 };
+			};
+
+			std::array<TReaderSlot, READER_SLOT_COUNT> m_readers{};
+			alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> m_writerState{ WRITER_NONE };
+			std::atomic<TID> m_writer{ TID() };
+			std::atomic<uint32_t> m_parked{ 0 }; // Lock icinde uyuyan thread sayisi
+
+			alignas(CACHE_LINE_SIZE) std::mutex m_parkMutex{};
+			std::condition_variable m_parkCv{};
+		private:
+			//Her thread'e sirayla bir slot verilir.
+			static size_t GetThreadSlot() noexcept {
+				static std::atomic<size_t> s_nextSlot{ 0 };
+				thread_local size_t s_slot = s_nextSlot.fetch_add(1, std::memory_order_relaxed) % READER_SLOT_COUNT;
+				return s_slot;
+			}
+
+			//Slotlar farkli thread'lerde birakilabildigi icin tek tek degil toplam olarak anlamlidir (mod 2^32).
+			uint32_t SumReaders() const noexcept {
+				uint32_t sum = 0;
+				for (const auto& slot : m_readers) {
+					sum += slot.m_count.load(std::memory_order_seq_cst);
+				}
+				return sum;
+			}
+
+			//Bayrak konulduktan sonra okuyucu sayisinin _expected'a inmesini sinirli sure bekler.
+			bool DrainReaders(uint32_t _expected) noexcept {
+				for (uint32_t spin = 0; spin < WRITER_DRAIN_SPIN; ++spin) {
+					if (SumReaders() == _expected) return true;
+					std::this_thread::yield();
+				}
+				return false;
+			}
+
+			//Uyuyan varsa uyandirir. Durum degisikligi (okuyucu sayisi, yazici durumu) bu cagridan once yapilmalidir.
+			void WakeParked() noexcept {
+				if (m_parked.load(std::memory_order_seq_cst) == 0) return;
+				std::lock_guard<std::mutex> mute(m_parkMutex);
+				m_parkCv.notify_all();
+			}
+
+			//_pred saglanana ya da _deadline gelene kadar uyur. _pred m_parkMutex altinda, sayac arttirildiktan sonra kontrol edilir;
+			//birakan taraf durumu degistirip sayaci okudugu icin uyandirma kaybolmaz.
+			template<typename TPred>
+			bool ParkUntil(TPred&& _pred, std::chrono::steady_clock::time_point _deadline) noexcept {
+				std::unique_lock<std::mutex> mute(m_parkMutex);
+				m_parked.fetch_add(1, std::memory_order_seq_cst);
+				const bool bReady = m_parkCv.wait_until(mute, _deadline, std::forward<TPred>(_pred));
+				m_parked.fetch_sub(1, std::memory_order_relaxed);
+				return bReady;
+			}
+
+			bool IsWriterFree() const noexcept {
+				return m_writerState.load(std::memory_order_seq_cst) == WRITER_NONE;
+			}
+
+			void ClearPending() noexcept {
+				m_writerState.store(WRITER_NONE, std::memory_order_seq_cst);
+				WakeParked();
+			}
+		public:
+			CDistributedReadLock() = default;
+
+			bool TryLockShared() noexcept {
+				auto& slot = m_readers[GetThreadSlot()].m_count;
+				slot.fetch_add(1, std::memory_order_seq_cst);
+				if (m_writerState.load(std::memory_order_seq_cst) == WRITER_NONE) return true;
+
+				//yazici var, geri cekil. Okuyucularin bitmesini bekleyen yazici bizi saymis olabilir.
+				slot.fetch_sub(1, std::memory_order_seq_cst);
+				WakeParked();
+				return false;
+			}
+
+			//Beklemeden dener: okuyucular WRITER_DRAIN_SPIN turda bitmezse bayrak kaldirilir. Beklenecekse Lock kullanilmalidir.
+			bool TryLockExclusive() noexcept {
+				uint32_t expected = WRITER_NONE;
+				if (!m_writerState.compare_exchange_strong(expected, WRITER_PENDING, std::memory_order_seq_cst)) return false;
+
+				if (!DrainReaders(0)) {
+					ClearPending();
+					return false;
+				}
+
+				m_writer.store(std::this_thread::get_id(), std::memory_order_relaxed);
+				m_writerState.store(WRITER_HELD, std::memory_order_seq_cst);
+				return true;
+			}
+
+			//Tek okuyucu biz isek okuma kilidini yazma kilidine cevirir.
+			bool TryUpgrade() noexcept {
+				uint32_t expected = WRITER_NONE;
+				if (!m_writerState.compare_exchange_strong(expected, WRITER_PENDING, std::memory_order_seq_cst)) return false;
+
+				if (!DrainReaders(1)) {
+					ClearPending();
+					return false;
+				}
+
+				//kendi okuma sayacimizi birak, artik yazariz.
+				m_readers[GetThreadSlot()].m_count.fetch_sub(1, std::memory_order_relaxed);
+				m_writer.store(std::this_thread::get_id(), std::memory_order_relaxed);
+				m_writerState.store(WRITER_HELD, std::memory_order_seq_cst);
+				return true;
+			}
+
+			//Kilidi _deadline'a kadar bekler (bkz. THasBlockingLock). Okuyucu yazici bitene kadar uyur.
+			//Yazici bayragi koyar ve okuyucular bitene kadar tutar; zaman asiminda bayrak kaldirilir ve false doner.
+			bool Lock(ELockType _requestType, std::chrono::steady_clock::time_point _deadline) noexcept {
+				if (_requestType == ELockType::Read) {
+					while (!TryLockShared()) {
+						if (!ParkUntil([this]() { return IsWriterFree(); }, _deadline)) return false;
+					}
+					return true;
+				}
+
+				for (;;) {
+					uint32_t expected = WRITER_NONE;
+					if (m_writerState.compare_exchange_strong(expected, WRITER_PENDING, std::memory_order_seq_cst)) break;
+					if (!ParkUntil([this]() { return IsWriterFree(); }, _deadline)) return false;
+				}
+
+				if (!ParkUntil([this]() { return SumReaders() == 0; }, _deadline)) {
+					ClearPending();
+					return false;
+				}
+
+				m_writer.store(std::this_thread::get_id(), std::memory_order_relaxed);
+				m_writerState.store(WRITER_HELD, std::memory_order_seq_cst);
+				return true;
+			}
+
+			void UnlockShared() noexcept {
+				m_readers[GetThreadSlot()].m_count.fetch_sub(1, std::memory_order_seq_cst);
+				//bekleyen yazici varsa son okuyucuyu bekliyor olabilir.
+				if (m_writerState.load(std::memory_order_seq_cst) == WRITER_PENDING) WakeParked();
+			}
+
+			void UnlockExclusive() noexcept {
+				m_writer.store(TID(), std::memory_order_relaxed);
+				ClearPending();
+			}
+
+			//Yazma kilidini _readers adet okuma kilidine cevirir. Sayaclar toplam olarak anlamli oldugu icin hepsi bizim slota yazilir.
+			void Downgrade(uint32_t _readers) noexcept {
+				m_readers[GetThreadSlot()].m_count.fetch_add(_readers, std::memory_order_relaxed);
+				m_writer.store(TID(), std::memory_order_relaxed);
+				ClearPending();
+			}
+
+			//HandOff: yazma kilidi devredildi, m_writer eski sahibi gostermemeli.
+			void ClearWriter() noexcept {
+				m_writer.store(TID(), std::memory_order_relaxed);
+			}
+
+			bool IsWriteLocked() const noexcept {
+				return m_writerState.load(std::memory_order_acquire) == WRITER_HELD;
+			}
+
+			uint32_t GetReaderCount() const noexcept {
+				return SumReaders();
+			}
+
+			//Kimse tutmuyor. Tum slotlar okunur.
+			bool IsFree() const noexcept {
+				return m_writerState.load(std::memory_order_acquire) == WRITER_NONE && SumReaders() == 0;
+			}
+
+			TID GetWriter() const noexcept {
+				return m_writer.load(std::memory_order_relaxed);
+			}
+		};
+
+		using IReadMostlySafeData = TInlineSafeData<CDistributedReadLock>;
+	};
+};
@@ -0,0 +1,220 @@
+#pragma once
+#include "constants.h"
+#include "epoch_manager.h"
+#include "inline_lock.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+CSafeDataStore'un epoch modlu karsiligi.
+Veriler shared_ptr yerine ham pointer olarak tutulur; omurlerini CEpochManager yonetir.
+Erase edilen veri hemen silinmez, onu gorebilecek tum okuyucular epoch'tan ciktiktan sonra silinir.
+
+Sadece inline kilitli veriler (TInlineSafeData) desteklenir: kilit kaydi veri icinde oldugu icin
+tracker'in shared_ptr tutmasina gerek kalmaz.
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		//Ham pointer tutan wrapper. Omrunu icindeki CEpochGuard korur; olusturuldugu thread'de yok edilmelidir.
+		template<typename TElement>
+		class CEpochDataWrapper {
+			static_assert(THasInlineLock<TElement>::value, "CEpochDataWrapper requires an inline-locked data type.");
+		private:
+			CEpochGuard m_guard; // once olusturulur, en son yok edilir
+			TElement* m_data;
+			EWrapperResult m_result;
+		public:
+			CEpochDataWrapper() : m_guard(false), m_data(nullptr), m_result(EWrapperResult::DATA_NOT_EXISTS) {}
+
+			//_guard, _data'nin bulundugu anda zaten alinmis olmalidir.
+			CEpochDataWrapper(CEpochGuard&& _guard, TElement* _data, ELockType _requestType)
+				: m_guard(std::move(_guard)), m_data(_data), m_result(EWrapperResult::DATA_NOT_EXISTS) {
+				if (!m_data) return;
+
+				m_result = CInlineLockAcquirer::Acquire(m_data->m_inlineLock, m_data->m_mutexID, _requestType);
+				if (m_result != EWrapperResult::SUCCESS) {
+					m_data = nullptr; //kilit alinamadi
+				}
+			}
+
+			~CEpochDataWrapper() {
+				if (m_result == EWrapperResult::SUCCESS) {
+					CInlineLockAcquirer::Release(m_data->m_inlineLock);
+				}
+			}
+
+			CEpochDataWrapper(CEpochDataWrapper&& other) noexcept
+				: m_guard(std::move(other.m_guard)),
+				m_data(std::exchange(other.m_data, nullptr)),
+				m_result(std::exchange(other.m_result, EWrapperResult::DATA_NOT_EXISTS)) {}
+
+			CEpochDataWrapper& operator=(CEpochDataWrapper&& other) noexcept {
+				if (this != &other) {
+					if (m_result == EWrapperResult::SUCCESS) {
+						CInlineLockAcquirer::Release(m_data->m_inlineLock);
+					}
+					m_data = std::exchange(other.m_data, nullptr);
+					m_result = std::exchange(other.m_result, EWrapperResult::DATA_NOT_EXISTS);
+					m_guard = std::move(other.m_guard);
+				}
+				return *this;
+			}
+
+			CEpochDataWrapper(const CEpochDataWrapper&) = delete;
+			CEpochDataWrapper& operator=(const CEpochDataWrapper&) = delete;
+
+			explicit operator bool() const noexcept {
+				return m_result == EWrapperResult::SUCCESS && m_data;
+			}
+
+			EWrapperResult GetResult() const noexcept {
+				return m_result;
+			}
+
+			bool operator==(EWrapperResult result) const noexcept {
+				return m_result == result;
+			}
+
+			bool operator!=(EWrapperResult result) const noexcept {
+				return m_result != result;
+			}
+
+			TElement* operator->() noexcept {
+				return m_data;
+			}
+
+			TElement* get() noexcept {
+				return m_data;
+			}
+		};
+
+		template<typename TKey, typename TElement, size_t SHARD_COUNT = 64, typename THash = std::hash<TKey>>
+		class CEpochSafeDataStore {
+			static_assert(THasInlineLock<TElement>::value, "CEpochSafeDataStore requires an inline-locked data type.");
+			static_assert(SHARD_COUNT > 0 && (SHARD_COUNT & (SHARD_COUNT - 1)) == 0, "SHARD_COUNT must be a power of two.");
+		public:
+			using TWrapper = CEpochDataWrapper<TElement>;
+			using TBusyFunc = std::function<void(TElement*)>;
+		private:
+			struct alignas(CACHE_LINE_SIZE) TShard {
+				mutable std::shared_mutex m_mutex{};
+				std::unordered_map<TKey, TElement*, THash> m_records{};
+			};
+
+			std::array<TShard, SHARD_COUNT> m_shards{};
+			THash m_hasher{};
+		private:
+			TShard& GetShard(const TKey& _key) noexcept {
+				uint64_t hash = static_cast<uint64_t>(m_hasher(_key));
+				hash ^= hash >> 33;
+				hash *= 0xff51afd7ed558ccdULL;
+				hash ^= hash >> 33;
+				return m_shards[static_cast<size_t>(hash & (SHARD_COUNT - 1))];
+			}
+
+			//Epoch icinde cagrilmalidir.
+			TElement* FindRaw(const TKey& _key) {
+				TShard& shard = GetShard(_key);
+				std::shared_lock<std::shared_mutex> mute(shard.m_mutex);
+				auto found = shard.m_records.find(_key);
+				if (found == shard.m_records.end()) return nullptr;
+				return found->second;
+			}
+		public:
+			CEpochSafeDataStore() = default;
+
+			//Depo yok edilirken baska thread'lerin erismedigi varsayilir.
+			~CEpochSafeDataStore() {
+				for (auto& shard : m_shards) {
+					for (auto& [key, data] : shard.m_records) {
+						delete data;
+					}
+				}
+			}
+
+			CEpochSafeDataStore(const CEpochSafeDataStore&) = delete;
+			CEpochSafeDataStore& operator=(const CEpochSafeDataStore&) = delete;
+
+			TWrapper Access(const TKey& _key, ELockType _requestType = ELockType::Read, TBusyFunc _ifBusy = nullptr) {
+				CEpochGuard guard{};
+				TElement* data = FindRaw(_key);
+				if (!data) return TWrapper();
+
+				TWrapper wrapper(std::move(guard), data, _requestType);
+				if (wrapper != EWrapperResult::BUSY || !_ifBusy) return wrapper;
+
+				//wrapper'in guard'i hala aktif: operasyon eklenirken veri silinemez.
+				CInlineLockAcquirer::AddOperation(data->m_inlineLock, data->m_mutexID, [op = std::move(_ifBusy), data]() { op(data); });
+				return wrapper;
+			}
+
+			bool Insert(const TKey& _key, std::unique_ptr<TElement> _data) {
+				if (!_data) return false;
+				TShard& shard = GetShard(_key);
+				std::unique_lock<std::shared_mutex> mute(shard.m_mutex);
+				auto [iter, success] = shard.m_records.try_emplace(_key, _data.get());
+				if (success) _data.release();
+				return success;
+			}
+
+			template<typename... TArgs>
+			bool Emplace(const TKey& _key, TArgs&&... _args) {
+				return Insert(_key, std::make_unique<TElement>(std::forward<TArgs>(_args)...));
+			}
+
+			//Veri depodan cikarilir ve emekliye ayrilir; elinde wrapper olanlar kullanmaya devam edebilir.
+			bool Erase(const TKey& _key) {
+				TElement* erased = nullptr;
+				{
+					TShard& shard = GetShard(_key);
+					std::unique_lock<std::shared_mutex> mute(shard.m_mutex);
+					auto found = shard.m_records.find(_key);
+					if (found == shard.m_records.end()) return false;
+					erased = found->second;
+					shard.m_records.erase(found);
+				}
+				epochInstance.Retire(erased);
+				return true;
+			}
+
+			size_t Size() const {
+				size_t total = 0;
+				for (const auto& shard : m_shards) {
+					std::shared_lock<std::shared_mutex> mute(shard.m_mutex);
+					total += shard.m_records.size();
+				}
+				return total;
+			}
+
+			//Tum verileri kilit almadan gezer: _func(const TKey&, TElement*). Gezinti boyunca epoch icinde kalinir.
+			template<typename TFunc>
+			void ForEach(TFunc&& _func) {
+				CEpochGuard guard{};
+				std::vector<std::pair<TKey, TElement*>> records{};
+				for (auto& shard : m_shards) {
+					records.clear();
+					{
+						std::shared_lock<std::shared_mutex> mute(shard.m_mutex);
+						records.reserve(shard.m_records.size());
+						for (const auto& [key, data] : shard.m_records) {
+							records.emplace_back(key, data);
+						}
+					}
+					for (const auto& [key, data] : records) {
+						_func(key, data);
+					}
+				}
+			}
+		};
+	};
+};
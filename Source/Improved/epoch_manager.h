@@ -0,0 +1,228 @@
+#pragma once
+#include "constants.h"
+
+#include <singleton.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/*
+Epoch tabanli bellek geri kazanimi (epoch based reclamation).
+Okuyucular veriye erismeden once CEpochGuard ile epoch'a girer; bu sirada ham pointer'lar guvenle kullanilabilir.
+Kayitlardan cikarilan veriler silinmez, Retire ile emekliye ayrilir ve onu gorebilecek hicbir okuyucu kalmadiginda silinir.
+Boylece sicak verilere her eriste shared_ptr referans sayaci arttirilip azaltilmaz.
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		static constexpr size_t EPOCH_RECLAIM_THRESHOLD = 64; // thread basina bu kadar emekli veri birikince temizlik denenir
+
+		class CEpochManager : public CSingleton<CEpochManager> {
+		public:
+			using TDeleter = void(*)(void*);
+		private:
+			static constexpr uint64_t INACTIVE_EPOCH = std::numeric_limits<uint64_t>::max();
+
+			struct TRetired {
+				void* m_ptr;
+				TDeleter m_deleter;
+				uint64_t m_epoch; // emekliye ayrildigi andaki global epoch
+			};
+
+			//Her thread'e ait kayit. Kayitlar hic silinmez, thread bittiginde baska thread'lere verilir.
+			struct alignas(CACHE_LINE_SIZE) TThreadRecord {
+				std::atomic<uint64_t> m_localEpoch{ INACTIVE_EPOCH };
+				std::atomic<bool> m_inUse{ false };
+				TThreadRecord* m_next = nullptr;
+				uint32_t m_nesting = 0; // sadece sahibi kullanir
+				std::vector<TRetired> m_retired{}; // sadece sahibi kullanir
+			};
+
+			//Thread bittiginde kaydi geri verir. Kayit yok edilmis bir ornege aitse (destroyAll) dokunulmaz, yeni ornek de olusturulmaz.
+			struct TThreadHandle {
+				TThreadRecord* m_record = nullptr;
+				uint64_t m_generation = 0;
+				~TThreadHandle() {
+					if (!m_record || CEpochManager::instanceGeneration() != m_generation) return;
+					CEpochManager::getInstance().ReleaseRecord(m_record);
+				}
+			};
+
+			std::atomic<uint64_t> m_globalEpoch{ 1 };
+			std::atomic<TThreadRecord*> m_records{ nullptr };
+
+			std::mutex m_orphanMutex{};
+			std::vector<TRetired> m_orphans{}; // biten thread'lerden kalan emekli veriler
+		private:
+			TThreadRecord* AcquireRecord() {
+				//once bos bir kaydi tekrar kullanmayi dene
+				for (TThreadRecord* rec = m_records.load(std::memory_order_acquire); rec; rec = rec->m_next) {
+					bool expected = false;
+					if (rec->m_inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) return rec;
+				}
+
+				TThreadRecord* rec = new TThreadRecord();
+				rec->m_inUse.store(true, std::memory_order_relaxed);
+				TThreadRecord* head = m_records.load(std::memory_order_relaxed);
+				do {
+					rec->m_next = head;
+				} while (!m_records.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+				return rec;
+			}
+
+			void ReleaseRecord(TThreadRecord* _record) noexcept {
+				_record->m_nesting = 0;
+				_record->m_localEpoch.store(INACTIVE_EPOCH, std::memory_order_release);
+				Reclaim(_record->m_retired);
+
+				if (!_record->m_retired.empty()) {
+					std::lock_guard<std::mutex> mute(m_orphanMutex);
+					try {
+						m_orphans.insert(m_orphans.end(), _record->m_retired.begin(), _record->m_retired.end());
+					}
+					catch (...) {
+						//sizinti, ama kullanimdaki bir veriyi silmekten iyidir.
+					}
+					_record->m_retired.clear();
+				}
+				_record->m_inUse.store(false, std::memory_order_release);
+			}
+
+			TThreadRecord& GetThreadRecord() {
+				thread_local TThreadHandle s_handle{};
+				const uint64_t generation = instanceGeneration();
+				if (s_handle.m_generation != generation) {
+					s_handle.m_record = AcquireRecord();
+					s_handle.m_generation = generation;
+				}
+				return *s_handle.m_record;
+			}
+
+			//Aktif okuyucularin en kucuk epoch'u. Bundan kucuk epoch'ta emekliye ayrilan veriler silinebilir.
+			uint64_t GetMinActiveEpoch() const noexcept {
+				uint64_t minEpoch = m_globalEpoch.load(std::memory_order_seq_cst);
+				for (TThreadRecord* rec = m_records.load(std::memory_order_acquire); rec; rec = rec->m_next) {
+					uint64_t local = rec->m_localEpoch.load(std::memory_order_seq_cst);
+					if (local < minEpoch) minEpoch = local;
+				}
+				return minEpoch;
+			}
+
+			//Tum aktif okuyucular guncel epoch'u gormusse epoch'u ilerletir.
+			void TryAdvance() noexcept {
+				uint64_t global = m_globalEpoch.load(std::memory_order_seq_cst);
+				if (GetMinActiveEpoch() < global) return;
+				m_globalEpoch.compare_exchange_strong(global, global + 1, std::memory_order_seq_cst);
+			}
+
+			void Reclaim(std::vector<TRetired>& _retired) noexcept {
+				if (_retired.empty()) return;
+				TryAdvance();
+				const uint64_t minActive = GetMinActiveEpoch();
+
+				size_t kept = 0;
+				for (size_t i = 0; i < _retired.size(); ++i) {
+					if (_retired[i].m_epoch < minActive) {
+						_retired[i].m_deleter(_retired[i].m_ptr);
+					}
+					else {
+						_retired[kept++] = _retired[i];
+					}
+				}
+				_retired.resize(kept);
+			}
+		public:
+			CEpochManager() = default;
+
+			//Sadece destroyAll/destroyInstance ile: epoch icinde thread kalmamistir, emekli veriler silinir.
+			~CEpochManager() {
+				for (TRetired& retired : m_orphans) retired.m_deleter(retired.m_ptr);
+				TThreadRecord* rec = m_records.load(std::memory_order_acquire);
+				while (rec) {
+					for (TRetired& retired : rec->m_retired) retired.m_deleter(retired.m_ptr);
+					TThreadRecord* next = rec->m_next;
+					delete rec;
+					rec = next;
+				}
+			}
+
+			void Enter() {
+				TThreadRecord& rec = GetThreadRecord();
+				if (rec.m_nesting++ > 0) return;
+				rec.m_localEpoch.store(m_globalEpoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+			}
+
+			void Exit() {
+				TThreadRecord& rec = GetThreadRecord();
+				if (rec.m_nesting == 0 || --rec.m_nesting > 0) return;
+				rec.m_localEpoch.store(INACTIVE_EPOCH, std::memory_order_release);
+			}
+
+			bool IsInCriticalSection() {
+				return GetThreadRecord().m_nesting > 0;
+			}
+
+			//_ptr kayitlardan cikarilmis olmalidir; artik yeni okuyucular onu goremez.
+			void Retire(void* _ptr, TDeleter _deleter) {
+				if (!_ptr) return;
+				TThreadRecord& rec = GetThreadRecord();
+				rec.m_retired.push_back({ _ptr, _deleter, m_globalEpoch.load(std::memory_order_seq_cst) });
+				if (rec.m_retired.size() >= EPOCH_RECLAIM_THRESHOLD) {
+					TryReclaim();
+				}
+			}
+
+			template<typename T>
+			void Retire(T* _ptr) {
+				Retire(static_cast<void*>(_ptr), [](void* p) { delete static_cast<T*>(p); });
+			}
+
+			//Thread'in ve biten thread'lerin emekli verilerini silmeyi dener.
+			void TryReclaim() {
+				Reclaim(GetThreadRecord().m_retired);
+
+				std::unique_lock<std::mutex> mute(m_orphanMutex, std::try_to_lock);
+				if (mute.owns_lock()) {
+					Reclaim(m_orphans);
+				}
+			}
+
+			uint64_t GetEpoch() const noexcept {
+				return m_globalEpoch.load(std::memory_order_acquire);
+			}
+		};
+#define epochInstance NThreadSafe::NLock::CEpochManager::getInstance()
+
+		//Kapsam boyunca thread'i epoch icinde tutar.
+		class CEpochGuard {
+		private:
+			bool m_active;
+		public:
+			CEpochGuard() : m_active(true) {
+				epochInstance.Enter();
+			}
+			//bEnter false ise bos (pasif) bir guard olusturur.
+			explicit CEpochGuard(bool bEnter) : m_active(bEnter) {
+				if (m_active) epochInstance.Enter();
+			}
+			~CEpochGuard() {
+				if (m_active) epochInstance.Exit();
+			}
+
+			CEpochGuard(CEpochGuard&& other) noexcept : m_active(std::exchange(other.m_active, false)) {}
+			CEpochGuard& operator=(CEpochGuard&& other) noexcept {
+				if (this != &other) {
+					if (m_active) epochInstance.Exit();
+					m_active = std::exchange(other.m_active, false);
+				}
+				return *this;
+			}
+
+			CEpochGuard(const CEpochGuard&) = delete;
+			CEpochGuard& operator=(const CEpochGuard&) = delete;
+		};
+	};
+};
@@ -0,0 +1,200 @@
+#pragma once
+#include "constants.h"
+#include "inline_lock.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/*
+Adil (FIFO) inline kilit.
+Kilit mesgulken gelenler kuyruga girer; kuyrukta bekleyen varken yeni gelenler kilidi kapamaz (barging yok).
+Kilidi birakan thread sahipligi dogrudan kuyrugun basindaki yaziciya ya da ardisik tum okuyuculara devreder,
+boylece yazicilar okuyucu akisi altinda aclik cekmez ve bekleme suresi kuyruk uzunluguyla sinirli kalir.
+
+Kilitsiz hizli yol CInlineLock ile aynidir; sadece cekisme oldugunda kuyruk mutex'ine ugranir.
+Verim yerine kuyruk gecikmesinin (tail latency) onemli oldugu, yazma cekismesi yuksek veriler icin kullanilmalidir:
+struct TOrder : public IFairSafeData { ... };
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		class CFairLock : public CPendingOperationStack {
+		public:
+			static constexpr uint32_t WRITER_BIT = uint32_t(1) << 31;
+			static constexpr uint32_t QUEUED_BIT = uint32_t(1) << 30; // kuyrukta bekleyen var, hizli yol kapali
+			static constexpr uint32_t READER_MASK = ~(WRITER_BIT | QUEUED_BIT);
+		private:
+			//Bekleyen thread'in yiginda yasar.
+			struct TWaiter {
+				TWaiter* m_next = nullptr;
+				TWaiter* m_prev = nullptr;
+				ELockType m_type;
+				bool m_granted = false; // m_queueMutex altinda degisir
+				std::condition_variable m_cv{};
+				explicit TWaiter(ELockType _type) : m_type(_type) {}
+			};
+
+			std::atomic<uint32_t> m_state{ 0 }; // WRITER_BIT | QUEUED_BIT | okuyucu sayisi
+			std::atomic<TID> m_writer{ TID() };
+
+			std::mutex m_queueMutex{};
+			TWaiter* m_head = nullptr;
+			TWaiter* m_tail = nullptr;
+		private:
+			void PushWaiter(TWaiter* _waiter) noexcept {
+				_waiter->m_prev = m_tail;
+				if (m_tail) m_tail->m_next = _waiter;
+				else m_head = _waiter;
+				m_tail = _waiter;
+			}
+
+			void RemoveWaiter(TWaiter* _waiter) noexcept {
+				if (_waiter->m_prev) _waiter->m_prev->m_next = _waiter->m_next;
+				else m_head = _waiter->m_next;
+				if (_waiter->m_next) _waiter->m_next->m_prev = _waiter->m_prev;
+				else m_tail = _waiter->m_prev;
+				_waiter->m_next = _waiter->m_prev = nullptr;
+			}
+
+			//Kuyrugun basindakilere, kilit durumu izin verdigi surece sahipligi devreder. m_queueMutex altinda cagrilmalidir.
+			void GrantWaiters() noexcept {
+				while (m_head) {
+					TWaiter* waiter = m_head;
+					const bool bLast = waiter->m_next == nullptr;
+					uint32_t state = m_state.load(std::memory_order_relaxed);
+					for (;;) {
+						if (state & WRITER_BIT) return;
+						if (waiter->m_type == ELockType::Write && (state & READER_MASK) != 0) return;
+
+						uint32_t desired = waiter->m_type == ELockType::Write ? WRITER_BIT : (state & READER_MASK) + 1;
+						if (!bLast) desired |= QUEUED_BIT;
+						if (m_state.compare_exchange_weak(state, desired, std::memory_order_acq_rel, std::memory_order_relaxed)) break;
+					}
+
+					RemoveWaiter(waiter);
+					waiter->m_granted = true;
+					waiter->m_cv.notify_one();
+				}
+			}
+
+			void GrantWaitersSlow() noexcept {
+				std::lock_guard<std::mutex> mute(m_queueMutex);
+				GrantWaiters();
+			}
+		public:
+			CFairLock() = default;
+
+			bool TryLockShared() noexcept {
+				uint32_t state = m_state.load(std::memory_order_relaxed);
+				while (!(state & (WRITER_BIT | QUEUED_BIT))) {
+					if (m_state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+						return true;
+					}
+				}
+				return false;
+			}
+
+			bool TryLockExclusive() noexcept {
+				uint32_t expected = 0;
+				if (!m_state.compare_exchange_strong(expected, WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed)) {
+					return false;
+				}
+				m_writer.store(std::this_thread::get_id(), std::memory_order_relaxed);
+				return true;
+			}
+
+			//Sadece tek okuyucu cagiran thread ise okuma kilidini yazma kilidine cevirir. Zaten sahip oldugu icin kuyrugu beklemez.
+			bool TryUpgrade() noexcept {
+				uint32_t state = m_state.load(std::memory_order_relaxed);
+				for (;;) {
+					if ((state & ~QUEUED_BIT) != 1) return false;
+					if (m_state.compare_exchange_weak(state, (state & QUEUED_BIT) | WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed)) break;
+				}
+				m_writer.store(std::this_thread::get_id(), std::memory_order_relaxed);
+				return true;
+			}
+
+			//Kuyruga girip kilidi _deadline'a kadar bekler. Kilit devredildiyse true doner.
+			bool Lock(ELockType _requestType, std::chrono::steady_clock::time_point _deadline) noexcept {
+				TWaiter waiter(_requestType);
+				std::unique_lock<std::mutex> mute(m_queueMutex);
+				PushWaiter(&waiter);
+				m_state.fetch_or(QUEUED_BIT, std::memory_order_acq_rel);
+				GrantWaiters(); // kilit bu arada bosalmis olabilir
+
+				while (!waiter.m_granted) {
+					if (waiter.m_cv.wait_until(mute, _deadline) == std::cv_status::timeout && !waiter.m_granted) {
+						RemoveWaiter(&waiter);
+						if (!m_head) {
+							m_state.fetch_and(~QUEUED_BIT, std::memory_order_acq_rel);
+						}
+						GrantWaiters(); // basta bekleyen bir yazici ciktiysa arkasindaki okuyucular alabilir
+						return false;
+					}
+				}
+
+				if (_requestType == ELockType::Write) {
+					m_writer.store(std::this_thread::get_id(), std::memory_order_relaxed);
+				}
+				return true;
+			}
+
+			void UnlockShared() noexcept {
+				const uint32_t state = m_state.fetch_sub(1, std::memory_order_release) - 1;
+				if ((state & QUEUED_BIT) && (state & READER_MASK) == 0) {
+					GrantWaitersSlow();
+				}
+			}
+
+			void UnlockExclusive() noexcept {
+				m_writer.store(TID(), std::memory_order_relaxed);
+				uint32_t expected = WRITER_BIT;
+				if (m_state.compare_exchange_strong(expected, 0, std::memory_order_release, std::memory_order_relaxed)) return;
+
+				//kuyrukta bekleyen var: sahipligi dogrudan devret.
+				std::lock_guard<std::mutex> mute(m_queueMutex);
+				m_state.fetch_and(~WRITER_BIT, std::memory_order_release);
+				GrantWaiters();
+			}
+
+			//Yazma kilidini _readers adet okuma kilidine cevirir (yazma kilidi tutulurken cagrilmalidir).
+			void Downgrade(uint32_t _readers) noexcept {
+				m_writer.store(TID(), std::memory_order_relaxed);
+				uint32_t state = m_state.load(std::memory_order_relaxed);
+				while (!m_state.compare_exchange_weak(state, (state & QUEUED_BIT) | _readers, std::memory_order_release, std::memory_order_relaxed)) {}
+
+				//kuyrugun basinda okuyucular varsa onlar da girebilir.
+				if (state & QUEUED_BIT) {
+					GrantWaitersSlow();
+				}
+			}
+
+			//Devirde (HandOff) yazici kaydi temizlenir; kilit devralan bekleyene aittir.
+			void ClearWriter() noexcept {
+				m_writer.store(TID(), std::memory_order_relaxed);
+			}
+
+			bool IsWriteLocked() const noexcept {
+				return (m_state.load(std::memory_order_acquire) & WRITER_BIT) != 0;
+			}
+
+			uint32_t GetReaderCount() const noexcept {
+				return m_state.load(std::memory_order_acquire) & READER_MASK;
+			}
+
+			//Kimse tutmuyor ve kuyrukta bekleyen yok.
+			bool IsFree() const noexcept {
+				return m_state.load(std::memory_order_acquire) == 0;
+			}
+
+			TID GetWriter() const noexcept {
+				return m_writer.load(std::memory_order_relaxed);
+			}
+		};
+
+		using IFairSafeData = TInlineSafeData<CFairLock>;
+	};
+};
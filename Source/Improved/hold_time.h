@@ -0,0 +1,145 @@
+#pragma once
+#include "constants.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define THREAD_SAFE_HAS_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define THREAD_SAFE_HAS_TSC 1
+#endif
+
+/*
+Kilit tutma suresi olcumu (TMutexThreadData::GetHeldMs).
+Olcum sadece tanilama icindir; varsayilan modda sicak yolda hic saat okunmaz.
+
+Off     : olcum yok, GetHeldMs 0 doner.
+Sampled : her SetMode ile verilen oranda bir sahiplik icin steady_clock okunur.
+Tsc     : her sahiplik icin islemci zaman sayaci (rdtsc) okunur, x86 disinda steady_clock'a duser.
+Full    : her sahiplik icin steady_clock okunur.
+
+Varsayilan mod LOG_THREAD_SAFE acikken Full, degilse Off'tur. THREAD_SAFE_HOLD_TIME_MODE ile derlemede degistirilebilir,
+calisirken CHoldTimeTracker::SetMode ile uretimde de (ornegin Sampled) acilabilir.
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		enum class EHoldTimeMode : uint8_t {
+			Off,
+			Sampled,
+			Tsc,
+			Full,
+		};
+
+#ifndef THREAD_SAFE_HOLD_TIME_MODE
+#ifdef LOG_THREAD_SAFE
+#define THREAD_SAFE_HOLD_TIME_MODE NThreadSafe::NLock::EHoldTimeMode::Full
+#else
+#define THREAD_SAFE_HOLD_TIME_MODE NThreadSafe::NLock::EHoldTimeMode::Off
+#endif
+#endif
+
+		static constexpr uint32_t DEFAULT_HOLD_TIME_SAMPLE_RATE = 64; // 2'nin kuvveti olmalidir
+
+		//Sahiplik anindaki zaman damgasi. m_mode, damganin hangi saatle alindigini belirtir.
+		struct THoldStamp {
+			uint64_t m_value = 0;
+			EHoldTimeMode m_mode = EHoldTimeMode::Off; // Off: olculmedi
+		};
+
+		class CHoldTimeTracker {
+		private:
+			static inline std::atomic<EHoldTimeMode> s_mode{ THREAD_SAFE_HOLD_TIME_MODE };
+			static inline std::atomic<uint32_t> s_sampleMask{ DEFAULT_HOLD_TIME_SAMPLE_RATE - 1 };
+
+			//TSC -> ns donusumu icin ilk damgadaki (tsc, steady) cifti. Oran olcum aninda hesaplanir, kalibrasyon icin beklenmez.
+			static inline std::atomic<uint64_t> s_tscBase{ 0 };
+			static inline std::atomic<int64_t> s_steadyBaseNs{ 0 };
+		private:
+			static int64_t SteadyNs() noexcept {
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			}
+
+			static bool ShouldSample() noexcept {
+				thread_local uint32_t s_state = 0x9E3779B9u ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&s_state));
+				s_state ^= s_state << 13;
+				s_state ^= s_state >> 17;
+				s_state ^= s_state << 5;
+				return (s_state & s_sampleMask.load(std::memory_order_relaxed)) == 0;
+			}
+
+#ifdef THREAD_SAFE_HAS_TSC
+			static uint64_t ReadTsc() noexcept {
+				const uint64_t tsc = __rdtsc();
+				uint64_t expected = 0;
+				if (s_tscBase.load(std::memory_order_relaxed) == 0 && s_tscBase.compare_exchange_strong(expected, tsc, std::memory_order_relaxed)) {
+					s_steadyBaseNs.store(SteadyNs(), std::memory_order_release);
+				}
+				return tsc;
+			}
+
+			static uint64_t TscToMs(uint64_t _ticks) noexcept {
+				const uint64_t tscBase = s_tscBase.load(std::memory_order_relaxed);
+				const int64_t steadyBase = s_steadyBaseNs.load(std::memory_order_acquire);
+				const uint64_t tscSpan = __rdtsc() - tscBase;
+				const int64_t nsSpan = SteadyNs() - steadyBase;
+				if (tscSpan == 0 || nsSpan <= 0 || steadyBase == 0) return 0;
+				return static_cast<uint64_t>(static_cast<double>(_ticks) * static_cast<double>(nsSpan) / static_cast<double>(tscSpan) / 1000000.0);
+			}
+#endif
+		public:
+			//_sampleRate sadece Sampled modunda kullanilir ve 2'nin kuvvetine yuvarlanir.
+			static void SetMode(EHoldTimeMode _mode, uint32_t _sampleRate = DEFAULT_HOLD_TIME_SAMPLE_RATE) noexcept {
+				uint32_t rate = 1;
+				while (rate < _sampleRate && rate < (uint32_t(1) << 31)) rate <<= 1;
+				s_sampleMask.store(rate - 1, std::memory_order_relaxed);
+				s_mode.store(_mode, std::memory_order_relaxed);
+			}
+
+			static EHoldTimeMode GetMode() noexcept {
+				return s_mode.load(std::memory_order_relaxed);
+			}
+
+			//Yeni sahiplik icin damga. Off modunda (ve orneklenmeyen sahipliklerde) saat okunmaz.
+			static THoldStamp Stamp() noexcept {
+				const EHoldTimeMode mode = GetMode();
+				switch (mode) {
+				case EHoldTimeMode::Off:
+					return {};
+				case EHoldTimeMode::Sampled:
+					if (!ShouldSample()) return {};
+					return { static_cast<uint64_t>(SteadyNs()), EHoldTimeMode::Sampled };
+#ifdef THREAD_SAFE_HAS_TSC
+				case EHoldTimeMode::Tsc:
+					return { ReadTsc(), EHoldTimeMode::Tsc };
+#endif
+				default:
+					return { static_cast<uint64_t>(SteadyNs()), EHoldTimeMode::Full };
+				}
+			}
+
+			static bool IsTracked(const THoldStamp& _stamp) noexcept {
+				return _stamp.m_mode != EHoldTimeMode::Off;
+			}
+
+			//Damgadan bu yana gecen sure (ms). Olculmemisse 0.
+			static uint64_t ElapsedMs(const THoldStamp& _stamp) noexcept {
+				switch (_stamp.m_mode) {
+				case EHoldTimeMode::Off:
+					return 0;
+#ifdef THREAD_SAFE_HAS_TSC
+				case EHoldTimeMode::Tsc:
+					return TscToMs(__rdtsc() - _stamp.m_value);
+#endif
+				default: {
+					const int64_t elapsed = SteadyNs() - static_cast<int64_t>(_stamp.m_value);
+					return elapsed > 0 ? static_cast<uint64_t>(elapsed) / 1000000 : 0;
+				}
+				}
+			}
+		};
+	};
+};
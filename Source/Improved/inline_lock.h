@@ -0,0 +1,671 @@
+#pragma once
+#include "constants.h"
+#include "interfaces.h"
+#include "common_types.h"
+#include "lock_profiler.h"
+#include "lock_watchdog.h"
+#include "deadlock_detector.h"
+#include "diagnostics.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+Kilit kaydini verinin icinde tutan (inline) kilit modu.
+TInlineSafeData'dan turetilen veriler icin CDataWrapper kilidi dogrudan veri uzerinden alir;
+tracker'daki global kayit tablosuna hic ugranmaz.
+
+Kilit sirasi: thread'e ait tutulan inline kilitler thread_local bir listede saklanir.
+Bir thread, tuttugu en buyuk id'den daha kucuk id'li bir kilit icin beklemez (BUSY doner),
+boylece yeniden siralama (reorder) yapmadan deadlock engellenir.
+
+Bekleme: kilit once kisa sure (INLINE_SPIN_BEFORE_PARK tur) denenir, sonra thread CLockParkingLot'ta uyutulur.
+Kilidi birakan taraf sadece o kovada uyuyan varsa bildirim yapar; hizli yolda tek bir atomik okuma eklenir.
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		//Kilit musait oldugunda calistirilacak operasyon. Tek yonlu bagli liste dugumudur.
+		//m_handoff None degilse operasyon bir asenkron bekleyendir: kilit o tipte ona devredilir ve m_op kilit sahibi olarak cagrilir.
+		struct TPendingOperation {
+			TPendingOperation* m_next = nullptr;
+			std::function<void()> m_op;
+			ELockType m_handoff = ELockType::None;
+			explicit TPendingOperation(std::function<void()>&& _op, ELockType _handoff = ELockType::None) : m_op(std::move(_op)), m_handoff(_handoff) {}
+		};
+
+		//Inline kilitlerin ortak bekleyen operasyon yigini.
+		class CPendingOperationStack {
+		private:
+			std::atomic<TPendingOperation*> m_pendingHead{ nullptr }; // bekleyen operasyonlar (LIFO yigin)
+			std::atomic<TPendingOperation*> m_deferredHead{ nullptr }; // kilit devrinden sonra kalanlar (FIFO), sadece yazma kilidi altinda degisir
+			TPendingOperation* m_deferredTail = nullptr; // sadece yazma kilidi altinda kullanilir
+			TPendingOperation* m_takenTail = nullptr; // son alinan listenin sonu, sadece yazma kilidi altinda kullanilir
+		private:
+			static void DeleteAll(TPendingOperation* _op) noexcept {
+				while (_op) {
+					TPendingOperation* next = _op->m_next;
+					delete _op;
+					_op = next;
+				}
+			}
+		public:
+			CPendingOperationStack() = default;
+			CPendingOperationStack(const CPendingOperationStack&) = delete;
+			CPendingOperationStack& operator=(const CPendingOperationStack&) = delete;
+
+			~CPendingOperationStack() {
+				DeleteAll(m_deferredHead.exchange(nullptr, std::memory_order_acquire));
+				DeleteAll(m_pendingHead.exchange(nullptr, std::memory_order_acquire));
+			}
+
+			bool HasPendingOperations() const noexcept {
+				return m_deferredHead.load(std::memory_order_acquire) != nullptr
+					|| m_pendingHead.load(std::memory_order_acquire) != nullptr;
+			}
+
+			void PushPendingOperation(TPendingOperation* _op) noexcept {
+				TPendingOperation* head = m_pendingHead.load(std::memory_order_relaxed);
+				do {
+					_op->m_next = head;
+				} while (!m_pendingHead.compare_exchange_weak(head, _op, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			//Bekleyen tum operasyonlari eklenme sirasinda (FIFO) dondurur. Yazma kilidi altinda cagrilmalidir.
+			TPendingOperation* TakePendingOperations() noexcept {
+				TPendingOperation* head = m_pendingHead.exchange(nullptr, std::memory_order_acquire);
+				TPendingOperation* ordered = nullptr;
+				TPendingOperation* orderedTail = head;
+				while (head) {
+					TPendingOperation* next = head->m_next;
+					head->m_next = ordered;
+					ordered = head;
+					head = next;
+				}
+
+				//once devirden kalanlar, sonra yeni gelenler.
+				TPendingOperation* deferred = m_deferredHead.exchange(nullptr, std::memory_order_acquire);
+				if (!deferred) {
+					m_takenTail = orderedTail;
+					return ordered;
+				}
+				if (ordered) {
+					m_deferredTail->m_next = ordered;
+					m_takenTail = orderedTail;
+				}
+				else {
+					m_takenTail = m_deferredTail;
+				}
+				return deferred;
+			}
+
+			//Kilit devredildiginde islenmeyen operasyonlari siradaki yazma kilidi sahibine birakir. Yazma kilidi altinda cagrilmalidir.
+			//_rest, son TakePendingOperations ile alinan listenin bir sonudur (suffix).
+			void DeferPendingOperations(TPendingOperation* _rest) noexcept {
+				m_deferredTail = _rest ? m_takenTail : nullptr;
+				m_deferredHead.store(_rest, std::memory_order_release);
+			}
+		};
+
+		class CInlineLock : public CPendingOperationStack {
+		public:
+			static constexpr uint32_t WRITER_BIT = uint32_t(1) << 31;
+		private:
+			std::atomic<uint32_t> m_state{ 0 }; // WRITER_BIT | okuyucu sayisi
+			std::atomic<TID> m_writer{ TID() }; // sahiplik ozeti: yazma kilidinin sahibi
+		public:
+			CInlineLock() = default;
+
+			bool TryLockShared() noexcept {
+				uint32_t state = m_state.load(std::memory_order_relaxed);
+				while (!(state & WRITER_BIT)) {
+					if (m_state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+						return true;
+					}
+				}
+				return false;
+			}
+
+			bool TryLockExclusive() noexcept {
+				uint32_t expected = 0;
+				if (!m_state.compare_exchange_strong(expected, WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed)) {
+					return false;
+				}
+				m_writer.store(std::this_thread::get_id(), std::memory_order_relaxed);
+				return true;
+			}
+
+			//Sadece tek okuyucu cagiran thread ise okuma kilidini yazma kilidine cevirir.
+			bool TryUpgrade() noexcept {
+				uint32_t expected = 1;
+				if (!m_state.compare_exchange_strong(expected, WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed)) {
+					return false;
+				}
+				m_writer.store(std::this_thread::get_id(), std::memory_order_relaxed);
+				return true;
+			}
+
+			void UnlockShared() noexcept {
+				m_state.fetch_sub(1, std::memory_order_release);
+			}
+
+			void UnlockExclusive() noexcept {
+				m_writer.store(TID(), std::memory_order_relaxed);
+				m_state.store(0, std::memory_order_release);
+			}
+
+			//Yazma kilidini _readers adet okuma kilidine cevirir (yazma kilidi tutulurken cagrilmalidir).
+			void Downgrade(uint32_t _readers) noexcept {
+				m_writer.store(TID(), std::memory_order_relaxed);
+				m_state.store(_readers, std::memory_order_release);
+			}
+
+			//Yazma kilidi asenkron bekleyene devredildiginde cagrilir: yeni sahip bir thread'e bagli degildir.
+			void ClearWriter() noexcept {
+				m_writer.store(TID(), std::memory_order_relaxed);
+			}
+
+			bool IsWriteLocked() const noexcept {
+				return (m_state.load(std::memory_order_acquire) & WRITER_BIT) != 0;
+			}
+
+			uint32_t GetReaderCount() const noexcept {
+				return m_state.load(std::memory_order_acquire) & ~WRITER_BIT;
+			}
+
+			//Kimse tutmuyor (bkz. lock_elision.h).
+			bool IsFree() const noexcept {
+				return m_state.load(std::memory_order_acquire) == 0;
+			}
+
+			TID GetWriter() const noexcept {
+				return m_writer.load(std::memory_order_relaxed);
+			}
+		};
+
+		//Kilidi veri icinde tasiyan ISafeData. TLock, CInlineLock arayuzune sahip olmalidir
+		//(TryLockShared/TryLockExclusive/TryUpgrade/Unlock*/Downgrade, CPendingOperationStack).
+		template<typename TLock>
+		struct TInlineSafeData : public ISafeData {
+			using TInlineLockType = TLock;
+			TLock m_inlineLock{};
+
+			TInlineSafeData() = default;
+
+			// Move operations: kilit durumu nesneye aittir, tasinmaz.
+			TInlineSafeData& operator=(TInlineSafeData&& other) noexcept {
+				ISafeData::operator=(std::move(other));
+				return *this;
+			}
+			TInlineSafeData(TInlineSafeData&& other) noexcept : ISafeData(std::move(other)) {}
+
+			//copy : disabled
+			TInlineSafeData& operator=(const TInlineSafeData& other) = delete;
+			TInlineSafeData(const TInlineSafeData& other) = delete;
+
+			~TInlineSafeData() = default;
+		};
+
+		using IInlineSafeData = TInlineSafeData<CInlineLock>;
+
+		template<typename TElement, typename = void>
+		struct THasInlineLock : std::false_type {};
+
+		template<typename TElement>
+		struct THasInlineLock<TElement, std::void_t<typename TElement::TInlineLockType>> : std::true_type {};
+
+		//Kilit, kendi bekleme kuyrugu ile beklemeyi destekliyor mu? (Lock(ELockType, deadline) -> bool)
+		template<typename TLock, typename = void>
+		struct THasBlockingLock : std::false_type {};
+
+		template<typename TLock>
+		struct THasBlockingLock<TLock, std::void_t<decltype(std::declval<TLock&>().Lock(ELockType::Write, std::chrono::steady_clock::time_point{}))>> : std::true_type {};
+
+		//Inline kilitleri bekleyen thread'lerin uyutuldugu ortak yer. Kilitler adreslerine gore kovalara dagitilir;
+		//kilidin kendisinde bekleme alani yoktur, boylece veri basina boyut artmaz.
+		class CLockParkingLot {
+		private:
+			struct alignas(CACHE_LINE_SIZE) TBucket {
+				std::atomic<uint32_t> m_parked{ 0 }; // kovada uyuyan (veya uyumak uzere olan) thread sayisi
+				std::atomic<uint64_t> m_epoch{ 0 }; // her bildirimde artar, sadece m_mutex altinda yazilir
+				std::mutex m_mutex{};
+				std::condition_variable m_cv{};
+			};
+
+			static TBucket& GetBucket(const void* _lock) noexcept {
+				static std::array<TBucket, PARKING_BUCKET_COUNT> s_buckets{};
+				return s_buckets[(reinterpret_cast<uintptr_t>(_lock) / CACHE_LINE_SIZE) % PARKING_BUCKET_COUNT];
+			}
+		public:
+			//_try basarili olana ya da _deadline gecene kadar uyur. _try kova kilidi disinda cagrilir: bekleyen operasyonlari
+			//calistirabilir ve baska kilitleri bekleyebilir.
+			//Unpark ile birlikte: ya biz _try'da kilidin birakildigini goruruz ya da birakan m_parked'i gorup epoch'u arttirir.
+			template<typename TTry>
+			static bool ParkUntil(const void* _lock, TTry& _try, std::chrono::steady_clock::time_point _deadline) noexcept {
+				TBucket& bucket = GetBucket(_lock);
+				for (;;) {
+					bucket.m_parked.fetch_add(1, std::memory_order_seq_cst);
+					const uint64_t epoch = bucket.m_epoch.load(std::memory_order_seq_cst);
+					const bool bLocked = _try();
+					if (!bLocked) {
+						std::unique_lock<std::mutex> guard(bucket.m_mutex);
+						bucket.m_cv.wait_until(guard, _deadline, [&]() { return bucket.m_epoch.load(std::memory_order_relaxed) != epoch; });
+					}
+					bucket.m_parked.fetch_sub(1, std::memory_order_relaxed);
+					if (bLocked) return true;
+					if (std::chrono::steady_clock::now() >= _deadline) return _try();
+				}
+			}
+
+			//Kilit birakildiktan (ve seq_cst fence'ten) sonra cagrilir. Kovada kimse uyumuyorsa sadece bir okumadir.
+			static void Unpark(const void* _lock) noexcept {
+				TBucket& bucket = GetBucket(_lock);
+				if (bucket.m_parked.load(std::memory_order_seq_cst) == 0) return;
+				{
+					std::lock_guard<std::mutex> guard(bucket.m_mutex);
+					bucket.m_epoch.store(bucket.m_epoch.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				}
+				bucket.m_cv.notify_all();
+			}
+		};
+
+		//Inline kilitlerin thread bazli kayitlari. Tanilama politikasindan bagimsizdir: ayni kilit farkli politikali
+		//acquirer'larla alinsa da thread'in tek kaydi vardir (reentrancy ve kilit sirasi bozulmaz).
+		class CInlineLockRegistry {
+		protected:
+			struct THeldInlineLock {
+				const void* m_lock;
+				TLockID m_lockID;
+				ELockType m_type;
+				uint32_t m_count;
+				uint64_t m_holdStart; // profilleyici orneklediyse alinma zamani, degilse 0
+			};
+
+			static std::vector<THeldInlineLock>& GetHeldLocks() noexcept {
+				thread_local std::vector<THeldInlineLock> s_heldLocks{};
+				return s_heldLocks;
+			}
+
+			static THeldInlineLock* FindHeld(const void* _lock) noexcept {
+				for (auto& held : GetHeldLocks()) {
+					if (held.m_lock == _lock) return &held;
+				}
+				return nullptr;
+			}
+
+			//Thread, bu id'den buyuk bir kilit tutuyorsa beklemek deadlock'a yol acabilir.
+			static bool CanWaitFor(TLockID _lockID) noexcept {
+				for (const auto& held : GetHeldLocks()) {
+					if (held.m_lockID > _lockID) return false;
+				}
+				return true;
+			}
+
+			static bool PushHeld(const void* _lock, TLockID _lockID, ELockType _type, uint64_t _holdStart = 0) noexcept {
+				try {
+					GetHeldLocks().push_back({ _lock, _lockID, _type, 1, _holdStart });
+					heldRegistryInstance.Publish(_lockID, _type);
+					return true;
+				}
+				catch (...) {
+					return false;
+				}
+			}
+
+			static void PopHeld(const void* _lock) noexcept {
+				auto& vec = GetHeldLocks();
+				for (auto it = vec.begin(); it != vec.end(); ++it) {
+					if (it->m_lock != _lock) continue;
+					heldRegistryInstance.Unpublish(it->m_lockID);
+					//swap&pop
+					if (it != vec.end() - 1) {
+						*it = std::move(vec.back());
+					}
+					vec.pop_back();
+					return;
+				}
+			}
+
+			//Bu thread'de bekleyen operasyonlari calistirilmakta olan kilitler. Devredilen kilit ayni thread'de hemen birakilirsa
+			//ic ice RunPendingOperations yerine disaridaki dongu devam eder; uzun bekleyen zincirlerinde yigin buyumez.
+			struct TDrainState {
+				std::array<const void*, MAX_NESTED_DRAIN> m_locks{};
+				size_t m_count = 0;
+			};
+
+			static TDrainState& GetDrainState() noexcept {
+				thread_local TDrainState s_state{};
+				return s_state;
+			}
+
+			class CDrainScope {
+			private:
+				TDrainState& m_state;
+				bool m_bTracked;
+			public:
+				explicit CDrainScope(const void* _lock) noexcept : m_state(GetDrainState()), m_bTracked(m_state.m_count < MAX_NESTED_DRAIN) {
+					if (m_bTracked) m_state.m_locks[m_state.m_count++] = _lock;
+				}
+				~CDrainScope() {
+					if (m_bTracked) --m_state.m_count;
+				}
+				CDrainScope(const CDrainScope&) = delete;
+				CDrainScope& operator=(const CDrainScope&) = delete;
+			};
+
+			static bool IsDraining(const void* _lock) noexcept {
+				const TDrainState& state = GetDrainState();
+				for (size_t i = 0; i < state.m_count; ++i) {
+					if (state.m_locks[i] == _lock) return true;
+				}
+				return false;
+			}
+
+			//Kilit LOCK_ACQUIRE_TIMEOUT suresince beklenir: once INLINE_SPIN_BEFORE_PARK tur denenir, sonra thread kilit
+			//birakilana kadar uyutulur. Sadece yavas yolda saat okunur.
+			template<typename TLock, typename TTry>
+			static bool SpinUntil(const TLock& _lock, TTry&& _try) noexcept {
+				const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(LOCK_ACQUIRE_TIMEOUT);
+				for (uint32_t spin = 0; spin < INLINE_SPIN_BEFORE_PARK; ++spin) {
+					if (_try()) return true;
+					std::this_thread::yield();
+				}
+				return CLockParkingLot::ParkUntil(&_lock, _try, deadline);
+			}
+
+			template<typename TLock>
+			static void Unlock(TLock& _lock, ELockType _type) noexcept {
+				if (_type == ELockType::Write) {
+					_lock.UnlockExclusive();
+				}
+				else {
+					_lock.UnlockShared();
+				}
+			}
+
+			static void RunOperation(TPendingOperation* _op, TLockID _lockID) noexcept {
+				try {
+					_op->m_op();
+				}
+				catch (...) {
+#ifdef LOG_THREAD_SAFE
+					LOG_ERR(LogClass::NORMAL, "Pending operation threw an exception for lockID(?).", _lockID);
+#else
+					(void)_lockID;
+#endif
+				}
+			}
+
+		public:
+			//Thread bu kilidi herhangi bir tipte tutuyor mu?
+			template<typename TLock>
+			static bool IsHeldByThisThread(const TLock& _lock) noexcept {
+				return FindHeld(&_lock) != nullptr;
+			}
+		};
+
+		//Inline kilit alma/birakma mantigi. TDiagPolicy: tanilama seviyesi (bkz. diagnostics.h); tracker kendi politikasini verir.
+		//Detached kilitler thread kaydina eklenmez: asenkron alinan kilitler bu sekilde tutulur ve herhangi bir thread'de birakilabilir.
+		template<typename TDiagPolicy = TDefaultDiag>
+		class TInlineLockAcquirer : public CInlineLockRegistry {
+			using TDiag = CDiagnostics<TDiagPolicy>;
+		public:
+			template<typename TLock>
+			static EWrapperResult Acquire(TLock& _lock, TLockID _lockID, ELockType _requestType, bool bWait = true) noexcept {
+				if (_requestType == ELockType::None) return EWrapperResult::DATA_NOT_EXISTS;
+
+				if (THeldInlineLock* held = FindHeld(&_lock)) {
+					//reentrant: yazma kilidi her seyi kapsar, okuma kilidi okumayi kapsar.
+					if (held->m_type == ELockType::Write || _requestType == ELockType::Read) {
+						held->m_count++;
+						return EWrapperResult::SUCCESS;
+					}
+
+					//okuma -> yazma donusumu: sadece tek okuyucu bizsek mumkun.
+					bool bUpgraded = _lock.TryUpgrade();
+					if (!bUpgraded && bWait && CanWaitFor(_lockID)) {
+						const uint64_t waitStart = profilerInstance.IsEnabled() ? CLockProfiler::Now() : 0;
+						CWaitScope waitScope(_lockID);
+						if (waitScope.ShouldFail()) {
+							profilerInstance.RecordBusy(_lockID);
+							return EWrapperResult::DEADLOCK;
+						}
+						TDiag::Event(ELockEvent::WaitBegin, _lockID, ELockType::Write);
+						bUpgraded = SpinUntil(_lock, [&]() { return _lock.TryUpgrade(); });
+						if (bUpgraded) {
+							profilerInstance.RecordWait(_lockID, waitStart);
+							TDiag::Event(ELockEvent::Wait, _lockID, ELockType::Write);
+						}
+					}
+					if (!bUpgraded) {
+						profilerInstance.RecordBusy(_lockID);
+						TDiag::Event(ELockEvent::Busy, _lockID, _requestType);
+						return EWrapperResult::BUSY;
+					}
+
+					profilerInstance.RecordConversion(_lockID);
+					TDiag::Event(ELockEvent::Convert, _lockID, ELockType::Write);
+					held->m_type = ELockType::Write;
+					held->m_count++;
+					return EWrapperResult::SUCCESS;
+				}
+
+				//Sirada asenkron bekleyen ya da operasyon varsa onlarin onune gecilmez: kilit bossa once onlar calistirilir (devredilir).
+				auto tryLock = [&]() -> bool {
+					if (_lock.HasPendingOperations()) {
+						RunPendingOperations(_lock, _lockID);
+						if (_lock.HasPendingOperations()) return false;
+					}
+					return _requestType == ELockType::Write ? _lock.TryLockExclusive() : _lock.TryLockShared();
+				};
+
+				bool bLocked = tryLock();
+				if (!bLocked && bWait && CanWaitFor(_lockID)) {
+					const uint64_t waitStart = profilerInstance.IsEnabled() ? CLockProfiler::Now() : 0;
+					CWaitScope waitScope(_lockID);
+					if (waitScope.ShouldFail()) {
+						profilerInstance.RecordBusy(_lockID);
+						return EWrapperResult::DEADLOCK;
+					}
+					TDiag::Event(ELockEvent::WaitBegin, _lockID, _requestType);
+					if constexpr (THasBlockingLock<TLock>::value) {
+						//kilidin kendi kuyrugunda sirayla bekle.
+						bLocked = _lock.Lock(_requestType, std::chrono::steady_clock::now() + std::chrono::milliseconds(LOCK_ACQUIRE_TIMEOUT));
+					}
+					else {
+						bLocked = SpinUntil(_lock, tryLock);
+					}
+					if (bLocked) {
+						profilerInstance.RecordWait(_lockID, waitStart);
+						TDiag::Event(ELockEvent::Wait, _lockID, _requestType);
+					}
+				}
+				if (!bLocked) {
+					profilerInstance.RecordBusy(_lockID);
+					TDiag::Event(ELockEvent::Busy, _lockID, _requestType);
+					return EWrapperResult::BUSY;
+				}
+
+				if (!PushHeld(&_lock, _lockID, _requestType, profilerInstance.SampleHoldStart())) {
+					Unlock(_lock, _requestType);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					CLockParkingLot::Unpark(&_lock);
+					return EWrapperResult::BUSY;
+				}
+				profilerInstance.RecordAcquire(_lockID);
+				TDiag::Event(ELockEvent::Acquire, _lockID, _requestType);
+				return EWrapperResult::SUCCESS;
+			}
+
+			template<typename TLock>
+			static void Release(TLock& _lock) noexcept {
+				THeldInlineLock* held = FindHeld(&_lock);
+				if (!held) return;
+				if (--held->m_count > 0) return;
+
+				const ELockType type = held->m_type;
+				const TLockID lockID = held->m_lockID;
+				const uint64_t holdStart = held->m_holdStart;
+				PopHeld(&_lock);
+				Unlock(_lock, type);
+				profilerInstance.RecordHold(lockID, holdStart);
+				TDiag::Event(ELockEvent::Release, lockID, type);
+
+				//AddOperation ile ayni anda calisirsa en az birimiz bekleyen operasyonu gormeli; uyuyan bekleyen icin de ayni.
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				CLockParkingLot::Unpark(&_lock);
+				if (_lock.HasPendingOperations()) {
+					RunPendingOperations(_lock, lockID);
+				}
+			}
+
+			//Bekleyen operasyonlari yazma kilidi altinda calistirir. Kilit alinamazsa son birakan thread calistirir.
+			//Sirada asenkron bekleyen varsa kilit birakilmadan ona devredilir.
+			template<typename TLock>
+			static void RunPendingOperations(TLock& _lock, TLockID _lockID) noexcept {
+				//Disarida ayni kilit icin donen dongu, devir bittikten sonra tekrar bakar.
+				if (IsDraining(&_lock)) return;
+				CDrainScope drainScope(&_lock);
+
+				while (_lock.HasPendingOperations()) {
+					if (!_lock.TryLockExclusive()) return;
+
+					//operasyon icinden ayni veriye tekrar erisilebilsin diye kayda ekle.
+					const bool bRegistered = PushHeld(&_lock, _lockID, ELockType::Write);
+					TPendingOperation* op = _lock.TakePendingOperations();
+					uint32_t ranCount = 0;
+					while (op && op->m_handoff == ELockType::None) {
+						TPendingOperation* next = op->m_next;
+						RunOperation(op, _lockID);
+						delete op;
+						op = next;
+						++ranCount;
+					}
+					if (bRegistered) PopHeld(&_lock);
+					if (ranCount > 0) TDiag::Event(ELockEvent::OperationsRun, _lockID, ELockType::Write, ranCount);
+
+					if (op) {
+						//Yeni sahip kilidi bu thread'de birakmis olabilir; oyleyse kalanlar bu dongude calisir.
+						HandOff(_lock, _lockID, op);
+						continue;
+					}
+					_lock.UnlockExclusive();
+					//Release ile ayni: bu arada eklenen operasyonu ya biz goruruz ya da ekleyen kilidi alip kendisi calistirir.
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					CLockParkingLot::Unpark(&_lock);
+				}
+			}
+		private:
+			//Yazma kilidi tutulurken cagrilir. Bir yazici ya da ardisik tum okuyucular kilidi devralir;
+			//geri kalanlar siradaki kilit sahibine birakilir.
+			template<typename TLock>
+			static void HandOff(TLock& _lock, TLockID _lockID, TPendingOperation* _first) noexcept {
+				TPendingOperation* last = _first;
+				uint32_t granted = 1;
+				if (_first->m_handoff == ELockType::Read) {
+					while (last->m_next && last->m_next->m_handoff == ELockType::Read) {
+						last = last->m_next;
+						++granted;
+					}
+				}
+				_lock.DeferPendingOperations(last->m_next);
+				last->m_next = nullptr;
+
+				if (_first->m_handoff == ELockType::Read) {
+					_lock.Downgrade(granted);
+					//bekleyen okuyucular da girebilir.
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					CLockParkingLot::Unpark(&_lock);
+				}
+				else {
+					_lock.ClearWriter();
+				}
+				TDiag::Event(ELockEvent::Grant, _lockID, _first->m_handoff, granted);
+
+				//m_op artik kilidin sahibidir, birakmak ona aittir.
+				TPendingOperation* op = _first;
+				while (op) {
+					TPendingOperation* next = op->m_next;
+					profilerInstance.RecordAcquire(_lockID);
+					RunOperation(op, _lockID);
+					delete op;
+					op = next;
+				}
+			}
+		public:
+			template<typename TLock>
+			static EAddOperationResult AddOperation(TLock& _lock, TLockID _lockID, std::function<void()>&& _op) noexcept {
+				TPendingOperation* op = nullptr;
+				try {
+					op = new TPendingOperation(std::move(_op));
+				}
+				catch (...) {
+					return EAddOperationResult::FAILED;
+				}
+
+				_lock.PushPendingOperation(op);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				//Eklerken kilit serbest kalmis olabilir, o durumda kimse calistirmaz: biz calistiralim.
+				if (!IsHeldByThisThread(_lock)) {
+					RunPendingOperations(_lock, _lockID);
+				}
+				return EAddOperationResult::ADDED;
+			}
+
+			//Thread kaydina eklemeden kilidi beklemeden almayi dener. Sirada bekleyen varsa onlarin onune gecmez.
+			template<typename TLock>
+			static bool TryAcquireDetached(TLock& _lock, TLockID _lockID, ELockType _requestType) noexcept {
+				if (_requestType == ELockType::None || _lock.HasPendingOperations()) return false;
+				const bool bLocked = _requestType == ELockType::Write ? _lock.TryLockExclusive() : _lock.TryLockShared();
+				if (bLocked) profilerInstance.RecordAcquire(_lockID);
+				return bLocked;
+			}
+
+			template<typename TLock>
+			static void ReleaseDetached(TLock& _lock, TLockID _lockID, ELockType _type) noexcept {
+				Unlock(_lock, _type);
+
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				CLockParkingLot::Unpark(&_lock);
+				if (_lock.HasPendingOperations()) {
+					RunPendingOperations(_lock, _lockID);
+				}
+			}
+
+			//Kilidi sirayla (FIFO) bekler. Kilit _requestType tipinde devredildiginde _onGranted, kilidin sahibi olarak
+			//kilidi birakan thread'de cagrilir ve kilidi ReleaseDetached ile birakmakla yukumludur.
+			template<typename TLock>
+			static EAddOperationResult AddWaiter(TLock& _lock, TLockID _lockID, ELockType _requestType, std::function<void()>&& _onGranted) noexcept {
+				if (_requestType == ELockType::None) return EAddOperationResult::FAILED;
+
+				TPendingOperation* op = nullptr;
+				try {
+					op = new TPendingOperation(std::move(_onGranted), _requestType);
+				}
+				catch (...) {
+					return EAddOperationResult::FAILED;
+				}
+
+				profilerInstance.RecordWait(_lockID, 0);
+				_lock.PushPendingOperation(op);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				if (!IsHeldByThisThread(_lock)) {
+					RunPendingOperations(_lock, _lockID);
+				}
+				return EAddOperationResult::ADDED;
+			}
+		};
+
+		using CInlineLockAcquirer = TInlineLockAcquirer<TDefaultDiag>;
+	};
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include "constants.h"
+#include "lock_id_allocator.h"
 
+#include <functional>
 #include <memory>
 #include <shared_mutex>
 #include <utility>
@@ -11,18 +13,21 @@ namespace NThreadSafe {
 
 		struct ISafeData {
 			std::shared_mutex m_mutex{};
-			const uintptr_t m_mutexID;
-			ISafeData() : m_mutexID(reinterpret_cast<uintptr_t>(&m_mutex))  {}
+			const TLockID m_mutexID; //CLockIDAllocator'dan alinan yogun id, kilit sirasi bu id'ye gore belirlenir.
+			ISafeData() : m_mutexID(lockIDInstance.Allocate())  {}
 
 			// Move operations
-			ISafeData& operator=(ISafeData&& other) noexcept = default;
-			ISafeData(ISafeData&& other) noexcept = default;
+			//mutex tasinamaz, id de nesneye aittir: tasinan nesne kendi id'sini korur, yeni nesne yeni id alir.
+			ISafeData& operator=(ISafeData&& /*other*/) noexcept { return *this; }
+			ISafeData(ISafeData&& /*other*/) noexcept : m_mutexID(lockIDInstance.Allocate()) {}
 
 			//copy : disabled
 			ISafeData& operator=(const ISafeData& other) = delete;
 			ISafeData(const ISafeData& other) = delete;
 
-			~ISafeData() = default;
+			~ISafeData() {
+				lockIDInstance.Release(m_mutexID);
+			}
 
 		};
 
@@ -30,7 +35,7 @@ namespace NThreadSafe {
 		public:
 			virtual ~ILock() = default;  // Virtual destructor for interface
 			virtual ELockType GetType() const noexcept = 0;
-			virtual uintptr_t GetMutexID() const noexcept = 0;
+			virtual TLockID GetMutexID() const noexcept = 0;
 
 			//Kilit alinabilir mi?
 			virtual EAcquireResult CanAcquire(/*[[maybe_unused]]*/ ELockType _requesttype) noexcept = 0;
@@ -55,9 +60,16 @@ namespace NThreadSafe {
 			//Kilit alinabilir olana kadar bekler.
 			virtual EAcquireResult Wait(ELockType _requestType) noexcept = 0;
 
-			//Sahiplik ekler
+			//Sahiplik ekler. Kayitlardan silinmis kilide sahip eklenmez.
 			virtual void AddOwnership() noexcept = 0;
 
+			//Sahibi yoksa kilidi silinmis isaretler ve _unpublish'i (kaydi tablodan cikarir) sahiplik kilidi altinda cagirir.
+			//Boylece silme ile yeni sahip eklenmesi ayni anda olamaz. Guard'i kaldirmak cagirana kalir (RemoveGuard).
+			virtual bool RemoveIfUnowned(const std::function<void()>& _unpublish) noexcept = 0;
+
+			//Kilit kayitlardan silindi mi? Silinmis kayittan eski bir kopya ile alinan kilit birakilip yeniden denenmelidir.
+			virtual bool IsRemoved() const noexcept = 0;
+
 		protected:
 			//Aktif bir guard'i var mi?
 			virtual bool HasGuard() const noexcept = 0;
@@ -70,24 +82,24 @@ namespace NThreadSafe {
 			virtual void PrintAll() = 0;
 		public:
 			// ikinci deger false ise hic denemeye gerek yok.
-			virtual std::pair<std::shared_ptr<ILock>, bool> TryAcquireLock(std::shared_mutex& _mutex, uintptr_t _mutexID, ELockType _requestType) noexcept = 0;
+			virtual std::pair<std::shared_ptr<ILock>, bool> TryAcquireLock(std::shared_mutex& _mutex, TLockID _mutexID, ELockType _requestType) noexcept = 0;
 		
 			//sahipligi kontrol ederek gerektiginde kilidi kayitlardan siler.
-			virtual void ReleaseLock(uintptr_t _mutexID, bool bOperationCall = false) noexcept = 0;
+			virtual void ReleaseLock(TLockID _mutexID, bool bOperationCall = false) noexcept = 0;
 		private:
 			//Thread'e ait kilitlerin yeniden siralanmaya ihtiyaci var mi?
-			virtual bool NeedToReset(uintptr_t _mutexID) noexcept = 0;
+			virtual bool NeedToReset(TLockID _mutexID) noexcept = 0;
 
 			//Thread'e ait tum kilitleri yeniden siralar.
 			virtual void ReorderAll() noexcept = 0;
 
-			virtual void RemoveFromMutexes(uintptr_t _mutexID) noexcept = 0;
+			virtual void RemoveFromMutexes(TLockID _mutexID) noexcept = 0;
 
 			//mutex kaydini thread bazli siler.
-			virtual void RemoveFromHeldLocks(uintptr_t _mutexID) noexcept = 0;
+			virtual void RemoveFromHeldLocks(TLockID _mutexID) noexcept = 0;
 
 			//ilk kez olusturulan mutex'leri kaydeder.
-			virtual bool RegisterMutex(std::shared_mutex& _mutex, uintptr_t _mutexID, ELockType _requestType) noexcept = 0;
+			virtual bool RegisterMutex(std::shared_mutex& _mutex, TLockID _mutexID, ELockType _requestType) noexcept = 0;
 		};
 	}
 }
@@ -0,0 +1,221 @@
+#pragma once
+#include "constants.h"
+#include "inline_lock.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define THREAD_SAFE_HAS_RTM 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define THREAD_SAFE_RTM_TARGET
+#else
+#include <cpuid.h>
+#define THREAD_SAFE_RTM_TARGET __attribute__((target("rtm")))
+#endif
+#endif
+
+/*
+Kisa yazma islemleri icin kilit elizyonu (lock elision). Sadece inline kilitli verilerde calisir.
+
+tracker->WriteElided(person, [](TPerson& p) { p.m_age++; });
+store.WriteElided(key, [](TPerson& p) { p.m_age++; });
+
+Sirayla denenir:
+1. RTM (Intel TSX): CPU destekliyorsa (calisma zamaninda cpuid ile bakilir) callable donanim transaction'inda calisir.
+   Kilit kelimesi sadece okunur, hic yazilmaz: kilit bossa yazma yapilir, bu sirada kilidi alan olursa transaction iptal edilir.
+2. CAS: kilit tek CAS ile, thread kaydina ve tracker'a ugramadan alinir (TryAcquireDetached), callable calisir, kilit birakilir.
+3. CDataWrapper ile normal yazma yolu (bekleme, reentrant erisim, deadlock tespiti).
+
+Callable kisa olmali ve sadece veriye yazmalidir: RTM'de birden fazla kez calistirilip geri alinabilir,
+sistem cagrisi, bellek ayirma ve IO transaction'i iptal eder. Exception transaction'i iptal eder, callable kilit altinda tekrar calisir.
+Seq lock verilerinde (TSeqLockSafeData) versiyon transaction icinde artirilir, kilitsiz okuyucular tutarli kalir.
+
+RTM bir thread'de ust uste ELISION_FAILURE_LIMIT kez basarisiz olursa o thread sonraki ELISION_BACKOFF_CALLS cagrida RTM denemez
+(TSX'in mikrokod ile kapatildigi veya verinin surekli cekismede oldugu durumlar). CLockElision::SetRTMEnabled(false) ile tamamen kapatilir.
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		static constexpr uint32_t ELISION_RTM_RETRY = 3; // cakisma ile iptal edilen transaction'in tekrar sayisi
+		static constexpr uint32_t ELISION_CAS_RETRY = 4;
+		static constexpr uint32_t ELISION_FAILURE_LIMIT = 16;
+		static constexpr uint32_t ELISION_BACKOFF_CALLS = 256;
+
+		static constexpr unsigned ELISION_ABORT_LOCKED = 0x01; // transaction icinde kilit dolu goruldu
+		static constexpr unsigned ELISION_ABORT_EXCEPTION = 0x02;
+
+		enum class EElisionPath : uint8_t {
+			None, // hicbir hizli yol basarili olmadi, normal yol kullanilmali
+			RTM,
+			CAS,
+		};
+
+		//Thread bazli sayaclar; paylasilmadigi icin sicak yolda cekisme yaratmaz.
+		struct TElisionStats {
+			uint64_t m_rtmCommits = 0;
+			uint64_t m_rtmAborts = 0;
+			uint64_t m_casCount = 0;
+			uint64_t m_fallbackCount = 0;
+		};
+
+		//Seq lock gibi kilitler kilit alinmadan yapilan yazmadan haberdar edilmelidir.
+		template<typename TLock, typename = void>
+		struct THasElidedWriteHook : std::false_type {};
+
+		template<typename TLock>
+		struct THasElidedWriteHook<TLock, std::void_t<decltype(std::declval<TLock&>().MarkElidedWrite())>> : std::true_type {};
+
+		class CLockElision {
+		private:
+			static inline std::atomic<bool> s_bRTMEnabled{ true };
+
+			struct TThreadState {
+				TElisionStats m_stats{};
+				uint32_t m_failures = 0; // ust uste basarisiz RTM denemesi
+				uint32_t m_backoff = 0; // RTM denenmeyecek kalan cagri sayisi
+			};
+
+			static TThreadState& GetThreadState() noexcept {
+				thread_local TThreadState s_state{};
+				return s_state;
+			}
+
+			static bool DetectRTM() noexcept {
+#if defined(THREAD_SAFE_HAS_RTM)
+#if defined(_MSC_VER) && !defined(__clang__)
+				int regs[4] = {};
+				__cpuid(regs, 0);
+				if (regs[0] < 7) return false;
+				__cpuidex(regs, 7, 0);
+				return (regs[1] & (1 << 11)) != 0;
+#else
+				unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+				if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+				return (ebx & (1u << 11)) != 0;
+#endif
+#else
+				return false;
+#endif
+			}
+
+			template<typename TLock>
+			static bool IsLockFree(const TLock& _lock) noexcept {
+				return _lock.IsFree() && !_lock.HasPendingOperations();
+			}
+
+			static bool ShouldTryRTM(TThreadState& _state) noexcept {
+				if (!HasRTM() || !s_bRTMEnabled.load(std::memory_order_relaxed)) return false;
+				if (_state.m_backoff == 0) return true;
+				_state.m_backoff--;
+				return false;
+			}
+
+			static void OnRTMResult(TThreadState& _state, bool bCommitted) noexcept {
+				if (bCommitted) {
+					_state.m_stats.m_rtmCommits++;
+					_state.m_failures = 0;
+					return;
+				}
+				_state.m_stats.m_rtmAborts++;
+				if (++_state.m_failures >= ELISION_FAILURE_LIMIT) {
+					_state.m_failures = 0;
+					_state.m_backoff = ELISION_BACKOFF_CALLS;
+				}
+			}
+
+#if defined(THREAD_SAFE_HAS_RTM)
+			//Kilit sadece okunur, boylece kilidi alan her thread transaction'i iptal eder.
+			template<typename TLock, typename TElement, typename TFunc>
+			THREAD_SAFE_RTM_TARGET static bool TryTransaction(TLock& _lock, TElement& _data, TFunc& _func) noexcept {
+				for (uint32_t attempt = 0; attempt < ELISION_RTM_RETRY; ++attempt) {
+					const unsigned status = _xbegin();
+					if (status == _XBEGIN_STARTED) {
+						if (!IsLockFree(_lock)) _xabort(ELISION_ABORT_LOCKED);
+						try {
+							_func(_data);
+						}
+						catch (...) {
+							_xabort(ELISION_ABORT_EXCEPTION);
+						}
+						if constexpr (THasElidedWriteHook<TLock>::value) {
+							_lock.MarkElidedWrite();
+						}
+						_xend();
+						return true;
+					}
+					//Kapasite, sistem cagrisi veya exception: tekrar denemek ise yaramaz.
+					if (!(status & _XABORT_RETRY) || (status & _XABORT_EXPLICIT)) return false;
+				}
+				return false;
+			}
+#endif
+		public:
+			//CPU RTM destekliyor mu (cpuid, bir kez bakilir). Destekleyip mikrokod ile kapatilmis CPU'larda transaction'lar iptal olur,
+			//geri cekilme (backoff) bu durumda RTM denemelerini seyreltir.
+			static bool HasRTM() noexcept {
+				static const bool s_bRTM = DetectRTM();
+				return s_bRTM;
+			}
+
+			static void SetRTMEnabled(bool bEnabled) noexcept {
+				s_bRTMEnabled.store(bEnabled, std::memory_order_relaxed);
+			}
+
+			static bool IsRTMEnabled() noexcept {
+				return HasRTM() && s_bRTMEnabled.load(std::memory_order_relaxed);
+			}
+
+			//Cagiran thread'in sayaclari.
+			static TElisionStats GetThreadStats() noexcept {
+				return GetThreadState().m_stats;
+			}
+
+			static void ResetThreadStats() noexcept {
+				GetThreadState().m_stats = {};
+			}
+
+			//_func(_data)'yi kilit almadan (RTM) veya tek CAS ile alinan yazma kilidi altinda calistirir.
+			//None donerse _func hic calismamistir (veya etkisi geri alinmistir), cagiran normal yazma yolunu kullanmalidir.
+			//TDiagPolicy: cagiran tracker'in tanilama politikasi, CAS yolunda kilit birakilirken kullanilir.
+			template<typename TDiagPolicy = TDefaultDiag, typename TElement, typename TFunc>
+			static EElisionPath TryRun(TElement& _data, TFunc& _func) {
+				static_assert(THasInlineLock<TElement>::value, "Lock elision requires an inline-locked data type.");
+				auto& lock = _data.m_inlineLock;
+				TThreadState& state = GetThreadState();
+
+#if defined(THREAD_SAFE_HAS_RTM)
+				//Kilit doluysa (baska thread'de veya bizde) transaction baslatmaya gerek yok.
+				if (IsLockFree(lock) && ShouldTryRTM(state)) {
+					const bool bCommitted = TryTransaction(lock, _data, _func);
+					OnRTMResult(state, bCommitted);
+					if (bCommitted) return EElisionPath::RTM;
+				}
+#endif
+
+				for (uint32_t attempt = 0; attempt < ELISION_CAS_RETRY; ++attempt) {
+					if (TInlineLockAcquirer<TDiagPolicy>::TryAcquireDetached(lock, _data.m_mutexID, ELockType::Write)) {
+						struct TReleaseGuard {
+							decltype(lock)& m_lock;
+							TLockID m_lockID;
+							~TReleaseGuard() { TInlineLockAcquirer<TDiagPolicy>::ReleaseDetached(m_lock, m_lockID, ELockType::Write); }
+						} guard{ lock, _data.m_mutexID };
+						state.m_stats.m_casCount++;
+						_func(_data);
+						return EElisionPath::CAS;
+					}
+					//Bu thread tutuyorsa beklemek anlamsiz, normal yol reentrant erisimi halleder.
+					if (CInlineLockAcquirer::IsHeldByThisThread(lock)) break;
+					std::this_thread::yield();
+				}
+
+				state.m_stats.m_fallbackCount++;
+				return EElisionPath::None;
+			}
+		};
+	};
+};
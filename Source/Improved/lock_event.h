@@ -0,0 +1,58 @@
+#pragma once
+#include "constants.h"
+#include "common_types.h"
+
+#include <cstddef>
+#include <cstdint>
+
+//Tanilama (diagnostics.h) ve iz kaydi (lock_trace.h) tarafindan paylasilan kilit olaylari.
+namespace NThreadSafe {
+	namespace NLock {
+		enum class ELockEvent : uint8_t {
+			Acquire, // kilit alindi
+			Busy, // kilit alinamadi
+			WaitBegin, // kilit beklenmeye baslandi (yavas yol)
+			Wait, // kilit beklendi ve alindi
+			Release, // sahiplik birakildi, m_arg: kalan sahip sayisi
+			Convert, // read -> write
+			Reorder, // thread kilitleri yeniden siralandi
+			Grant, // kilit asenkron bekleyene devredildi, m_arg: devredilen bekleyen sayisi
+			OperationAdded, // bekleyen operasyon eklendi
+			OperationsRun, // bekleyen operasyonlar calistirildi, m_arg: operasyon sayisi
+			QueuePush, // CNormalQueue'ye is eklendi, m_arg: kuyruk boyu
+			QueueTaskBegin, // CNormalQueue worker'i isi almaya basladi
+			QueueTaskEnd, // CNormalQueue isi bitti, m_arg: 1 basarili
+			Count,
+		};
+
+		static constexpr size_t LOCK_EVENT_COUNT = static_cast<size_t>(ELockEvent::Count);
+
+		inline const char* ToString(ELockEvent _event) noexcept {
+			switch (_event) {
+			case ELockEvent::Acquire: return "Acquire";
+			case ELockEvent::Busy: return "Busy";
+			case ELockEvent::WaitBegin: return "WaitBegin";
+			case ELockEvent::Wait: return "Wait";
+			case ELockEvent::Release: return "Release";
+			case ELockEvent::Convert: return "Convert";
+			case ELockEvent::Reorder: return "Reorder";
+			case ELockEvent::Grant: return "Grant";
+			case ELockEvent::OperationAdded: return "OperationAdded";
+			case ELockEvent::OperationsRun: return "OperationsRun";
+			case ELockEvent::QueuePush: return "QueuePush";
+			case ELockEvent::QueueTaskBegin: return "QueueTaskBegin";
+			case ELockEvent::QueueTaskEnd: return "QueueTaskEnd";
+			default: return "Unknown";
+			}
+		}
+
+		struct TLockEvent {
+			uint64_t m_timeNs = 0; // steady_clock
+			TID m_thread{};
+			TLockID m_lockID = INVALID_LOCK_ID;
+			ELockEvent m_event = ELockEvent::Acquire;
+			ELockType m_type = ELockType::None;
+			uint32_t m_arg = 0;
+		};
+	};
+};
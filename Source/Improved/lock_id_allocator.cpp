@@ -0,0 +1,10 @@
+#include "lock_id_allocator.h"
+#include "lock_profiler.h"
+
+namespace NThreadSafe {
+	namespace NLock {
+	void CLockIDAllocator::OnRecycle(TLockID _id) noexcept {
+		profilerInstance.ResetRecord(_id);
+	}
+	};
+}
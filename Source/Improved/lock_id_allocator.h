@@ -0,0 +1,67 @@
+#pragma once
+#include "constants.h"
+
+#include <singleton.h>
+
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+/*
+ISafeData'lara ait kilit id'lerini dagitir.
+Id'ler 1'den baslayarak yogun (dense) sekilde verilir, 0 gecersiz id'dir.
+Silinen verilerin id'leri free list uzerinden tekrar kullanilir, boylece
+tracker tarafinda id'ler dogrudan dizi indeksi olarak kullanilabilir.
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		class CLockIDAllocator : public CSingleton<CLockIDAllocator> {
+		private:
+			std::mutex m_mutex{};
+			std::vector<TLockID> m_freeIDs{}; //geri verilen id'ler
+			TLockID m_nextID = 1; //henuz hic verilmemis ilk id
+		private:
+			//Tekrar verilen id'ye ait, id ile indekslenen istatistikleri (profilleyici) eski veriden temizler.
+			//Profilleyici bu basligi dolayli olarak icerdigi icin tanim lock_id_allocator.cpp'dedir.
+			static void OnRecycle(TLockID _id) noexcept;
+		public:
+			//Verilen id'ler ISafeData'larda yasar: ayirici yeniden olusturulursa ayni id'ler tekrar verilirdi. destroyAll'a katilmaz.
+			static constexpr bool SINGLETON_KEEP_ALIVE = true;
+
+			TLockID Allocate() noexcept {
+				TLockID recycled = INVALID_LOCK_ID;
+				{
+					std::lock_guard<std::mutex> mute(m_mutex);
+					if (m_freeIDs.empty()) {
+						if (m_nextID == MAX_LOCK_ID) return INVALID_LOCK_ID; //id alani tukendi
+						return m_nextID++;
+					}
+
+					//en son birakilan id once verilir (sicak slotlar tekrar kullanilsin).
+					recycled = m_freeIDs.back();
+					m_freeIDs.pop_back();
+				}
+				OnRecycle(recycled);
+				return recycled;
+			}
+
+			void Release(TLockID _id) noexcept {
+				if (_id == INVALID_LOCK_ID) return;
+				std::lock_guard<std::mutex> mute(m_mutex);
+				try {
+					m_freeIDs.push_back(_id);
+				}
+				catch (...) {
+					//free list buyutulemedi, id sizdirilir ama tekrar verilmez.
+				}
+			}
+
+			//Simdiye kadar verilmis en buyuk id + 1. Tablolar bu degere gore boyutlandirilabilir.
+			TLockID GetHighWatermark() noexcept {
+				std::lock_guard<std::mutex> mute(m_mutex);
+				return m_nextID;
+			}
+		};
+#define lockIDInstance NThreadSafe::NLock::CLockIDAllocator::getInstance()
+	};
+};
@@ -0,0 +1,287 @@
+#pragma once
+#include "constants.h"
+#include "lock_record_table.h"
+
+#include <singleton.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+Kilit cekisme profilleyicisi.
+Her kilit id'si icin alma, BUSY, bekleme, donusum (read->write) ve yeniden siralama sayilari ile bekleme/tutma sureleri toplanir.
+Sayaclar id ile dogrudan indekslenen tabloda, verinin kendi cache line'inda tutulur; global bir kilit yoktur.
+
+Kapaliyken sicak yolun maliyeti tek bir relaxed okumadir. Acikken:
+- sayaclar her olayda arttirilir,
+- bekleme suresi her beklemede olculur (zaten yavas yol),
+- tutma suresi PROFILER_HOLD_SAMPLE_RATE almada bir olculur.
+
+profilerInstance.Enable(true);
+...
+auto hot = profilerInstance.GetTopRecords(10); // en cok cekisilen kayitlar
+std::string json = profilerInstance.DumpJson();
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		static constexpr uint32_t PROFILER_HOLD_SAMPLE_RATE = 64; // 2'nin kuvveti olmalidir
+
+		struct alignas(CACHE_LINE_SIZE) TLockProfileCounters {
+			std::atomic<uint64_t> m_acquisitions{ 0 };
+			std::atomic<uint64_t> m_busy{ 0 };
+			std::atomic<uint64_t> m_waits{ 0 };
+			std::atomic<uint64_t> m_waitNs{ 0 };
+			std::atomic<uint64_t> m_maxWaitNs{ 0 };
+			std::atomic<uint64_t> m_holdSamples{ 0 };
+			std::atomic<uint64_t> m_holdNs{ 0 }; // sadece orneklenen tutmalar
+			std::atomic<uint64_t> m_maxHoldNs{ 0 };
+			std::atomic<uint64_t> m_conversions{ 0 };
+			std::atomic<uint64_t> m_reorders{ 0 };
+
+			//ForEach sadece kullanilmis slotlari gezsin.
+			explicit operator bool() const noexcept {
+				return m_acquisitions.load(std::memory_order_relaxed) != 0 || m_busy.load(std::memory_order_relaxed) != 0;
+			}
+		};
+
+		//Raporlar icin sayaclarin anlik kopyasi.
+		struct TLockProfileEntry {
+			TLockID m_lockID = INVALID_LOCK_ID;
+			uint64_t m_acquisitions = 0;
+			uint64_t m_busy = 0;
+			uint64_t m_waits = 0;
+			uint64_t m_waitNs = 0;
+			uint64_t m_maxWaitNs = 0;
+			uint64_t m_holdSamples = 0;
+			uint64_t m_holdNs = 0;
+			uint64_t m_maxHoldNs = 0;
+			uint64_t m_conversions = 0;
+			uint64_t m_reorders = 0;
+
+			//Ornekleme oranina gore tahmini toplam tutma suresi.
+			uint64_t GetEstimatedHoldNs() const noexcept {
+				if (m_holdSamples == 0) return 0;
+				return m_holdNs / m_holdSamples * m_acquisitions;
+			}
+
+			//Siralama olcutu: kilit kac kez hemen alinamadi.
+			uint64_t GetContentionScore() const noexcept {
+				return m_waits + m_busy;
+			}
+		};
+
+		class CLockProfiler : public CSingleton<CLockProfiler> {
+		private:
+			std::atomic<bool> m_enabled{ false };
+			CLockRecordTable<TLockProfileCounters> m_counters{};
+		private:
+			static void UpdateMax(std::atomic<uint64_t>& _max, uint64_t _value) noexcept {
+				uint64_t current = _max.load(std::memory_order_relaxed);
+				while (current < _value && !_max.compare_exchange_weak(current, _value, std::memory_order_relaxed)) {}
+			}
+
+			TLockProfileCounters* GetCounters(TLockID _lockID) noexcept {
+				if (_lockID == INVALID_LOCK_ID) return nullptr;
+				return m_counters.GetSlot(_lockID);
+			}
+
+			static void ResetCounters(TLockProfileCounters& _counters) noexcept {
+				_counters.m_acquisitions.store(0, std::memory_order_relaxed);
+				_counters.m_busy.store(0, std::memory_order_relaxed);
+				_counters.m_waits.store(0, std::memory_order_relaxed);
+				_counters.m_waitNs.store(0, std::memory_order_relaxed);
+				_counters.m_maxWaitNs.store(0, std::memory_order_relaxed);
+				_counters.m_holdSamples.store(0, std::memory_order_relaxed);
+				_counters.m_holdNs.store(0, std::memory_order_relaxed);
+				_counters.m_maxHoldNs.store(0, std::memory_order_relaxed);
+				_counters.m_conversions.store(0, std::memory_order_relaxed);
+				_counters.m_reorders.store(0, std::memory_order_relaxed);
+			}
+
+			static TLockProfileEntry MakeEntry(TLockID _lockID, const TLockProfileCounters& _counters) noexcept {
+				TLockProfileEntry entry{};
+				entry.m_lockID = _lockID;
+				entry.m_acquisitions = _counters.m_acquisitions.load(std::memory_order_relaxed);
+				entry.m_busy = _counters.m_busy.load(std::memory_order_relaxed);
+				entry.m_waits = _counters.m_waits.load(std::memory_order_relaxed);
+				entry.m_waitNs = _counters.m_waitNs.load(std::memory_order_relaxed);
+				entry.m_maxWaitNs = _counters.m_maxWaitNs.load(std::memory_order_relaxed);
+				entry.m_holdSamples = _counters.m_holdSamples.load(std::memory_order_relaxed);
+				entry.m_holdNs = _counters.m_holdNs.load(std::memory_order_relaxed);
+				entry.m_maxHoldNs = _counters.m_maxHoldNs.load(std::memory_order_relaxed);
+				entry.m_conversions = _counters.m_conversions.load(std::memory_order_relaxed);
+				entry.m_reorders = _counters.m_reorders.load(std::memory_order_relaxed);
+				return entry;
+			}
+		public:
+			CLockProfiler() = default;
+
+			void Enable(bool _enable) noexcept {
+				m_enabled.store(_enable, std::memory_order_relaxed);
+			}
+
+			bool IsEnabled() const noexcept {
+				return m_enabled.load(std::memory_order_relaxed);
+			}
+
+			static uint64_t Now() noexcept {
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count());
+			}
+
+			//Bu alma icin tutma suresi olculmeli mi? Olculecekse baslangic zamanini, degilse 0 dondurur.
+			//Sayac yerine xorshift kullanilir; duzenli erisim desenlerinde hep ayni kayit orneklenmesin.
+			uint64_t SampleHoldStart() noexcept {
+				if (!IsEnabled()) return 0;
+				thread_local uint32_t s_state = 0x9E3779B9u ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&s_state));
+				s_state ^= s_state << 13;
+				s_state ^= s_state >> 17;
+				s_state ^= s_state << 5;
+				if ((s_state & (PROFILER_HOLD_SAMPLE_RATE - 1)) != 0) return 0;
+				return Now();
+			}
+
+			void RecordAcquire(TLockID _lockID) noexcept {
+				if (!IsEnabled()) return;
+				if (auto* counters = GetCounters(_lockID)) {
+					counters->m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+
+			void RecordBusy(TLockID _lockID) noexcept {
+				if (!IsEnabled()) return;
+				if (auto* counters = GetCounters(_lockID)) {
+					counters->m_busy.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+
+			//_waitStart 0 ise sadece bekleme sayisi arttirilir.
+			void RecordWait(TLockID _lockID, uint64_t _waitStart) noexcept {
+				if (!IsEnabled()) return;
+				auto* counters = GetCounters(_lockID);
+				if (!counters) return;
+				counters->m_waits.fetch_add(1, std::memory_order_relaxed);
+				if (_waitStart == 0) return;
+
+				const uint64_t waited = Now() - _waitStart;
+				counters->m_waitNs.fetch_add(waited, std::memory_order_relaxed);
+				UpdateMax(counters->m_maxWaitNs, waited);
+			}
+
+			void RecordHold(TLockID _lockID, uint64_t _holdStart) noexcept {
+				if (_holdStart == 0 || !IsEnabled()) return;
+				auto* counters = GetCounters(_lockID);
+				if (!counters) return;
+
+				const uint64_t held = Now() - _holdStart;
+				counters->m_holdSamples.fetch_add(1, std::memory_order_relaxed);
+				counters->m_holdNs.fetch_add(held, std::memory_order_relaxed);
+				UpdateMax(counters->m_maxHoldNs, held);
+			}
+
+			void RecordConversion(TLockID _lockID) noexcept {
+				if (!IsEnabled()) return;
+				if (auto* counters = GetCounters(_lockID)) {
+					counters->m_conversions.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+
+			void RecordReorder(TLockID _lockID) noexcept {
+				if (!IsEnabled()) return;
+				if (auto* counters = GetCounters(_lockID)) {
+					counters->m_reorders.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+
+			//Sayaclar profilleyici acikken de sifirlanabilir; o anki olaylar kismen kaybolabilir.
+			void Reset() noexcept {
+				m_counters.ForEach([](TLockID, TLockProfileCounters& counters) { ResetCounters(counters); });
+			}
+
+			//Id yeni bir veriye verildiginde cagrilir (bkz. CLockIDAllocator): yeni kayit eskisinin istatistiklerini devralmaz.
+			void ResetRecord(TLockID _lockID) noexcept {
+				if (_lockID == INVALID_LOCK_ID) return;
+				if (TLockProfileCounters* counters = m_counters.PeekSlot(_lockID)) {
+					ResetCounters(*counters);
+				}
+			}
+
+			TLockProfileEntry GetRecord(TLockID _lockID) const noexcept {
+				const TLockProfileCounters* counters = m_counters.PeekSlot(_lockID);
+				if (_lockID == INVALID_LOCK_ID || !counters) return TLockProfileEntry{};
+				return MakeEntry(_lockID, *counters);
+			}
+
+			std::vector<TLockProfileEntry> GetAllRecords() const {
+				std::vector<TLockProfileEntry> records{};
+				m_counters.ForEach([&](TLockID lockID, const TLockProfileCounters& counters) {
+					records.push_back(MakeEntry(lockID, counters));
+				});
+				return records;
+			}
+
+			//En cok cekisilen _count kayit (bekleme ve BUSY sayisina, esitlikte bekleme suresine gore).
+			std::vector<TLockProfileEntry> GetTopRecords(size_t _count) const {
+				std::vector<TLockProfileEntry> records = GetAllRecords();
+				auto byContention = [](const TLockProfileEntry& a, const TLockProfileEntry& b) {
+					if (a.GetContentionScore() != b.GetContentionScore()) return a.GetContentionScore() > b.GetContentionScore();
+					return a.m_waitNs > b.m_waitNs;
+				};
+				if (records.size() > _count) {
+					std::partial_sort(records.begin(), records.begin() + _count, records.end(), byContention);
+					records.resize(_count);
+				}
+				else {
+					std::sort(records.begin(), records.end(), byContention);
+				}
+				return records;
+			}
+
+			//Makine tarafindan okunabilir dokum: {"holdSampleRate":64,"records":[{"id":1,...},...]}
+			std::string DumpJson(size_t _count = SIZE_MAX) const {
+				std::ostringstream ss{};
+				ss << "{\"holdSampleRate\":" << PROFILER_HOLD_SAMPLE_RATE << ",\"records\":[";
+				bool bFirst = true;
+				for (const auto& entry : GetTopRecords(_count)) {
+					if (!bFirst) ss << ',';
+					bFirst = false;
+					ss << "{\"id\":" << entry.m_lockID
+						<< ",\"acquisitions\":" << entry.m_acquisitions
+						<< ",\"busy\":" << entry.m_busy
+						<< ",\"waits\":" << entry.m_waits
+						<< ",\"waitNs\":" << entry.m_waitNs
+						<< ",\"maxWaitNs\":" << entry.m_maxWaitNs
+						<< ",\"holdSamples\":" << entry.m_holdSamples
+						<< ",\"holdNs\":" << entry.m_holdNs
+						<< ",\"estimatedHoldNs\":" << entry.GetEstimatedHoldNs()
+						<< ",\"maxHoldNs\":" << entry.m_maxHoldNs
+						<< ",\"conversions\":" << entry.m_conversions
+						<< ",\"reorders\":" << entry.m_reorders
+						<< '}';
+				}
+				ss << "]}";
+				return ss.str();
+			}
+
+			void PrintTop(size_t _count) const {
+#ifdef LOG_THREAD_SAFE
+				LOG_INFO(LogClass::NORMAL, "=========================== TOP ? CONTENDED LOCKS ===========================", _count);
+				for (const auto& entry : GetTopRecords(_count)) {
+					LOG_INFO(LogClass::NORMAL, "lockID(?) acquisitions(?) busy(?) waits(?) waitNs(?) maxWaitNs(?) estHoldNs(?) conversions(?) reorders(?)",
+						entry.m_lockID, entry.m_acquisitions, entry.m_busy, entry.m_waits, entry.m_waitNs, entry.m_maxWaitNs,
+						entry.GetEstimatedHoldNs(), entry.m_conversions, entry.m_reorders);
+				}
+				LOG_INFO(LogClass::NORMAL, "=========================== END OF PRINT ===========================");
+#else
+				(void)_count;
+#endif
+			}
+		};
+#define profilerInstance NThreadSafe::NLock::CLockProfiler::getInstance()
+	};
+};
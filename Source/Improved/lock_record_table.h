@@ -0,0 +1,293 @@
+#pragma once
+#include "constants.h"
+#include "interfaces.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+/*
+Kilit kayitlarini yogun (dense) id'ye gore dogrudan indeksleyen tablo.
+Kayitlar segmentlerde tutulur, segment k'nin boyutu SEGMENT_BASE_SIZE << k'dir.
+Segmentler ihtiyac oldukca olusturulur ve bir kez yayinlandiktan sonra hic silinmez;
+bu yuzden segment okumalari kilitsizdir.
+
+Slot iceriklerinin senkronizasyonu cagiranin sorumlulugundadir.
+
+CPublishedRecordTable tracker kayitlari icindir: slotlar, degeri tutan ve yayinlandiktan sonra degismeyen bir kutuya (box)
+atomik isaretcidir. Load kilit almadan acquire okuma ile kutuyu bulur ve degeri kopyalar. Okuyucular kopyalama suresince
+thread'lerine dusen sayaci arttirir; Erase kutuyu slottan cikarir, o anki okuyucularin bitmesini bekler ve kutuyu hemen
+siler. Boylece kaydin tablodaki referansi eskisi gibi Erase aninda birakilir (kilit kayitlarinin guard'i yok edildiginde
+mutex acilir, silme gecikmemelidir). Ekleme/silme, Find ve ForEach cagiranin kilidi altinda yapilmalidir
+(CNewThreadTracker'da m_mutexData); sadece Load kilitsizdir.
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		static constexpr size_t SEGMENT_BASE_SHIFT = 10;
+		static constexpr size_t SEGMENT_BASE_SIZE = size_t(1) << SEGMENT_BASE_SHIFT; // ilk segment 1024 slot
+		static constexpr size_t MAX_SEGMENT_COUNT = 32 - SEGMENT_BASE_SHIFT + 1; // tum TLockID araligini kapsar
+		static constexpr size_t RECORD_READER_SLOT_COUNT = 16; // CPublishedRecordTable okuyucu sayac sayisi
+
+		//Veri tipi yogun id'ye sahipse (ISafeData) tracker kayitlari tabloda tutar.
+		//Istenmiyorsa tip icin false olacak sekilde ozellestirilebilir.
+		template<typename TElement>
+		struct TUseLockRecordTable : std::is_base_of<ISafeData, TElement> {};
+
+		template<typename TValue>
+		class CLockRecordTable {
+		private:
+			struct TSegment {
+				TValue* m_slots;
+				explicit TSegment(size_t _size) : m_slots(new (std::nothrow) TValue[_size]()) {}
+				~TSegment() { delete[] m_slots; }
+			};
+
+			std::array<std::atomic<TSegment*>, MAX_SEGMENT_COUNT> m_segments{};
+			std::mutex m_growMutex{}; //sadece segment olusturulurken kullanilir
+		private:
+			//id'nin bulundugu segment ve segment icindeki indeks
+			static std::pair<size_t, size_t> Locate(TLockID _id) noexcept {
+				const uint64_t bucket = (static_cast<uint64_t>(_id) >> SEGMENT_BASE_SHIFT) + 1;
+				size_t segment = 0;
+				while ((bucket >> (segment + 1)) != 0) ++segment;
+
+				const uint64_t segmentStart = ((uint64_t(1) << segment) - 1) << SEGMENT_BASE_SHIFT;
+				return { segment, static_cast<size_t>(_id - segmentStart) };
+			}
+
+			static size_t SegmentSize(size_t _segment) noexcept {
+				return SEGMENT_BASE_SIZE << _segment;
+			}
+
+			TSegment* GetOrCreateSegment(size_t _segment) noexcept {
+				TSegment* seg = m_segments[_segment].load(std::memory_order_acquire);
+				if (seg) return seg;
+
+				std::lock_guard<std::mutex> mute(m_growMutex);
+				seg = m_segments[_segment].load(std::memory_order_relaxed);
+				if (seg) return seg;
+
+				seg = new (std::nothrow) TSegment(SegmentSize(_segment));
+				if (!seg) return nullptr;
+				if (!seg->m_slots) {
+					delete seg;
+					return nullptr;
+				}
+				m_segments[_segment].store(seg, std::memory_order_release);
+				return seg;
+			}
+		public:
+			CLockRecordTable() = default;
+			~CLockRecordTable() {
+				for (auto& seg : m_segments) {
+					delete seg.load(std::memory_order_relaxed);
+				}
+			}
+
+			CLockRecordTable(const CLockRecordTable&) = delete;
+			CLockRecordTable& operator=(const CLockRecordTable&) = delete;
+
+			//Slot'u dondurur; segment henuz yoksa olusturur. Bellek yetersizse nullptr.
+			TValue* GetSlot(TLockID _id) noexcept {
+				auto [segment, index] = Locate(_id);
+				TSegment* seg = GetOrCreateSegment(segment);
+				if (!seg) return nullptr;
+				return &seg->m_slots[index];
+			}
+
+			//Segment olusturmadan slot'a bakar.
+			TValue* PeekSlot(TLockID _id) const noexcept {
+				auto [segment, index] = Locate(_id);
+				TSegment* seg = m_segments[segment].load(std::memory_order_acquire);
+				if (!seg) return nullptr;
+				return &seg->m_slots[index];
+			}
+
+			//Slot'u onceden cache'e ceker (toplu aramalarda).
+			void Prefetch(TLockID _id) const noexcept {
+				if (TValue* slot = PeekSlot(_id)) THREAD_SAFE_PREFETCH(slot);
+			}
+
+			//Dolu slot'u dondurur, yoksa nullptr.
+			TValue* Find(TLockID _id) const noexcept {
+				TValue* slot = PeekSlot(_id);
+				if (!slot || !*slot) return nullptr;
+				return slot;
+			}
+
+			TValue* TryEmplace(TLockID _id, TValue&& _value) noexcept {
+				TValue* slot = GetSlot(_id);
+				if (!slot || *slot) return nullptr; //zaten kayitli
+				*slot = std::move(_value);
+				return slot;
+			}
+
+			bool Erase(TLockID _id) noexcept {
+				TValue* slot = Find(_id);
+				if (!slot) return false;
+				*slot = TValue{};
+				return true;
+			}
+
+			//Dolu slotlari gezer: _func(TLockID, TValue&)
+			template<typename TFunc>
+			void ForEach(TFunc&& _func) const {
+				for (size_t segment = 0; segment < MAX_SEGMENT_COUNT; ++segment) {
+					TSegment* seg = m_segments[segment].load(std::memory_order_acquire);
+					if (!seg) continue;
+
+					const uint64_t segmentStart = ((uint64_t(1) << segment) - 1) << SEGMENT_BASE_SHIFT;
+					for (size_t i = 0; i < SegmentSize(segment); ++i) {
+						if (!seg->m_slots[i]) continue;
+						_func(static_cast<TLockID>(segmentStart + i), seg->m_slots[i]);
+					}
+				}
+			}
+		};
+
+		//Tracker kayitlari icin kilitsiz okunabilen tablo.
+		template<typename TValue>
+		class CPublishedRecordTable {
+		public:
+			static constexpr bool LOCK_FREE_READ = true; // Load kilitsiz cagrilabilir
+		private:
+			using TSlot = std::atomic<TValue*>;
+
+			//Faz basina okuyucu sayaci. Erase fazi degistirir ve sadece eski fazdaki okuyuculari bekler;
+			//surekli okuma olsa bile yeni okuyucular diger sayaca yazdigi icin bekleme biter.
+			struct alignas(CACHE_LINE_SIZE) TReaderSlot {
+				std::array<std::atomic<uint32_t>, 2> m_count{};
+			};
+
+			CLockRecordTable<TSlot> m_slots{};
+			std::array<TReaderSlot, RECORD_READER_SLOT_COUNT> m_readers{};
+			alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> m_phase{ 0 };
+		private:
+			static size_t GetThreadSlot() noexcept {
+				static std::atomic<size_t> s_nextSlot{ 0 };
+				thread_local size_t s_slot = s_nextSlot.fetch_add(1, std::memory_order_relaxed) % RECORD_READER_SLOT_COUNT;
+				return s_slot;
+			}
+
+			//Kutu slottan cikarildiktan sonra cagrilir: donuste onu gorebilecek okuyucu kalmamistir.
+			void WaitForReaders() noexcept {
+				const uint32_t phase = m_phase.fetch_xor(1, std::memory_order_seq_cst) & 1;
+				for (auto& reader : m_readers) {
+					while (reader.m_count[phase].load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+				}
+			}
+		public:
+			CPublishedRecordTable() = default;
+
+			~CPublishedRecordTable() {
+				m_slots.ForEach([](TLockID, TSlot& _slot) { delete _slot.load(std::memory_order_relaxed); });
+			}
+
+			CPublishedRecordTable(const CPublishedRecordTable&) = delete;
+			CPublishedRecordTable& operator=(const CPublishedRecordTable&) = delete;
+
+			void Prefetch(TLockID _id) const noexcept {
+				m_slots.Prefetch(_id);
+			}
+
+			//Kilitsiz okuma: yayinlanmis degerin kopyasini dondurur, yoksa bos deger.
+			TValue Load(TLockID _id) const noexcept {
+				TSlot* slot = m_slots.PeekSlot(_id);
+				if (!slot) return TValue{};
+
+				auto& count = const_cast<TReaderSlot&>(m_readers[GetThreadSlot()]).m_count[m_phase.load(std::memory_order_relaxed) & 1];
+				count.fetch_add(1, std::memory_order_seq_cst);
+				TValue* box = slot->load(std::memory_order_seq_cst);
+				TValue value = box ? *box : TValue{};
+				count.fetch_sub(1, std::memory_order_release);
+				return value;
+			}
+
+			//Dolu slot'un degerini dondurur, yoksa nullptr. Ekleme/silme kilidi altinda cagrilmalidir.
+			TValue* Find(TLockID _id) const noexcept {
+				TSlot* slot = m_slots.PeekSlot(_id);
+				if (!slot) return nullptr;
+				TValue* box = slot->load(std::memory_order_relaxed);
+				if (!box || !*box) return nullptr;
+				return box;
+			}
+
+			TValue* TryEmplace(TLockID _id, TValue&& _value) noexcept {
+				TSlot* slot = m_slots.GetSlot(_id);
+				if (!slot || slot->load(std::memory_order_relaxed)) return nullptr; //zaten kayitli
+				TValue* box = new (std::nothrow) TValue(std::move(_value));
+				if (!box) return nullptr;
+				slot->store(box, std::memory_order_release);
+				return box;
+			}
+
+			bool Erase(TLockID _id) noexcept {
+				TSlot* slot = m_slots.PeekSlot(_id);
+				if (!slot) return false;
+				TValue* box = slot->exchange(nullptr, std::memory_order_seq_cst);
+				if (!box) return false;
+				WaitForReaders();
+				delete box;
+				return true;
+			}
+
+			template<typename TFunc>
+			void ForEach(TFunc&& _func) const {
+				m_slots.ForEach([&_func](TLockID _id, TSlot& _slot) {
+					TValue* box = _slot.load(std::memory_order_relaxed);
+					if (box && *box) _func(_id, *box);
+				});
+			}
+		};
+
+		//Yogun id'ye sahip olmayan veri tipleri icin ayni arayuze sahip hash map.
+		template<typename TValue>
+		class CLockRecordMap {
+		public:
+			static constexpr bool LOCK_FREE_READ = false; // her arama kayit kilidi altinda yapilmalidir
+		private:
+			std::unordered_map<TLockID, TValue> m_records{};
+		public:
+			//Hash map'te slot adresi aramadan bilinemez.
+			void Prefetch(TLockID /*_id*/) const noexcept {}
+
+			TValue* Find(TLockID _id) noexcept {
+				auto found = m_records.find(_id);
+				if (found == m_records.end() || !found->second) return nullptr;
+				return &found->second;
+			}
+
+			TValue* TryEmplace(TLockID _id, TValue&& _value) noexcept {
+				try {
+					auto [iter, success] = m_records.try_emplace(_id, std::move(_value));
+					if (!success) return nullptr;
+					return &iter->second;
+				}
+				catch (...) {
+					return nullptr;
+				}
+			}
+
+			bool Erase(TLockID _id) noexcept {
+				return m_records.erase(_id) > 0;
+			}
+
+			template<typename TFunc>
+			void ForEach(TFunc&& _func) {
+				for (auto& [id, value] : m_records) {
+					if (!value) continue;
+					_func(id, value);
+				}
+			}
+		};
+
+		template<typename TElement, typename TValue>
+		using TLockRecordStore = std::conditional_t<TUseLockRecordTable<TElement>::value, CPublishedRecordTable<TValue>, CLockRecordMap<TValue>>;
+	};
+};
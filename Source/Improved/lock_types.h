@@ -15,19 +15,22 @@
 namespace NThreadSafe {
 	namespace NLock{
 	//Read ve write lock'lar icin ortak yapilari barindirir.
+	//Alanlar yazan tarafa gore ayri cache line'larda: sabitler (vptr ile), sahiplik (Add/RemoveOwnership) ve bekleyenler (Wait/notify).
+	//Boylece sahip eklenip cikarilirken bekleyenlerin cv'si ve sabit alanlari okuyanlar invalidate edilmez.
 	class AbstractLock : public ILock {
-	protected: //newly added
-		std::condition_variable m_cv{};
-		std::mutex m_cvMutex{};
-	protected:
+	protected: // okuma agirlikli
 		const ELockType m_lockType;
-		const uintptr_t m_mutexID; // sadece loglama icin
+		const TLockID m_mutexID; // sadece loglama icin
 		std::shared_mutex& m_mutex; // ulasilacak verinin mutex'i
-	protected:
+	protected: // sahipler
+		alignas(CACHE_LINE_SIZE) mutable std::shared_mutex m_classMutex{};
 		std::unordered_map<TID, TMutexThreadData> m_owners{};
-		mutable std::shared_mutex m_classMutex{};
+		bool m_bRemoved = false; // RemoveIfUnowned sonrasi sahip eklenmez
+	protected: // bekleyenler
+		alignas(CACHE_LINE_SIZE) std::condition_variable m_cv{};
+		std::mutex m_cvMutex{};
 	protected:
-		AbstractLock(ELockType _type, uintptr_t _mutexID, std::shared_mutex& _mutex) 
+		AbstractLock(ELockType _type, TLockID _mutexID, std::shared_mutex& _mutex) 
 		: m_lockType(_type), m_mutexID(_mutexID), m_mutex(_mutex) {}
 	protected:
 		bool IsOwner() const noexcept;
@@ -37,7 +40,7 @@ namespace NThreadSafe {
 		void PrintOwners() noexcept;
 	public:
 		ELockType GetType() const noexcept override { return m_lockType; }
-		uintptr_t GetMutexID() const noexcept override { return m_mutexID; }
+		TLockID GetMutexID() const noexcept override { return m_mutexID; }
 		std::shared_mutex& GetMutex() noexcept override { return m_mutex; }
 	public: // virtuals
 		~AbstractLock() override = default;
@@ -46,6 +49,8 @@ namespace NThreadSafe {
 		virtual void AddOwnership() noexcept override;
 		virtual void RemoveOwnership() noexcept override;
 		virtual bool ShouldRemove() noexcept override;
+		bool RemoveIfUnowned(const std::function<void()>& _unpublish) noexcept override;
+		bool IsRemoved() const noexcept override;
 
 		virtual void AcquireLock(ELockType _requesttype) noexcept override = 0;
 		virtual void RemoveGuard() noexcept override = 0;
@@ -58,7 +63,7 @@ namespace NThreadSafe {
 	class CReadLock : public AbstractLock {
 		std::optional<std::shared_lock<std::shared_mutex>> m_lockGuard;
 	public:
-		CReadLock(uintptr_t _mutexID, std::shared_mutex& _mutex) : AbstractLock(ELockType::Read, _mutexID, _mutex) {}
+		CReadLock(TLockID _mutexID, std::shared_mutex& _mutex) : AbstractLock(ELockType::Read, _mutexID, _mutex) {}
 
 		~CReadLock() override = default;
 
@@ -79,7 +84,7 @@ namespace NThreadSafe {
 	class CWriteLock : public AbstractLock {
 		std::optional<std::unique_lock<std::shared_mutex>> m_lockGuard;
 	public:
-		CWriteLock(uintptr_t _mutexID, std::shared_mutex& _mutex) : AbstractLock(ELockType::Write, _mutexID, _mutex) {}
+		CWriteLock(TLockID _mutexID, std::shared_mutex& _mutex) : AbstractLock(ELockType::Write, _mutexID, _mutex) {}
 
 		~CWriteLock() override = default;
 
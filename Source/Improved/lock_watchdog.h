@@ -0,0 +1,339 @@
+#pragma once
+#include "constants.h"
+#include "common_types.h"
+
+#include <singleton.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/*
+Uzun sure tutulan ve takilan kilitler icin bekci (watchdog).
+Kilit sahipleri tuttuklari kilitleri thread'e ait bir kayitta yayinlar (publish); bekci thread'i bu kayitlari
+periyodik olarak okur. Hicbir kilit ya da tracker mutex'i alinmaz, kilit islemleri durdurulmaz.
+
+Yayinlama sadece en az bir bekci calisirken yapilir; bekci yokken sicak yolun maliyeti tek bir relaxed okumadir.
+Async (detached) alinan kilitler bir thread'e ait olmadigi icin yayinlanmaz.
+
+tracker->StartWatchdog({}, [](const std::vector<THeldLockReport>& reports) { ... alarm ... });
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		static constexpr size_t PUBLISHED_HELD_CAPACITY = 16; // thread basina yayinlanabilen kilit sayisi
+		static constexpr uint32_t WATCHDOG_INTERVAL_MS = 500;
+
+		//Thread'lerin tuttugu kilitleri bekci icin yayinlar.
+		class CHeldLockRegistry : public CSingleton<CHeldLockRegistry> {
+		private:
+			struct TPublishedLock {
+				std::atomic<TLockID> m_lockID{ INVALID_LOCK_ID }; // 0: bos
+				std::atomic<ELockType> m_type{ ELockType::None };
+				std::atomic<uint64_t> m_sinceNs{ 0 };
+			};
+
+			//Kayitlar hic silinmez, thread bittiginde baska thread'lere verilir.
+			struct alignas(CACHE_LINE_SIZE) TThreadRecord {
+				std::atomic<bool> m_inUse{ false };
+				std::atomic<TID> m_owner{ TID() };
+				std::atomic<TLockID> m_waitingFor{ INVALID_LOCK_ID }; // deadlock tespiti icin beklenen kilit
+				TThreadRecord* m_next = nullptr;
+				uint32_t m_publishedCount = 0; // sadece sahibi kullanir
+				std::array<TPublishedLock, PUBLISHED_HELD_CAPACITY> m_locks{};
+			};
+
+			//Kayit yok edilmis bir ornege aitse (destroyAll) dokunulmaz.
+			struct TThreadHandle {
+				TThreadRecord* m_record = nullptr;
+				uint64_t m_generation = 0;
+				~TThreadHandle() {
+					if (!m_record || CHeldLockRegistry::instanceGeneration() != m_generation) return;
+					for (auto& lock : m_record->m_locks) {
+						lock.m_lockID.store(INVALID_LOCK_ID, std::memory_order_relaxed);
+					}
+					m_record->m_publishedCount = 0;
+					m_record->m_waitingFor.store(INVALID_LOCK_ID, std::memory_order_relaxed);
+					m_record->m_owner.store(TID(), std::memory_order_relaxed);
+					m_record->m_inUse.store(false, std::memory_order_release);
+				}
+			};
+
+			std::atomic<uint32_t> m_activeCount{ 0 }; // calisan bekci sayisi
+			std::atomic<TThreadRecord*> m_records{ nullptr };
+		private:
+			TThreadRecord* AcquireRecord() {
+				for (TThreadRecord* rec = m_records.load(std::memory_order_acquire); rec; rec = rec->m_next) {
+					bool expected = false;
+					if (rec->m_inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) return rec;
+				}
+
+				TThreadRecord* rec = new TThreadRecord();
+				rec->m_inUse.store(true, std::memory_order_relaxed);
+				TThreadRecord* head = m_records.load(std::memory_order_relaxed);
+				do {
+					rec->m_next = head;
+				} while (!m_records.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+				return rec;
+			}
+
+			static TThreadHandle& GetHandle() noexcept {
+				thread_local TThreadHandle s_handle{};
+				return s_handle;
+			}
+
+			//Thread'in bu ornekteki kaydi, yoksa nullptr.
+			static TThreadRecord* FindRecord() noexcept {
+				TThreadHandle& handle = GetHandle();
+				return handle.m_generation == instanceGeneration() ? handle.m_record : nullptr;
+			}
+
+			//Thread'in kaydi, yoksa alinir. Bellek yetmezse nullptr.
+			TThreadRecord* GetRecord() noexcept {
+				if (TThreadRecord* rec = FindRecord()) return rec;
+				TThreadHandle& handle = GetHandle();
+				try {
+					handle.m_record = AcquireRecord();
+				}
+				catch (...) {
+					return nullptr;
+				}
+				handle.m_generation = instanceGeneration();
+				handle.m_record->m_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+				return handle.m_record;
+			}
+
+			static uint64_t NowNs() noexcept {
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count());
+			}
+		public:
+			CHeldLockRegistry() = default;
+
+			//Sadece destroyAll/destroyInstance ile: kayitlari kullanan thread kalmamistir.
+			~CHeldLockRegistry() {
+				TThreadRecord* rec = m_records.load(std::memory_order_acquire);
+				while (rec) {
+					TThreadRecord* next = rec->m_next;
+					delete rec;
+					rec = next;
+				}
+			}
+
+			void Activate() noexcept {
+				m_activeCount.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			void Deactivate() noexcept {
+				m_activeCount.fetch_sub(1, std::memory_order_relaxed);
+			}
+
+			bool IsActive() const noexcept {
+				return m_activeCount.load(std::memory_order_relaxed) != 0;
+			}
+
+			void Publish(TLockID _lockID, ELockType _type) noexcept {
+				if (!IsActive() || _lockID == INVALID_LOCK_ID) return;
+
+				TThreadRecord* rec = GetRecord();
+				if (!rec) return;
+
+				for (auto& lock : rec->m_locks) {
+					if (lock.m_lockID.load(std::memory_order_relaxed) != INVALID_LOCK_ID) continue;
+					lock.m_type.store(_type, std::memory_order_relaxed);
+					lock.m_sinceNs.store(NowNs(), std::memory_order_relaxed);
+					lock.m_lockID.store(_lockID, std::memory_order_release);
+					rec->m_publishedCount++;
+					return;
+				}
+				//kapasite doldu, bu kilit izlenmez.
+			}
+
+			//Bekci durdurulmus olsa bile daha once yayinlananlar temizlenir.
+			void Unpublish(TLockID _lockID) noexcept {
+				TThreadRecord* rec = FindRecord();
+				if (!rec || rec->m_publishedCount == 0) return;
+
+				for (auto& lock : rec->m_locks) {
+					if (lock.m_lockID.load(std::memory_order_relaxed) != _lockID) continue;
+					lock.m_lockID.store(INVALID_LOCK_ID, std::memory_order_release);
+					rec->m_publishedCount--;
+					return;
+				}
+			}
+
+			//Thread'in _lockID'yi beklemeye basladigini yayinlar (deadlock tespiti). Kayit alinamazsa false.
+			//seq_cst: ayni anda beklemeye giren iki thread'den en az biri digerinin beklemesini gorur.
+			bool BeginWait(TLockID _lockID) noexcept {
+				TThreadRecord* rec = GetRecord();
+				if (!rec) return false;
+				rec->m_waitingFor.store(_lockID, std::memory_order_seq_cst);
+				return true;
+			}
+
+			void EndWait() noexcept {
+				TThreadRecord* rec = FindRecord();
+				if (rec) rec->m_waitingFor.store(INVALID_LOCK_ID, std::memory_order_relaxed);
+			}
+
+			//_lockID'yi yayinlayan her thread icin bir kez _func(TID owner, TLockID waitingFor) cagirir. waitingFor: sahibin bekledigi kilit, beklemiyorsa INVALID_LOCK_ID.
+			//Diger kilitlerin kayitlari okunmaz; anlik goruntudur.
+			template<typename TFunc>
+			void ForEachHolder(TLockID _lockID, TFunc&& _func) const {
+				for (TThreadRecord* rec = m_records.load(std::memory_order_acquire); rec; rec = rec->m_next) {
+					if (!rec->m_inUse.load(std::memory_order_acquire)) continue;
+					for (const auto& lock : rec->m_locks) {
+						if (lock.m_lockID.load(std::memory_order_acquire) != _lockID) continue;
+						_func(rec->m_owner.load(std::memory_order_relaxed), rec->m_waitingFor.load(std::memory_order_seq_cst));
+						break;
+					}
+				}
+			}
+
+			//Yayinlanan kilitleri gezer: _func(TID owner, TLockID, ELockType, uint64_t sinceNs, uint64_t heldNs). Kayitlar degisirken okunur, anlik goruntudur.
+			template<typename TFunc>
+			void ForEachPublished(TFunc&& _func) const {
+				const uint64_t now = NowNs();
+				for (TThreadRecord* rec = m_records.load(std::memory_order_acquire); rec; rec = rec->m_next) {
+					if (!rec->m_inUse.load(std::memory_order_acquire)) continue;
+					const TID owner = rec->m_owner.load(std::memory_order_relaxed);
+					for (const auto& lock : rec->m_locks) {
+						const TLockID lockID = lock.m_lockID.load(std::memory_order_acquire);
+						if (lockID == INVALID_LOCK_ID) continue;
+						const uint64_t since = lock.m_sinceNs.load(std::memory_order_relaxed);
+						const ELockType type = lock.m_type.load(std::memory_order_relaxed);
+						if (lock.m_lockID.load(std::memory_order_acquire) != lockID) continue; // okurken degisti
+						_func(owner, lockID, type, since, now > since ? now - since : 0);
+					}
+				}
+			}
+		};
+#define heldRegistryInstance NThreadSafe::NLock::CHeldLockRegistry::getInstance()
+
+		enum class EHoldSeverity {
+			LongHold, // m_longHoldMs asildi
+			Stuck, // m_stuckMs asildi
+		};
+
+		struct THeldLockReport {
+			TLockID m_lockID;
+			TID m_owner;
+			ELockType m_type;
+			uint64_t m_heldMs;
+			EHoldSeverity m_severity;
+		};
+
+		struct TWatchdogConfig {
+			uint32_t m_intervalMs = WATCHDOG_INTERVAL_MS;
+			uint64_t m_longHoldMs = LOG_HELD_MS_LIMIT;
+			uint64_t m_stuckMs = uint64_t(LOG_HELD_MS_LIMIT) * 10;
+		};
+
+		using TWatchdogCallback = std::function<void(const std::vector<THeldLockReport>&)>;
+
+		//Yayinlanan kilitleri periyodik tarar. Her sahiplik, her esik icin bir kez raporlanir.
+		class CLockWatchdog {
+		private:
+			using TReportKey = std::tuple<TID, TLockID, uint64_t/*since*/>;
+
+			TWatchdogConfig m_config{};
+			TWatchdogCallback m_callback{};
+			std::map<TReportKey, EHoldSeverity> m_reported{}; // sadece bekci thread'i kullanir
+
+			std::thread m_thread{};
+			std::mutex m_stopMutex{};
+			std::condition_variable m_stopCV{};
+			bool m_bStop = false;
+		private:
+			void Run() {
+				std::unique_lock<std::mutex> mute(m_stopMutex);
+				while (!m_bStop) {
+					m_stopCV.wait_for(mute, std::chrono::milliseconds(m_config.m_intervalMs), [this]() { return m_bStop; });
+					if (m_bStop) break;
+					mute.unlock();
+					ScanOnce();
+					mute.lock();
+				}
+			}
+		public:
+			CLockWatchdog() = default;
+			~CLockWatchdog() {
+				Stop();
+			}
+
+			CLockWatchdog(const CLockWatchdog&) = delete;
+			CLockWatchdog& operator=(const CLockWatchdog&) = delete;
+
+			//Zaten calisiyorsa false.
+			bool Start(const TWatchdogConfig& _config, TWatchdogCallback _callback) {
+				if (m_thread.joinable()) return false;
+				m_config = _config;
+				m_callback = std::move(_callback);
+				m_reported.clear();
+				m_bStop = false;
+				heldRegistryInstance.Activate();
+				try {
+					m_thread = std::thread([this]() { Run(); });
+				}
+				catch (...) {
+					heldRegistryInstance.Deactivate();
+					return false;
+				}
+				return true;
+			}
+
+			void Stop() {
+				if (!m_thread.joinable()) return;
+				{
+					std::lock_guard<std::mutex> mute(m_stopMutex);
+					m_bStop = true;
+				}
+				m_stopCV.notify_all();
+				m_thread.join();
+				heldRegistryInstance.Deactivate();
+			}
+
+			bool IsRunning() const noexcept {
+				return m_thread.joinable();
+			}
+
+			//Tek bir tarama yapar ve yeni esik asimlarini callback'e verir. Bekci thread'i disinda cagrilmamalidir (Start edilmemisse serbest).
+			void ScanOnce() {
+				std::vector<THeldLockReport> reports{};
+				std::map<TReportKey, EHoldSeverity> stillHeld{};
+
+				heldRegistryInstance.ForEachPublished([&](TID owner, TLockID lockID, ELockType type, uint64_t since, uint64_t heldNs) {
+					const uint64_t heldMs = heldNs / 1000000;
+					if (heldMs < m_config.m_longHoldMs) return;
+
+					const EHoldSeverity severity = heldMs >= m_config.m_stuckMs ? EHoldSeverity::Stuck : EHoldSeverity::LongHold;
+					const TReportKey key{ owner, lockID, since };
+					stillHeld[key] = severity;
+
+					auto found = m_reported.find(key);
+					if (found != m_reported.end() && found->second == severity) return; // zaten raporlandi
+					reports.push_back({ lockID, owner, type, heldMs, severity });
+				});
+				m_reported.swap(stillHeld);
+
+				if (reports.empty()) return;
+				if (m_callback) {
+					m_callback(reports);
+					return;
+				}
+#ifdef LOG_THREAD_SAFE
+				for (const auto& report : reports) {
+					LOG_WARN(LogClass::NORMAL, "Watchdog: thread(?) has held mutex(?) for (?) milliseconds (stuck: ?).", report.m_owner, report.m_lockID, report.m_heldMs, report.m_severity == EHoldSeverity::Stuck);
+				}
+#endif
+			}
+		};
+	};
+};
@@ -1,7 +1,7 @@
 #pragma once
 #include "common_types.h"
-
-#include <Singletons/future.h>
+#include "diagnostics.h"
+#include "task_executor.h"
 
 #include <atomic>
 #include <string>
@@ -10,31 +10,43 @@
 #include <chrono>
 #include <mutex>
 #include <condition_variable>
-#include <sstream>
+#include <vector>
 #include <algorithm>
 #include <thread>
 
 namespace NThreadSafe {
 	namespace NQueue{
 
+	using TQueueDiagnostics = NLock::TDefaultDiagnostics;
+
+	template<typename TData>
+	struct TNormalQueueLayout; // alan yerlesimini dogrulayan testler icin, bkz. Tests/cache_layout_test.cpp
+
+	//Yerlesim: okuma agirlikli alanlar (worker'larin her turda okudugu m_state dahil), ureticilerin aldigi m_mutex
+	//ve uretici/tuketici ortak kapsayici grubu ayri cache line'larda tutulur.
 	template<typename TData>
 	class CNormalQueue{
-		std::atomic<EQueueState> m_state;
-		std::mutex m_mutex; //Fonksiyonlar icin kullaniliyor.
+		friend struct TNormalQueueLayout<TData>;
 	public:
 		using DataType = std::decay_t<TData>;
 		using ProcessFunc = std::function<bool(DataType&)>;
-	private:
-		std::deque<QueuedOperation<TData>> m_container{};
-		std::mutex m_mutexContainer{};
-		std::condition_variable m_cv{};
-	private:
+	private: // okuma agirlikli
+		std::atomic<EQueueState> m_state;
 		std::atomic<uint8_t> m_workerThreadCount;
 		ProcessFunc m_processFunc;// worker thread'de her bir process için disaridan cagirilacak fonksiyon
+		TCpuSet m_workerAffinity{}; // bos degilse worker'lar bu CPU'lara sabitlenir
+		std::vector<TTaskHandle> m_workers{}; // m_mutex ile korunur
+		TTaskHandle m_cleaner{};
+	private: // ureticiler
+		alignas(NLock::CACHE_LINE_SIZE) std::mutex m_mutex; //Fonksiyonlar icin kullaniliyor.
+	private: // ureticiler + tuketiciler
+		alignas(NLock::CACHE_LINE_SIZE) std::mutex m_mutexContainer{};
+		std::condition_variable m_cv{};
+		std::deque<QueuedOperation<TData>> m_container{};
 	public:
-		CNormalQueue(ProcessFunc processFunc, uint8_t workerThreadCount = 1)
-			: m_state(EQueueState::THREADS_STOPPED), m_processFunc(processFunc) {
-		m_workerThreadCount = std::clamp(m_workerThreadCount.load(), MIN_WORKER_THREAD_COUNT, MAX_WORKER_THREAD_COUNT);
+		CNormalQueue(ProcessFunc processFunc, uint8_t workerThreadCount = 1, TCpuSet workerAffinity = {})
+			: m_state(EQueueState::THREADS_STOPPED), m_workerThreadCount(std::clamp(workerThreadCount, MIN_WORKER_THREAD_COUNT, MAX_WORKER_THREAD_COUNT)), m_processFunc(processFunc),
+			m_workerAffinity(std::move(workerAffinity)) {
 			StartThreads();
 		}
 		~CNormalQueue() {
@@ -46,13 +58,6 @@ namespace NThreadSafe {
 		CNormalQueue(const CNormalQueue& other) = delete;
 		CNormalQueue& operator=(const CNormalQueue& other) = delete;
 private:
-	std::string GetTaskName(uint8_t threadIndex){
-		std::lock_guard<std::mutex> funcMute(m_mutex);
-		std::stringstream ss{};
-		ss << this << "_" << typeid(DataType).name() << "_" << m_workerThreadCount << "_" << threadIndex;
-		return ss.str();
-	}
-
 	uint32_t Stop(bool bClearTasks){
 		std::lock_guard<std::mutex> funcMute(m_mutex);
 		uint32_t remainingWorkCount = 0;
@@ -67,9 +72,7 @@ private:
 	}
 
 	void StartCleaner() {
-		std::stringstream ss{};
-		ss << QUEUE_CLEANER_BASENAME << this;
-		futureInstance.addTask<void>(ss.str(), [this](std::atomic_bool& bForce) {
+		m_cleaner = executorInstance.Spawn([this](const CStopToken& bForce) {
 			while (!bForce) {
 				{
 					auto now = std::chrono::steady_clock::now();
@@ -86,7 +89,7 @@ private:
 						}
 					}
 				}
-				std::this_thread::sleep_for(std::chrono::seconds(CLEANER_INTERVAL));
+				bForce.WaitFor(std::chrono::seconds(CLEANER_INTERVAL)); // durdurulunca hemen uyanir
 			}
 		});
 	}
@@ -95,19 +98,22 @@ private:
 		if (GetState() == EQueueState::WORKING) return;
 
 		std::lock_guard<std::mutex> funcMute(m_mutex);
+		if (!m_workers.empty()) return;
 		StartCleaner();
 		for (uint8_t i = 0; i < m_workerThreadCount; i++){
-			futureInstance.addTask<void>(GetTaskName(i), 
-				[this](std::atomic_bool& bForce){
+			m_workers.push_back(executorInstance.Spawn(
+				[this](const CStopToken& bForce){
 					while (!bForce){
 						std::unique_lock<std::mutex> lock(m_mutexContainer); // wait icin kilit acilacagindan dolayi unique_lock kullanilir
-						m_cv.wait(lock, [this]{
-							return !m_container.empty() && 
-								   m_state.load(std::memory_order_acquire) == EQueueState::WORKING;
+						m_cv.wait(lock, [this, &bForce]{
+							return bForce.IsStopRequested() ||
+								   (!m_container.empty() && 
+								   m_state.load(std::memory_order_acquire) == EQueueState::WORKING);
 						});
-						if (m_container.empty()) continue;
+						if (bForce || m_container.empty()) continue;
 
 						if (!m_processFunc){
+							lock.unlock();
 							StopThreads(true);
 							break;
 						}
@@ -119,7 +125,10 @@ private:
 						m_container.pop_front();
 						lock.unlock();
 
-						if (!m_processFunc(task.m_data)){
+						TQueueDiagnostics::Event(NLock::ELockEvent::QueueTaskBegin, NLock::INVALID_LOCK_ID);
+						const bool bSuccess = m_processFunc(task.m_data);
+						TQueueDiagnostics::Event(NLock::ELockEvent::QueueTaskEnd, NLock::INVALID_LOCK_ID, NLock::ELockType::None, bSuccess ? 1 : 0);
+						if (!bSuccess){
 							task.m_retry_count++;
 							if (task.m_retry_count < MAX_RETRY_COUNT){
 								lock.lock();
@@ -128,8 +137,8 @@ private:
 							}
 						}
 					}
-				}
-			);
+				}, m_workerAffinity
+			));
 		}
 	}	
 
@@ -152,18 +161,28 @@ public:
 	}
 	
 	void StopThreads(bool bClearTasks = false) {
-		if (GetState() == EQueueState::THREADS_STOPPED) return;
-
 		// Önce state'i değiştirerek yeni işlerin işlenmesini durdur
 		SetState(EQueueState::THREADS_STOPPED);
 		
-		for (uint8_t i = 0; i < m_workerThreadCount; i++) {
-			futureInstance.forceStop(GetTaskName(i));
+		std::vector<TTaskHandle> tasks{};
+		{
+			std::lock_guard<std::mutex> funcMute(m_mutex);
+			tasks.swap(m_workers);
+			tasks.push_back(m_cleaner);
+			m_cleaner = {};
+		}
+		for (const auto& task : tasks) {
+			executorInstance.RequestStop(task);
+		}
+		{
+			//Beklemedeki worker'lar token'i gorebilsin diye uyandir.
+			std::lock_guard<std::mutex> lock(m_mutexContainer);
+		}
+		m_cv.notify_all();
+		//Worker'lar `this`'i kullandigi icin donmeden once bitmelerini bekle (worker kendi tutamacini beklemez).
+		for (const auto& task : tasks) {
+			executorInstance.Join(task);
 		}
-
-		std::stringstream ss{};
-		ss << QUEUE_CLEANER_BASENAME << this;
-		futureInstance.forceStop(ss.str());
 
 		// Kalan işleri temizle
 		uint32_t remainingWorkCount = Stop(bClearTasks);
@@ -171,13 +190,16 @@ public:
 
 	void AddTask(DataType&& task) {
 		std::lock_guard<std::mutex> funcMute(m_mutex);
+		size_t queueSize = 0;
 		{
 			std::unique_lock<std::mutex> lock(m_mutexContainer);
 			if (m_container.size() >= MAX_QUEUE_SIZE) {
 				m_container.pop_front(); // Remove oldest task
 			}
 			m_container.emplace_back(std::move(task));
+			queueSize = m_container.size();
 		}
+		TQueueDiagnostics::Event(NLock::ELockEvent::QueuePush, NLock::INVALID_LOCK_ID, NLock::ELockType::None, static_cast<uint32_t>(queueSize));
 		m_cv.notify_one();
 	}
 
@@ -0,0 +1,214 @@
+#pragma once
+#include "common_types.h"
+#include "queue_normal.h" // TQueueDiagnostics
+#include "task_executor.h"
+#include "cpu_affinity.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+/*
+NUMA dugumu basina ayri kuyruk. Her dugumun worker'lari o dugumun CPU'larina sabitlenir ve once kendi kuyrugundan alir,
+kendi kuyrugu bossa diger dugumlerden calar (steal). Parca yapilari kendi dugumune sabitlenmis thread'de olusturulur (first touch).
+
+AddTask isi cagiran thread'in bulundugu dugume koyar; ureticiler de sabitlenmisse is dugum disina hic cikmaz.
+GetStats yerel/calinan is sayilarini verir: calinan oran dugumler arasi trafigin olcusudur.
+
+Tek dugumlu makinelerde tek parca olur ve CNormalQueue gibi davranir. nodeCount verilirse gercek dugum sayisindan bagimsiz
+o kadar parca olusturulur (parca i, i % gercek dugum sayisi dugumune sabitlenir), boylece calma davranisi tek soketli makinede de denenebilir.
+*/
+namespace NThreadSafe {
+	namespace NQueue {
+		static constexpr uint16_t NUMA_STEAL_WAIT_MS = 2; // yerel kuyruk bosken calma denemeleri arasindaki bekleme
+
+		struct TNumaQueueStats {
+			uint64_t m_localCount = 0; // kendi dugumunden alinan isler
+			uint64_t m_stolenCount = 0; // baska dugumden calinan isler
+		};
+
+		template<typename TData>
+		class CNumaQueue {
+		public:
+			using DataType = std::decay_t<TData>;
+			using ProcessFunc = std::function<bool(DataType&)>;
+		private:
+			struct alignas(NLock::CACHE_LINE_SIZE) TNodeShard {
+				std::mutex m_mutex{};
+				std::condition_variable m_cv{};
+				std::deque<QueuedOperation<TData>> m_container{};
+				std::atomic<size_t> m_size{ 0 }; // calan thread'ler kilit almadan bos parcayi atlar
+				TCpuSet m_cpus{};
+				alignas(NLock::CACHE_LINE_SIZE) std::atomic<uint64_t> m_localCount{ 0 };
+				std::atomic<uint64_t> m_stolenCount{ 0 };
+			};
+
+			std::vector<std::unique_ptr<TNodeShard>> m_shards{};
+			std::vector<TTaskHandle> m_workers{};
+			ProcessFunc m_processFunc;
+		private:
+			static void Push(TNodeShard& _shard, QueuedOperation<TData>&& _task) {
+				size_t queueSize = 0;
+				{
+					std::lock_guard<std::mutex> lock(_shard.m_mutex);
+					if (_shard.m_container.size() >= MAX_QUEUE_SIZE) {
+						_shard.m_container.pop_front(); // Remove oldest task
+					}
+					_shard.m_container.push_back(std::move(_task));
+					queueSize = _shard.m_container.size();
+					_shard.m_size.store(queueSize, std::memory_order_relaxed);
+				}
+				TQueueDiagnostics::Event(NLock::ELockEvent::QueuePush, NLock::INVALID_LOCK_ID, NLock::ELockType::None, static_cast<uint32_t>(queueSize));
+				_shard.m_cv.notify_one();
+			}
+
+			static std::optional<QueuedOperation<TData>> PopFront(TNodeShard& _shard) {
+				if (_shard.m_container.empty()) return std::nullopt;
+				std::optional<QueuedOperation<TData>> task{ std::move(_shard.m_container.front()) };
+				_shard.m_container.pop_front();
+				_shard.m_size.store(_shard.m_container.size(), std::memory_order_relaxed);
+				return task;
+			}
+
+			std::optional<QueuedOperation<TData>> PopLocal(TNodeShard& _shard, const CStopToken& bForce, bool bWait) {
+				std::unique_lock<std::mutex> lock(_shard.m_mutex);
+				if (bWait) {
+					_shard.m_cv.wait_for(lock, std::chrono::milliseconds(NUMA_STEAL_WAIT_MS), [&]() {
+						return bForce.IsStopRequested() || !_shard.m_container.empty();
+					});
+				}
+				return PopFront(_shard);
+			}
+
+			std::optional<QueuedOperation<TData>> Steal(size_t _node) {
+				for (size_t i = 1; i < m_shards.size(); ++i) {
+					TNodeShard& victim = *m_shards[(_node + i) % m_shards.size()];
+					if (victim.m_size.load(std::memory_order_relaxed) == 0) continue;
+
+					std::unique_lock<std::mutex> lock(victim.m_mutex, std::try_to_lock);
+					if (!lock.owns_lock()) continue; // sahibi calisiyor, baskasina bak
+					auto task = PopFront(victim);
+					if (task) return task;
+				}
+				return std::nullopt;
+			}
+
+			void WorkerLoop(size_t _node, const CStopToken& bForce) {
+				TNodeShard& local = *m_shards[_node];
+				bool bStole = false; // son turda calindiysa diger dugumde hala is vardir, beklemeden tekrar dene
+				while (!bForce) {
+					auto task = PopLocal(local, bForce, !bStole);
+					bStole = false;
+					if (task) {
+						local.m_localCount.fetch_add(1, std::memory_order_relaxed);
+					}
+					else {
+						task = Steal(_node);
+						if (!task) continue;
+						bStole = true;
+						local.m_stolenCount.fetch_add(1, std::memory_order_relaxed);
+					}
+
+					TQueueDiagnostics::Event(NLock::ELockEvent::QueueTaskBegin, NLock::INVALID_LOCK_ID);
+					const bool bSuccess = m_processFunc(task->m_data);
+					TQueueDiagnostics::Event(NLock::ELockEvent::QueueTaskEnd, NLock::INVALID_LOCK_ID, NLock::ELockType::None, bSuccess ? 1 : 0);
+					if (!bSuccess) {
+						task->m_retry_count++;
+						if (task->m_retry_count < MAX_RETRY_COUNT) {
+							Push(local, std::move(*task)); // tekrar deneme yerel dugumde kalir
+						}
+					}
+				}
+			}
+		public:
+			//nodeCount 0 ise gercek NUMA dugum sayisi kullanilir.
+			CNumaQueue(ProcessFunc processFunc, uint8_t workersPerNode = 1, size_t nodeCount = 0)
+				: m_processFunc(std::move(processFunc)) {
+				const auto& nodes = cpuTopologyInstance.GetNodes();
+				if (nodeCount == 0) nodeCount = nodes.size();
+				workersPerNode = std::clamp(workersPerNode, MIN_WORKER_THREAD_COUNT, MAX_WORKER_THREAD_COUNT);
+
+				m_shards.reserve(nodeCount);
+				for (size_t node = 0; node < nodeCount; ++node) {
+					const TCpuSet& cpus = nodes[node % nodes.size()].m_cpus;
+					//Parca o dugumde olusturulur: mutex, sayaclar ve deque'nin ilk blogu yerel bellege duser.
+					auto shard = CCpuTopology::RunOn(cpus, []() { return std::make_unique<TNodeShard>(); });
+					shard->m_cpus = cpus;
+					m_shards.push_back(std::move(shard));
+				}
+
+				if (!m_processFunc) return;
+				for (size_t node = 0; node < nodeCount; ++node) {
+					for (uint8_t i = 0; i < workersPerNode; ++i) {
+						m_workers.push_back(executorInstance.Spawn([this, node](const CStopToken& bForce) {
+							WorkerLoop(node, bForce);
+						}, m_shards[node]->m_cpus));
+					}
+				}
+			}
+
+			~CNumaQueue() {
+				Stop();
+			}
+
+			CNumaQueue(const CNumaQueue& other) = delete;
+			CNumaQueue& operator=(const CNumaQueue& other) = delete;
+
+			//Worker'lari durdurur ve bitmelerini bekler. Kuyruktaki isler silinmez.
+			void Stop() {
+				for (const auto& worker : m_workers) {
+					executorInstance.RequestStop(worker);
+				}
+				for (auto& shard : m_shards) {
+					{
+						std::lock_guard<std::mutex> lock(shard->m_mutex);
+					}
+					shard->m_cv.notify_all();
+				}
+				for (const auto& worker : m_workers) {
+					executorInstance.Join(worker);
+				}
+				m_workers.clear();
+			}
+
+			size_t GetNodeCount() const noexcept {
+				return m_shards.size();
+			}
+
+			//Cagiran thread'in dugumune ekler.
+			void AddTask(DataType&& task) {
+				AddTask(std::move(task), cpuTopologyInstance.GetCurrentNode());
+			}
+
+			void AddTask(const DataType& task) {
+				AddTask(DataType(task));
+			}
+
+			void AddTask(DataType&& task, size_t node) {
+				Push(*m_shards[node % m_shards.size()], QueuedOperation<TData>(std::move(task)));
+			}
+
+			size_t GetSize() const {
+				size_t size = 0;
+				for (const auto& shard : m_shards) size += shard->m_size.load(std::memory_order_relaxed);
+				return size;
+			}
+
+			TNumaQueueStats GetStats() const noexcept {
+				TNumaQueueStats stats{};
+				for (const auto& shard : m_shards) {
+					stats.m_localCount += shard->m_localCount.load(std::memory_order_relaxed);
+					stats.m_stolenCount += shard->m_stolenCount.load(std::memory_order_relaxed);
+				}
+				return stats;
+			}
+		};
+	};
+};
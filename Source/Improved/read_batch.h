@@ -0,0 +1,103 @@
+#pragma once
+
+/*
+Cok sayida kaydi okuma kilidi altinda taramak icin toplu erisim.
+Kayit basina CDataWrapper olusturmak yerine kilitler tek cagrida alinir ve tek cagrida birakilir:
+tracker tablosu kayit basina degil toplu olarak kilitlenir, thread kaydina (m_heldLocks) tek seferde eklenir,
+siradaki kayitlarin ve kilit kayitlarinin bellegi onceden cache'e cekilir (BATCH_PREFETCH_DISTANCE).
+
+auto batch = tracker->AcquireReadBatch(records); // veya store.AccessReadBatch(keys)
+for (const auto& person : batch) total += person->m_age;
+for (const auto& person : batch.GetBusy()) ... // yazma kilidi tutulan kayitlar, sonra tekrar denenebilir
+batch.Release(); // yoksa yok edilirken birakilir
+
+Kilitler beklenmeden alinir; alinamayanlar GetBusy'de doner. Kayitlar kilit sirasina (mutexID) gore dizilir ve tekillestirilir.
+Inline kilitli verilerde kilitler thread kaydina eklenmez (detached): toplu okuma tutulurken ayni thread'de
+beklemeli bir yazma erisimi yapilmamalidir, deadlock tespiti bu kilitleri goremez.
+Batch'i alan thread birakmalidir (inline kilitliler haric).
+*/
+#include "constants.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace NThreadSafe {
+	namespace NLock {
+		template<typename TData, typename TTracker>
+		class CReadBatch {
+		private:
+			std::shared_ptr<TTracker> m_tracker{};
+			std::vector<TData> m_records{}; // kilidi alinan kayitlar, mutexID sirasinda
+			std::vector<TData> m_busy{}; // kilidi alinamayan kayitlar
+			uint64_t m_holdStart = 0; // profilleyici orneklediyse batch'in alinma zamani
+		public:
+			using const_iterator = typename std::vector<TData>::const_iterator;
+
+			CReadBatch() = default;
+			CReadBatch(std::shared_ptr<TTracker> _tracker, std::vector<TData>&& _records, std::vector<TData>&& _busy, uint64_t _holdStart) noexcept
+				: m_tracker(std::move(_tracker)), m_records(std::move(_records)), m_busy(std::move(_busy)), m_holdStart(_holdStart) {}
+
+			~CReadBatch() {
+				Release();
+			}
+
+			CReadBatch(CReadBatch&& other) noexcept
+				: m_tracker(std::move(other.m_tracker)), m_records(std::move(other.m_records)), m_busy(std::move(other.m_busy)),
+				m_holdStart(std::exchange(other.m_holdStart, 0)) {
+				other.m_records.clear();
+			}
+
+			CReadBatch& operator=(CReadBatch&& other) noexcept {
+				if (this != &other) {
+					Release();
+					m_tracker = std::move(other.m_tracker);
+					m_records = std::move(other.m_records);
+					m_busy = std::move(other.m_busy);
+					m_holdStart = std::exchange(other.m_holdStart, 0);
+					other.m_records.clear();
+				}
+				return *this;
+			}
+
+			CReadBatch(const CReadBatch&) = delete;
+			CReadBatch& operator=(const CReadBatch&) = delete;
+
+			//Tum kilitleri tek cagrida birakir. Sonrasinda batch bostur; mesgul listesi korunur.
+			void Release() noexcept {
+				if (!m_tracker) return;
+				if (!m_records.empty()) {
+					m_tracker->ReleaseReadBatch(m_records, m_holdStart);
+					m_records.clear();
+				}
+				m_tracker.reset();
+			}
+
+			const_iterator begin() const noexcept { return m_records.begin(); }
+			const_iterator end() const noexcept { return m_records.end(); }
+
+			const TData& operator[](size_t _index) const noexcept {
+				return m_records[_index];
+			}
+
+			size_t Size() const noexcept {
+				return m_records.size();
+			}
+
+			bool Empty() const noexcept {
+				return m_records.empty();
+			}
+
+			//Istenen tum kayitlarin kilidi alindi mi?
+			bool IsComplete() const noexcept {
+				return m_busy.empty();
+			}
+
+			const std::vector<TData>& GetBusy() const noexcept {
+				return m_busy;
+			}
+		};
+	};
+};
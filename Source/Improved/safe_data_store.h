@@ -0,0 +1,241 @@
+#pragma once
+#include "constants.h"
+#include "data_wrapper.h"
+#include "thread_tracker.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+Verileri anahtar ile tutan, parcali (sharded) ve thread-safe kayit deposu.
+Her parcanin kendi shared_mutex'i vardir: aramalar sadece ilgili parcayi okuma kilidiyle kilitler,
+farkli parcalara yapilan ekleme/silme islemleri birbirini beklemez.
+
+Access sonucu her zamanki CDataWrapper'dir; kilit yonetimi depoya ait CNewThreadTracker ile yapilir.
+Veri kilidi (CDataWrapper) alinmadan once parca kilidi birakilir, boylece bekleyen bir erisim depoyu kilitlemez.
+Cok sayida kaydi okuyan taramalar icin AccessReadBatch kayit basina wrapper olusturmaz (bkz. read_batch.h).
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		static constexpr size_t DEFAULT_STORE_SHARD_COUNT = 64;
+
+		template<typename TStore>
+		struct TSafeDataStoreProbe; // mesgul erisim yolunu dogrulayan testler icin, bkz. Tests/safe_data_store_test.cpp
+
+		template<typename TKey, typename TData, size_t SHARD_COUNT = DEFAULT_STORE_SHARD_COUNT, typename THash = std::hash<TKey>>
+		class CSafeDataStore {
+			friend struct TSafeDataStoreProbe<CSafeDataStore>;
+			static_assert(SHARD_COUNT > 0 && (SHARD_COUNT & (SHARD_COUNT - 1)) == 0, "SHARD_COUNT must be a power of two.");
+		public:
+			using TElement = typename TData::element_type;
+			using TTracker = CNewThreadTracker<TData>;
+			using TWrapper = typename TTracker::TWrapper;
+			using TBusyFunc = std::function<void(TData)>;
+		private:
+			struct alignas(CACHE_LINE_SIZE) TShard {
+				mutable std::shared_mutex m_mutex{};
+				std::unordered_map<TKey, TData, THash> m_records{};
+			};
+
+			std::array<TShard, SHARD_COUNT> m_shards{};
+			std::shared_ptr<TTracker> m_tracker;
+			THash m_hasher{};
+		private:
+			TShard& GetShard(const TKey& _key) noexcept {
+				uint64_t hash = static_cast<uint64_t>(m_hasher(_key));
+				//std::hash tam sayilar icin birim fonksiyon olabilir, bitleri karistir.
+				hash ^= hash >> 33;
+				hash *= 0xff51afd7ed558ccdULL;
+				hash ^= hash >> 33;
+				return m_shards[static_cast<size_t>(hash & (SHARD_COUNT - 1))];
+			}
+
+			const TShard& GetShard(const TKey& _key) const noexcept {
+				return const_cast<CSafeDataStore*>(this)->GetShard(_key);
+			}
+
+			TWrapper MakeWrapper(const TData& _data, ELockType _requestType) {
+				return TWrapper(
+					m_tracker,
+					_data,
+					std::optional<std::reference_wrapper<std::shared_mutex>>(_data->m_mutex),
+					_data->m_mutexID,
+					_requestType
+				);
+			}
+
+			//Erisim mesgulken _ifBusy operasyon olarak eklenir. Eklenirken kilit serbest kaldiysa (LOCK_AVAIL) erisim tekrar denenir;
+			//yine mesgulse operasyon tekrar eklenir, _ifBusy kaybolmaz.
+			TWrapper QueueIfBusy(const TData& _data, ELockType _requestType, TWrapper&& _busy, const TBusyFunc& _ifBusy) {
+				TWrapper wrapper = std::move(_busy);
+				while (wrapper == EWrapperResult::BUSY) {
+					auto opRes = m_tracker->AddOperationWithData(_data->m_mutexID, TBusyFunc(_ifBusy), _data);
+					if (opRes != EAddOperationResult::LOCK_AVAIL) {
+#ifdef LOG_THREAD_SAFE
+						if (opRes == EAddOperationResult::FAILED) {
+							LOG_ERR(LogClass::NORMAL, "Access: AddOperation failed for mutexID(?).", _data->m_mutexID);
+						}
+#endif
+						break;
+					}
+					wrapper = MakeWrapper(_data, _requestType);
+				}
+				return wrapper;
+			}
+		public:
+			explicit CSafeDataStore(size_t _expectedCount = 0) : m_tracker(std::make_shared<TTracker>()) {
+				if (_expectedCount == 0) return;
+				const size_t perShard = _expectedCount / SHARD_COUNT + 1;
+				for (auto& shard : m_shards) {
+					shard.m_records.reserve(perShard);
+				}
+			}
+
+			CSafeDataStore(const CSafeDataStore&) = delete;
+			CSafeDataStore& operator=(const CSafeDataStore&) = delete;
+
+			std::shared_ptr<TTracker> GetThreadTracker() const noexcept {
+				return m_tracker;
+			}
+
+			//Kilit almadan veriyi dondurur. Veriye erismek icin Access kullanilmalidir.
+			TData Find(const TKey& _key) const {
+				const TShard& shard = GetShard(_key);
+				std::shared_lock<std::shared_mutex> mute(shard.m_mutex);
+				auto found = shard.m_records.find(_key);
+				if (found == shard.m_records.end()) return nullptr;
+				return found->second;
+			}
+
+			bool Contains(const TKey& _key) const {
+				return Find(_key) != nullptr;
+			}
+
+			//Veri mesgulse ve _ifBusy verilmisse, operasyon kilit musait oldugunda calistirilmak uzere eklenir.
+			TWrapper Access(const TKey& _key, ELockType _requestType = ELockType::Read, TBusyFunc _ifBusy = nullptr) {
+				TData data = Find(_key);
+				if (!data) {
+#ifdef LOG_THREAD_SAFE
+					LOG_TRACE(LogClass::NORMAL, "Access: key not found in store.");
+#endif
+					return TWrapper();
+				}
+
+				auto wrapper = MakeWrapper(data, _requestType);
+				if (wrapper != EWrapperResult::BUSY || !_ifBusy) return wrapper;
+				return QueueIfBusy(data, _requestType, std::move(wrapper), _ifBusy);
+			}
+
+			//Veri bulunamazsa _onGranted bos wrapper ile hemen cagrilir. Sadece inline kilitli veriler icin (bkz. CNewThreadTracker::AcquireAsync).
+			void AccessAsync(const TKey& _key, ELockType _requestType, std::function<void(TWrapper)>&& _onGranted) {
+				m_tracker->AcquireAsync(Find(_key), _requestType, std::move(_onGranted));
+			}
+
+			std::future<TWrapper> AccessAsync(const TKey& _key, ELockType _requestType = ELockType::Read) {
+				return m_tracker->AcquireAsync(Find(_key), _requestType);
+			}
+
+			//Kisa yazma islemi: _func(TElement&) kilit elizyonu ile, olmazsa yazma kilidi altinda calisir (bkz. lock_elision.h).
+			template<typename TFunc>
+			EWrapperResult WriteElided(const TKey& _key, TFunc&& _func) {
+				return m_tracker->WriteElided(Find(_key), std::forward<TFunc>(_func));
+			}
+
+			//Inline kilitli veriler icin: kilit altinda _func(TElement&)'i calistirir, wrapper olusturmaz (bkz. CNewThreadTracker::With).
+			template<typename TFunc>
+			EApplyResult With(const TKey& _key, ELockType _requestType, TFunc&& _func, bool bDefer = true) {
+				return m_tracker->With(Find(_key), _requestType, std::forward<TFunc>(_func), bDefer);
+			}
+
+			template<typename TFunc>
+			EApplyResult TryWith(const TKey& _key, ELockType _requestType, TFunc&& _func, bool bDefer = true) {
+				return m_tracker->TryWith(Find(_key), _requestType, std::forward<TFunc>(_func), bDefer);
+			}
+
+			//Toplu okuma (bkz. read_batch.h): [_first, _last) anahtarlarinin okuma kilitleri tek cagrida alinir.
+			//Bulunamayan anahtarlar atlanir, kilidi alinamayanlar GetBusy'de doner.
+			template<typename TIter>
+			CReadBatch<TData, TTracker> AccessReadBatch(TIter _first, TIter _last) {
+				std::vector<TData> records{};
+				if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<TIter>::iterator_category>) {
+					records.reserve(static_cast<size_t>(std::distance(_first, _last)));
+				}
+				for (; _first != _last; ++_first) {
+					if (TData data = Find(*_first)) records.push_back(std::move(data));
+				}
+				return m_tracker->AcquireReadBatch(std::move(records));
+			}
+
+			CReadBatch<TData, TTracker> AccessReadBatch(const std::vector<TKey>& _keys) {
+				return AccessReadBatch(_keys.begin(), _keys.end());
+			}
+
+			//Anahtar zaten varsa eklenmez.
+			bool Insert(const TKey& _key, TData _data) {
+				if (!_data) return false;
+				TShard& shard = GetShard(_key);
+				std::unique_lock<std::shared_mutex> mute(shard.m_mutex);
+				return shard.m_records.try_emplace(_key, std::move(_data)).second;
+			}
+
+			template<typename... TArgs>
+			bool Emplace(const TKey& _key, TArgs&&... _args) {
+				TShard& shard = GetShard(_key);
+				std::unique_lock<std::shared_mutex> mute(shard.m_mutex);
+				if (shard.m_records.find(_key) != shard.m_records.end()) return false;
+				return shard.m_records.try_emplace(_key, std::make_shared<TElement>(std::forward<TArgs>(_args)...)).second;
+			}
+
+			//Veri depodan cikarilir; elinde wrapper olanlar veriyi kullanmaya devam edebilir (shared_ptr).
+			TData Erase(const TKey& _key) {
+				TShard& shard = GetShard(_key);
+				std::unique_lock<std::shared_mutex> mute(shard.m_mutex);
+				auto found = shard.m_records.find(_key);
+				if (found == shard.m_records.end()) return nullptr;
+				TData erased = std::move(found->second);
+				shard.m_records.erase(found);
+				return erased;
+			}
+
+			size_t Size() const {
+				size_t total = 0;
+				for (const auto& shard : m_shards) {
+					std::shared_lock<std::shared_mutex> mute(shard.m_mutex);
+					total += shard.m_records.size();
+				}
+				return total;
+			}
+
+			//Tum verileri gezer: _func(const TKey&, const TData&).
+			//Parca kilidi _func cagrilmadan once birakilir; _func icinde Access/Insert/Erase kullanilabilir.
+			template<typename TFunc>
+			void ForEach(TFunc&& _func) const {
+				std::vector<std::pair<TKey, TData>> records{};
+				for (const auto& shard : m_shards) {
+					records.clear();
+					{
+						std::shared_lock<std::shared_mutex> mute(shard.m_mutex);
+						records.reserve(shard.m_records.size());
+						for (const auto& [key, data] : shard.m_records) {
+							records.emplace_back(key, data);
+						}
+					}
+					for (const auto& [key, data] : records) {
+						_func(key, data);
+					}
+				}
+			}
+		};
+	};
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include "constants.h"
+#include "inline_lock.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/*
+Kucuk ve trivially copyable veriler icin sira (sequence) kilidi.
+Yazma yolu degismez: CDataWrapper ile yazma kilidi alan herkes versiyonu tek sayiya, birakirken cift sayiya cevirir.
+Okuyucular hic kilit almadan Snapshot() ile verinin kopyasini alir; kopya sirasinda yazma olduysa tekrar dener.
+
+struct TPersonValue { int m_age; int m_id; };
+struct TPerson : public TSeqLockSafeData<TPersonValue> {};
+...
+TPersonValue value = person->Snapshot(); // kilitsiz okuma
+*/
+namespace NThreadSafe {
+	namespace NLock {
+		template<typename TLock = CInlineLock>
+		class CSeqLock : public TLock {
+		private:
+			std::atomic<uint32_t> m_version{ 0 }; // tek: yazma devam ediyor
+		private:
+			//Yazma kilidi tutulurken cagrildigi icin versiyona sadece yazici dokunur.
+			void BeginWrite() noexcept {
+				m_version.store(m_version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+			}
+
+			void EndWrite() noexcept {
+				m_version.store(m_version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+			}
+		public:
+			bool TryLockExclusive() noexcept {
+				if (!TLock::TryLockExclusive()) return false;
+				BeginWrite();
+				return true;
+			}
+
+			bool TryUpgrade() noexcept {
+				if (!TLock::TryUpgrade()) return false;
+				BeginWrite();
+				return true;
+			}
+
+			void UnlockExclusive() noexcept {
+				EndWrite();
+				TLock::UnlockExclusive();
+			}
+
+			//Sadece TLock kuyrukla beklemeyi destekliyorsa (bkz. CFairLock).
+			template<typename T = TLock, typename = decltype(std::declval<T&>().Lock(ELockType::Write, std::chrono::steady_clock::time_point{}))>
+			bool Lock(ELockType _requestType, std::chrono::steady_clock::time_point _deadline) noexcept {
+				if (!TLock::Lock(_requestType, _deadline)) return false;
+				if (_requestType == ELockType::Write) BeginWrite();
+				return true;
+			}
+
+			void Downgrade(uint32_t _readers) noexcept {
+				EndWrite();
+				TLock::Downgrade(_readers);
+			}
+
+			//Okuma baslangici: yazma bitene kadar bekler ve cift versiyonu dondurur.
+			uint32_t ReadBegin() const noexcept {
+				for (;;) {
+					uint32_t version = m_version.load(std::memory_order_acquire);
+					if (!(version & 1)) return version;
+					std::this_thread::yield();
+				}
+			}
+
+			//Okuma sirasinda yazma olduysa true.
+			bool ReadRetry(uint32_t _version) const noexcept {
+				std::atomic_thread_fence(std::memory_order_acquire);
+				return m_version.load(std::memory_order_relaxed) != _version;
+			}
+
+			//Kilit alinmadan (RTM transaction'i icinde) yapilan yazmayi okuyuculara bildirir, bkz. lock_elision.h.
+			//Transaction atomik oldugu icin versiyon tek sayidan gecmeden iki artar.
+			void MarkElidedWrite() noexcept {
+				m_version.store(m_version.load(std::memory_order_relaxed) + 2, std::memory_order_relaxed);
+			}
+
+			uint32_t GetVersion() const noexcept {
+				return m_version.load(std::memory_order_acquire);
+			}
+		};
+
+		//Kilitsiz okunabilir veri. Degerler m_value icinde tutulur, yazma her zamanki gibi CDataWrapper ile yapilir.
+		template<typename TValue, typename TLock = CInlineLock>
+		struct TSeqLockSafeData : public TInlineSafeData<CSeqLock<TLock>> {
+			static_assert(std::is_trivially_copyable_v<TValue>, "TSeqLockSafeData requires a trivially copyable value type.");
+			TValue m_value{};
+
+			TSeqLockSafeData() = default;
+			explicit TSeqLockSafeData(const TValue& _value) : m_value(_value) {}
+
+			//Verinin tutarli bir kopyasini kilit almadan dondurur.
+			TValue Snapshot() const noexcept {
+				const auto& lock = this->m_inlineLock;
+
+				//Yazma kilidini biz tutuyorsak versiyon tek kalir, dogrudan kopyala.
+				if (CInlineLockAcquirer::IsHeldByThisThread(lock)) return m_value;
+
+				TValue copy;
+				uint32_t version = 0;
+				do {
+					version = lock.ReadBegin();
+					//Bilerek yarisli kopya: versiyon kontrolu tutarsiz kopyalari eler.
+					std::memcpy(static_cast<void*>(&copy), static_cast<const void*>(&m_value), sizeof(TValue));
+				} while (lock.ReadRetry(version));
+				return copy;
+			}
+		};
+	};
+};
@@ -0,0 +1,247 @@
+#pragma once
+#include "cpu_affinity.h"
+
+#include <singleton.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/*
+Kutuphane ici gorev calistirici (dis Singletons/future.h bagimliligi yerine).
+Gorevler isimle degil tutamac (TTaskHandle) ile tanimlanir; gonderimde string olusturulmaz.
+
+Post  : kisa gorevler sabit boyutlu havuzda calisir (or. bekleyen operasyonlar). Tutamac ve gorev basina durum yoktur.
+Spawn : uzun omurlu donguler (kuyruk worker'lari, temizleyici) kendi thread'inde calisir, havuzu tikamaz.
+
+Her gorev bir CStopToken alir; eski bForce bayragi gibi kullanilir:
+	auto handle = executorInstance.Spawn([](const CStopToken& bForce) {
+		while (!bForce) { ... bForce.WaitFor(std::chrono::seconds(1)); }
+	});
+	executorInstance.RequestStop(handle);
+	executorInstance.Join(handle);
+*/
+namespace NThreadSafe {
+	static constexpr uint32_t EXECUTOR_MIN_THREAD_COUNT = 2;
+	static constexpr uint32_t EXECUTOR_MAX_THREAD_COUNT = 16;
+
+	struct TStopState {
+		std::atomic<bool> m_bStop{ false };
+		std::mutex m_mutex{};
+		std::condition_variable m_cv{};
+
+		void Request() {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_bStop.store(true, std::memory_order_release);
+			}
+			m_cv.notify_all();
+		}
+	};
+
+	//Isbirlikci durdurma: gorev belirli araliklarla kontrol eder ve kendisi cikar.
+	class CStopToken {
+	private:
+		std::shared_ptr<TStopState> m_state{};
+	public:
+		CStopToken() = default;
+		explicit CStopToken(std::shared_ptr<TStopState> _state) : m_state(std::move(_state)) {}
+
+		bool IsStopRequested() const noexcept {
+			return m_state && m_state->m_bStop.load(std::memory_order_acquire);
+		}
+
+		//while (!bForce) kullanimi icin: durdurma istendiyse true.
+		explicit operator bool() const noexcept {
+			return IsStopRequested();
+		}
+
+		//En fazla _duration kadar uyur, durdurma istenirse hemen uyanir. Durdurma istendiyse true doner.
+		template<typename TRep, typename TPeriod>
+		bool WaitFor(std::chrono::duration<TRep, TPeriod> _duration) const {
+			if (!m_state) {
+				std::this_thread::sleep_for(_duration);
+				return false;
+			}
+			std::unique_lock<std::mutex> lock(m_state->m_mutex);
+			return m_state->m_cv.wait_for(lock, _duration, [this]() { return m_state->m_bStop.load(std::memory_order_acquire); });
+		}
+	};
+
+	struct TTaskHandle {
+		uint64_t m_id = 0;
+
+		bool IsValid() const noexcept {
+			return m_id != 0;
+		}
+	};
+
+	using TTaskFunc = std::function<void(const CStopToken&)>;
+
+	class CTaskExecutor : public CSingleton<CTaskExecutor> {
+	private:
+		struct TSpawned {
+			std::shared_ptr<TStopState> m_stop;
+			std::thread m_thread;
+		};
+
+		//Havuz
+		std::vector<std::thread> m_workers{};
+		std::deque<TTaskFunc> m_tasks{};
+		std::mutex m_taskMutex{};
+		std::condition_variable m_taskCv{};
+		std::shared_ptr<TStopState> m_stop = std::make_shared<TStopState>(); // havuz gorevlerinin ortak token'i
+		CStopToken m_poolToken{ m_stop };
+
+		//Ayri thread'li gorevler
+		std::unordered_map<uint64_t, TSpawned> m_spawned{};
+		std::mutex m_spawnMutex{};
+		std::atomic<uint64_t> m_nextID{ 1 };
+	private:
+		void WorkerLoop() {
+			for (;;) {
+				TTaskFunc task{};
+				{
+					std::unique_lock<std::mutex> lock(m_taskMutex);
+					m_taskCv.wait(lock, [this]() { return !m_tasks.empty() || m_stop->m_bStop.load(std::memory_order_acquire); });
+					if (m_tasks.empty()) return; // durduruldu ve bekleyen is kalmadi
+					task = std::move(m_tasks.front());
+					m_tasks.pop_front();
+				}
+
+				//Kapanista bekleyen gorevler yine calistirilir; token durdurulmus gorur ve erken cikabilir.
+				try {
+					task(m_poolToken);
+				}
+				catch (...) {}
+			}
+		}
+
+		static void JoinOrDetach(std::thread& _thread) {
+			if (!_thread.joinable()) return;
+			if (_thread.get_id() == std::this_thread::get_id()) {
+				_thread.detach(); // gorev kendini bekleyemez
+				return;
+			}
+			_thread.join();
+		}
+	public:
+		CTaskExecutor() {
+			const uint32_t threadCount = std::clamp<uint32_t>(std::thread::hardware_concurrency(), EXECUTOR_MIN_THREAD_COUNT, EXECUTOR_MAX_THREAD_COUNT);
+			m_workers.reserve(threadCount);
+			for (uint32_t i = 0; i < threadCount; ++i) {
+				m_workers.emplace_back([this]() { WorkerLoop(); });
+			}
+		}
+
+		~CTaskExecutor() {
+			Shutdown();
+		}
+
+		//Havuzda calistirir. Kapanis basladiysa gorev kabul edilmez, false doner.
+		bool Post(TTaskFunc _task) {
+			{
+				std::lock_guard<std::mutex> lock(m_taskMutex);
+				if (m_stop->m_bStop.load(std::memory_order_relaxed)) return false;
+				m_tasks.push_back(std::move(_task));
+			}
+			m_taskCv.notify_one();
+			return true;
+		}
+
+		//Havuz thread'lerini _cpus'a sabitler (or. bir NUMA dugumunun CPU'lari). Sabitlenemezse false.
+		bool SetPoolAffinity(const TCpuSet& _cpus) {
+			std::lock_guard<std::mutex> lock(m_taskMutex);
+			bool bPinned = !m_workers.empty();
+			for (auto& worker : m_workers) {
+				bPinned = CCpuTopology::PinThread(worker.native_handle(), _cpus) && bPinned;
+			}
+			return bPinned;
+		}
+
+		//Gorevi kendi thread'inde baslatir. Bitince Join ile toplanmalidir, aksi halde Shutdown'da toplanir.
+		//_affinity bos degilse thread gorev baslamadan o CPU'lara sabitlenir.
+		TTaskHandle Spawn(TTaskFunc _task, TCpuSet _affinity = {}) {
+			const TTaskHandle handle{ m_nextID.fetch_add(1, std::memory_order_relaxed) };
+			auto stop = std::make_shared<TStopState>();
+
+			std::lock_guard<std::mutex> lock(m_spawnMutex);
+			if (m_stop->m_bStop.load(std::memory_order_relaxed)) return {};
+			TSpawned& spawned = m_spawned[handle.m_id];
+			spawned.m_stop = stop;
+			try {
+				spawned.m_thread = std::thread([task = std::move(_task), token = CStopToken(std::move(stop)), affinity = std::move(_affinity)]() {
+					if (!affinity.empty()) CCpuTopology::PinCurrentThread(affinity);
+					try {
+						task(token);
+					}
+					catch (...) {}
+				});
+			}
+			catch (...) {
+				m_spawned.erase(handle.m_id);
+				throw;
+			}
+			return handle;
+		}
+
+		void RequestStop(TTaskHandle _handle) {
+			std::shared_ptr<TStopState> stop{};
+			{
+				std::lock_guard<std::mutex> lock(m_spawnMutex);
+				auto found = m_spawned.find(_handle.m_id);
+				if (found == m_spawned.end()) return;
+				stop = found->second.m_stop;
+			}
+			stop->Request();
+		}
+
+		//Gorevin bitmesini bekler (durdurma istemez). Gorev kendi tutamacini beklerse thread detach edilir.
+		void Join(TTaskHandle _handle) {
+			std::thread thread{};
+			{
+				std::lock_guard<std::mutex> lock(m_spawnMutex);
+				auto found = m_spawned.find(_handle.m_id);
+				if (found == m_spawned.end()) return;
+				thread = std::move(found->second.m_thread);
+				m_spawned.erase(found);
+			}
+			JoinOrDetach(thread);
+		}
+
+		void StopAndJoin(TTaskHandle _handle) {
+			RequestStop(_handle);
+			Join(_handle);
+		}
+
+		//Tum gorevlere durdurma ister, havuzdaki bekleyen isleri bitirir ve tum thread'leri toplar.
+		//CSingletonManager::destroyAll ile de cagrilir.
+		void Shutdown() {
+			std::unordered_map<uint64_t, TSpawned> spawned{};
+			std::vector<std::thread> workers{};
+			{
+				std::lock_guard<std::mutex> lock(m_spawnMutex);
+				std::lock_guard<std::mutex> taskLock(m_taskMutex);
+				m_stop->m_bStop.store(true, std::memory_order_release);
+				spawned.swap(m_spawned);
+				workers.swap(m_workers);
+			}
+			m_stop->Request();
+			m_taskCv.notify_all();
+
+			for (auto& [id, task] : spawned) task.m_stop->Request();
+			for (auto& [id, task] : spawned) JoinOrDetach(task.m_thread);
+			for (auto& worker : workers) JoinOrDetach(worker);
+		}
+	};
+#define executorInstance NThreadSafe::CTaskExecutor::getInstance()
+};
@@ -1,9 +1,18 @@
 #pragma once
 
-#include <Singletons/future.h>
 #include "interfaces.h"
 #include "common_types.h"
 #include "lock_types.h"
+#include "lock_record_table.h"
+#include "inline_lock.h"
+#include "lock_profiler.h"
+#include "lock_watchdog.h"
+#include "deadlock_detector.h"
+#include "diagnostics.h"
+#include "data_wrapper.h"
+#include "coroutine_acquire.h"
+#include "read_batch.h"
+#include "lock_elision.h"
 
 #include <memory>
 #include <type_traits>
@@ -13,33 +22,43 @@
 #include <vector>
 #include <atomic>
 #include <mutex>
-#include <sstream>
+#include <future>
+#include <string>
 
 //Data'yi her halukarda asenkron programlama shared_ptr icerisinde tutmak cok onemlidir cunku ayni anda birden fazla thread veri invalid edilirken kullaniyor olabilir.
 //En azindan kullanimlari bitene kadar veri, programda yasamalidir.
 namespace NThreadSafe {
 	namespace NLock{
-		template<typename TData, typename std::enable_if<std::is_same_v<TData, std::shared_ptr<typename TData::element_type>>, int>::type = 0>
-		class CNewThreadTracker : public INewThreadTracker, public std::enable_shared_from_this<CNewThreadTracker<TData>>{
+		//TDiagPolicy: tanilama seviyesi (bkz. diagnostics.h), kapali seviyeler derlemede silinir.
+		template<typename TData, typename TDiagPolicy = TDefaultDiag, typename std::enable_if<std::is_same_v<TData, std::shared_ptr<typename TData::element_type>>, int>::type = 0>
+		class CNewThreadTracker : public INewThreadTracker, public std::enable_shared_from_this<CNewThreadTracker<TData, TDiagPolicy>>{
 		public:
+			using TWrapper = CDataWrapper<TData, TDiagPolicy>; // tanilama politikasi tracker'inki
+
 			~CNewThreadTracker() override = default;
 		private:
+			using TLockDataPtr = std::shared_ptr<TLockData<TData>>;
+			using TDiag = CDiagnostics<TDiagPolicy>;
+			using TInlineAcquirer = TInlineLockAcquirer<TDiagPolicy>;
+
 			std::mutex m_mutexData;
-			std::unordered_map<uintptr_t/*mutexID*/, std::shared_ptr<TLockData<TData>>> m_mutexes;
+			//ISafeData tipleri icin id ile dogrudan indekslenen tablo, digerleri icin hash map.
+			TLockRecordStore<typename TData::element_type, TLockDataPtr> m_mutexes;
+			CLockWatchdog m_watchdog{};
 		
 			std::mutex m_mutexHelds;
-			std::unordered_map<TID/*threadID*/, std::vector<uintptr_t>/*kilitledigi mutexId vectoru*/> m_heldLocks; // Bu yapi ile her zaman kucukten buyuge lock alinmasi saglanir.
+			std::unordered_map<TID/*threadID*/, std::vector<TLockID>/*kilitledigi mutexId vectoru*/> m_heldLocks; // Bu yapi ile her zaman kucukten buyuge lock alinmasi saglanir.
 
 			//IMPORTANT: Bu sinifta once mmutexData sonra mutexHelds mutex'leri kilitlenmistir.
 		private:
-			void AddToHeldLocks(uintptr_t _mutexID) noexcept {
+			void AddToHeldLocks(TLockID _mutexID) noexcept {
 				if (_mutexID == 0) return;
 				const TID& threadID = std::this_thread::get_id();
 				std::lock_guard<std::mutex> mute(m_mutexHelds);
 				auto found = m_heldLocks.find(threadID);
 				if (found == m_heldLocks.end()) {
 					// Yeni bir eleman ekleyelim
-					auto [iter, success] = m_heldLocks.emplace(threadID, std::vector<uintptr_t>());
+					auto [iter, success] = m_heldLocks.emplace(threadID, std::vector<TLockID>());
 					if (success) {
 						iter->second.push_back(_mutexID);
 					}
@@ -52,7 +71,7 @@ namespace NThreadSafe {
 					}
 				}
 			}
-			void RemoveFromHeldLocks(uintptr_t _mutexID) noexcept override {
+			void RemoveFromHeldLocks(TLockID _mutexID) noexcept override {
 				if (_mutexID == 0) return;
 				const TID& threadID = std::this_thread::get_id();
 				std::lock_guard<std::mutex> mute(m_mutexHelds);
@@ -76,22 +95,76 @@ namespace NThreadSafe {
 					vec.pop_back();
 				}
 			}
-			void RemoveFromMutexes(uintptr_t _mutexID) noexcept override {
-				std::lock_guard<std::mutex> muteData(m_mutexData);
-				auto found = m_mutexes.find(_mutexID);
+			//Toplu okuma icin: kayitlar tekil ve mutexID sirasinda oldugundan sadece thread'in onceden tuttuklariyla, siralanip birlestirilerek karsilastirilir.
+			void AddToHeldLocks(const std::vector<TData>& _records) noexcept {
+				if (_records.empty()) return;
+				const TID& threadID = std::this_thread::get_id();
+				std::lock_guard<std::mutex> mute(m_mutexHelds);
+				try {
+					auto& vec = m_heldLocks[threadID];
+					std::vector<TLockID> before(vec.begin(), vec.end());
+					std::sort(before.begin(), before.end());
+					vec.reserve(vec.size() + _records.size());
+					auto prev = before.begin();
+					for (const TData& data : _records) {
+						prev = std::lower_bound(prev, before.end(), data->m_mutexID);
+						if (prev != before.end() && *prev == data->m_mutexID) continue;
+						vec.push_back(data->m_mutexID);
+					}
+				}
+				catch (...) {
+#ifdef LOG_THREAD_SAFE
+					LOG_ERR(LogClass::NORMAL, "Failed to add read batch to held locks.");
+#endif
+				}
+			}
 
-				if (found == m_mutexes.end()) {
+			//_mutexIDs sirali olmalidir; thread kaydi tek seferde taranir.
+			//Batch ayni sirayla eklendiginden kayitlar cogunlukla _mutexIDs'in siradaki elemanidir, ikili arama sadece sira disi kayitlar icin yapilir.
+			void RemoveFromHeldLocks(const std::vector<TLockID>& _mutexIDs) noexcept {
+				if (_mutexIDs.empty()) return;
+				const TID& threadID = std::this_thread::get_id();
+				std::lock_guard<std::mutex> mute(m_mutexHelds);
+				auto found = m_heldLocks.find(threadID);
+				if (found == m_heldLocks.end()) return;
+
+				auto& vec = found->second;
+				auto next = _mutexIDs.begin();
+				vec.erase(std::remove_if(vec.begin(), vec.end(), [&_mutexIDs, &next](TLockID mID) {
+					if (next != _mutexIDs.end() && *next == mID) {
+						++next;
+						return true;
+					}
+					return std::binary_search(_mutexIDs.begin(), _mutexIDs.end(), mID);
+				}), vec.end());
+			}
+
+			//Kayit sahipsizse tablodan cikarilir ve guard'i hemen kaldirilir: mutex, kaydin son kopyasi yok edilene kadar
+			//kilitli kalmaz. Bu arada kilidi alan olduysa kayit silinmez.
+			void RemoveFromMutexes(TLockID _mutexID) noexcept override {
+				std::shared_ptr<ILock> iLock = nullptr;
+				{
+					std::lock_guard<std::mutex> muteData(m_mutexData);
+					TLockDataPtr* found = m_mutexes.Find(_mutexID);
+					if (!found) {
 #ifdef LOG_THREAD_SAFE
-					LOG_TRACE(LogClass::NORMAL, "Lock doesn't exist to release: mutexID(?).", _mutexID);
+						LOG_TRACE(LogClass::NORMAL, "Lock doesn't exist to release: mutexID(?).", _mutexID);
 #endif
-					return;
+						return;
+					}
+					iLock = (*found)->GetILock();
+					if (!iLock) {
+						m_mutexes.Erase(_mutexID);
+						return;
+					}
+					if (!UnpublishIfUnowned(*iLock)) return;
 				}
-				m_mutexes.erase(_mutexID);
+				iLock->RemoveGuard(); //tablo kilidi disinda: guard kaldirilirken bekleyenler uyanir.
 			}
 		private:
 			//Kilitler, her thread icin kucukten buyuge dogru -mutexId bazinda- alinmalidir.
 			//Thread'in tum mutex'leri serbest birakip dogru sirada almaya ihtiyaci var mi?
-			bool NeedToReset(uintptr_t _mutexID) noexcept override {
+			bool NeedToReset(TLockID _mutexID) noexcept override {
 				if (_mutexID == 0) return false;
 				const TID& threadID = std::this_thread::get_id();
 				std::lock_guard<std::mutex> mute(m_mutexHelds);
@@ -109,7 +182,7 @@ namespace NThreadSafe {
 			void ReorderAll() noexcept override {
 				const TID& threadID = std::this_thread::get_id();
 				//HeldIter'de olup global mutexData'da olmayanlari secer.
-				std::vector<uintptr_t> v_garbage{}; //Normalde bu vector daima bos olmalidir ama test icin deneyelim.
+				std::vector<TLockID> v_garbage{}; //Normalde bu vector daima bos olmalidir ama test icin deneyelim.
 
 				std::lock_guard<std::mutex> muteData(m_mutexData);
 				std::lock_guard<std::mutex> muteHeld(m_mutexHelds);
@@ -117,11 +190,11 @@ namespace NThreadSafe {
 				//m_heldLocks 'un bu thread_id'ye sahip oldugundan emin oldugu icin tekrar kontrol etmeye gerek yok.
 
 				//Sadece guard'lari resetleyelim, sayaclar korunsun.
-				for (const uintptr_t& mID/*MutexID*/ : heldIter->second) {
-					auto iter1 = m_mutexes.find(mID);
+				for (const TLockID& mID/*MutexID*/ : heldIter->second) {
+					TLockDataPtr* iter1 = m_mutexes.Find(mID);
 
 					//ilginc bir sekilde bu veri m_mutexes icerisinde yok yani bizim heldlocks'umuz gecersiz bir mutex'e sahip: temizligi dogru yapilmiyor.
-					if (iter1 == m_mutexes.end()) {
+					if (!iter1) {
 						v_garbage.push_back(mID);
 #ifdef LOG_THREAD_SAFE
 						LOG_TRACE(LogClass::NORMAL, "MutexID(?) is garbage.", mID);
@@ -130,7 +203,7 @@ namespace NThreadSafe {
 					}
 
 
-					if (!iter1->second.get()) {
+					if (!iter1->get()) {
 #ifdef LOG_THREAD_SAFE
 						LOG_TRACE(LogClass::NORMAL, "MutexDataPtr(id:?) is null.", mID);
 #endif
@@ -138,7 +211,7 @@ namespace NThreadSafe {
 					}
 
 					//mutex data
-					auto iLock = iter1->second->GetILock();
+					auto iLock = (*iter1)->GetILock();
 					if (!iLock) {
 #ifdef LOG_THREAD_SAFE
 						LOG_TRACE(LogClass::NORMAL, "Mutex data is not exist in uniqueptr wtf. Line:?", __LINE__);
@@ -171,16 +244,16 @@ namespace NThreadSafe {
 
 
 				//guard'i silinene her mutex'lere ait verileri tekrar ve dogru sirada olusturalim.
-				for (const uintptr_t& mID/*MutexID*/ : heldIter->second) {
+				for (const TLockID& mID/*MutexID*/ : heldIter->second) {
 					//Artik copler olmadigi icin m_mutexes icerisindeki varligini kontrol etmiyorum.
-					auto iter2 = m_mutexes.find(mID);
-					if (!iter2->second.get()) {
+					TLockDataPtr* iter2 = m_mutexes.Find(mID);
+					if (!iter2 || !iter2->get()) {
 #ifdef LOG_THREAD_SAFE
 						LOG_TRACE(LogClass::NORMAL, "MutexDataPtr(id:?) is null.", mID);
 #endif
 						continue;
 					}
-					auto iLock = iter2->second->GetILock();
+					auto iLock = (*iter2)->GetILock();
 					if (!iLock) {
 #if defined(LOG_THREAD_SAFE)
 						LOG_TRACE(LogClass::NORMAL, "Mutex data is not exist in uniqueptr wtf. Line:?", __LINE__);
@@ -192,33 +265,91 @@ namespace NThreadSafe {
 				}
 			}
 
-			std::shared_ptr<ILock> GetLockData(uintptr_t _mutexID) noexcept {
-				if (_mutexID == 0) return nullptr;
-				std::lock_guard<std::mutex> muteData(m_mutexData);
-				auto found = m_mutexes.find(_mutexID);
-				if (found == m_mutexes.end()) return nullptr;
+			//m_mutexData altinda cagrilir. Kayit kilidi alindiktan sonra yayinlanir: kilitsiz okuyan thread'ler guard'i
+			//olmayan yeni kaydi gorup kilidi kayit sahibiyle ayni anda almaya calismaz.
+			TLockDataPtr* PublishAcquired(TLockID _mutexID, TLockDataPtr _data, ELockType _requestType) noexcept {
+				if (m_mutexes.Find(_mutexID)) return nullptr; //zaten kayitli
+				std::shared_ptr<ILock> iLock = _data->GetILock();
+				iLock->AcquireLock(_requestType);
+				TLockDataPtr* iter = m_mutexes.TryEmplace(_mutexID, std::move(_data));
+				if (!iter) {
+					iLock->RemoveOwnership();
+					iLock->RemoveGuard();
+				}
+				return iter;
+			}
 
-				auto secondPtr = found->second.get();
-				if (!secondPtr) return nullptr;
-				return secondPtr->GetILock();
+			//m_mutexData altinda cagrilir.
+			bool UnpublishIfUnowned(ILock& _iLock) noexcept {
+				const TLockID mutexID = _iLock.GetMutexID();
+				return _iLock.RemoveIfUnowned([this, mutexID]() { m_mutexes.Erase(mutexID); });
+			}
+
+			//Yayinlanmis kaydi dondurur. ISafeData kayitlari (tablo) kilitsiz okunur; m_mutexData sadece kayit ekleme/silme
+			//ve birden fazla kaydi birlikte degistiren yollar icindir. Hash map (dense id'siz tipler) aramada da kilit ister.
+			TLockDataPtr LoadRecord(TLockID _mutexID) noexcept {
+				if constexpr (decltype(m_mutexes)::LOCK_FREE_READ) {
+					return m_mutexes.Load(_mutexID);
+				}
+				else {
+					std::lock_guard<std::mutex> muteData(m_mutexData);
+					TLockDataPtr* found = m_mutexes.Find(_mutexID);
+					return found ? *found : nullptr;
+				}
+			}
+
+			std::shared_ptr<ILock> GetLockData(TLockID _mutexID) noexcept {
+				if (_mutexID == 0) return nullptr;
+				TLockDataPtr found = LoadRecord(_mutexID);
+				if (!found) return nullptr;
+				return found->GetILock();
 			}
 
 		public:
-			std::shared_ptr<TLockData<TData>> GetMutexData(uintptr_t _mutexID) noexcept {
+			std::shared_ptr<TLockData<TData>> GetMutexData(TLockID _mutexID) noexcept {
 				if (_mutexID == 0) return nullptr;
-				std::lock_guard<std::mutex> muteData(m_mutexData);
-				auto found = m_mutexes.find(_mutexID);
-				if (found == m_mutexes.end()) return nullptr;
+				return LoadRecord(_mutexID);
+			}
+		public:
+			//Cekisme profili (bkz. lock_profiler.h). Kilit id'leri process genelinde oldugu icin tum tracker'lari kapsar.
+			std::vector<TLockProfileEntry> GetHotRecords(size_t _count) const {
+				return profilerInstance.GetTopRecords(_count);
+			}
+
+			std::string DumpProfile(size_t _count = SIZE_MAX) const {
+				return profilerInstance.DumpJson(_count);
+			}
+
+			//Uzun tutulan kilitler icin bekci thread'i baslatir (bkz. lock_watchdog.h). Callback bekci thread'inde cagrilir, bos ise loglanir.
+			//Zaten calisiyorsa false doner. Tracker yok edilirken bekci durdurulur.
+			bool StartWatchdog(const TWatchdogConfig& _config = {}, TWatchdogCallback _callback = nullptr) {
+				return m_watchdog.Start(_config, std::move(_callback));
+			}
 
-				return found->second;
+			void StopWatchdog() {
+				m_watchdog.Stop();
+			}
+
+			bool IsWatchdogRunning() const noexcept {
+				return m_watchdog.IsRunning();
+			}
+
+			//Bekleme yolunda wait-for graph ile deadlock tespiti (bkz. deadlock_detector.h). Process geneli, tum tracker'lari kapsar.
+			//Fail modunda donguyu kapatan istek EWrapperResult::DEADLOCK ile doner.
+			void EnableDeadlockDetection(EDeadlockAction _action = EDeadlockAction::Report, TDeadlockCallback _callback = nullptr) {
+				deadlockDetectorInstance.Enable(_action, std::move(_callback));
+			}
+
+			void DisableDeadlockDetection() {
+				deadlockDetectorInstance.Disable();
 			}
 		public://test
 			void PrintAll() override {
 #ifdef LOG_THREAD_SAFE
+				profilerInstance.PrintTop(10);
 				{
 					std::lock_guard<std::mutex> muteData(m_mutexData);
-					for (auto& [mutexID, lockData] : m_mutexes) {
-						if (!lockData) continue;
+					m_mutexes.ForEach([](TLockID mutexID, TLockDataPtr& lockData) {
 						LOG_INFO(LogClass::NORMAL, "=========================== PRINTING MUTEX DATA FOR MUTEX_ID: ? ===========================", mutexID);
 						LOG_INFO(LogClass::NORMAL, "Operation count: ?", lockData->GetOperationCount());
 						if (std::shared_ptr<ILock> iLock = lockData->GetILock()) {
@@ -246,7 +377,7 @@ namespace NThreadSafe {
 							}
 						}
 						LOG_INFO(LogClass::NORMAL, "=========================== END OF PRINT ===========================");
-					}
+					});
 				}
 
 				{
@@ -263,12 +394,12 @@ namespace NThreadSafe {
 			}
 		private:
 			//ilk kez olusturulan mutex'leri kaydeder.
-			bool RegisterMutex(std::shared_mutex& _mutex, uintptr_t _mutexID, ELockType _requestType) noexcept {
+			bool RegisterMutex(std::shared_mutex& _mutex, TLockID _mutexID, ELockType _requestType) noexcept {
 				if (_mutexID == 0) return false;
 				if (_requestType == ELockType::Read) {
 					std::lock_guard<std::mutex> muteData(m_mutexData);
-					auto [iter, success] = m_mutexes.try_emplace(_mutexID, std::make_shared<TLockData<TData>>(std::make_shared<CReadLock>(_mutexID, _mutex)));
-					if (!success) {
+					TLockDataPtr* iter = PublishAcquired(_mutexID, std::make_shared<TLockData<TData>>(std::make_shared<CReadLock>(_mutexID, _mutex)), _requestType);
+					if (!iter) {
 #ifdef LOG_THREAD_SAFE
 						LOG_TRACE(LogClass::NORMAL, "Failed to register new mutex(?). Line:?", _mutexID, __LINE__);
 #endif
@@ -276,13 +407,12 @@ namespace NThreadSafe {
 
 					}
 					AddToHeldLocks(_mutexID);
-					iter->second->GetILock()->AcquireLock(_requestType);
 				}
 				else if (_requestType == ELockType::Write) {
 					std::lock_guard<std::mutex> muteData(m_mutexData);
-					auto [iter, success] = m_mutexes.try_emplace(_mutexID, std::make_shared<TLockData<TData>>(std::make_shared<CWriteLock>(_mutexID, _mutex)));
+					TLockDataPtr* iter = PublishAcquired(_mutexID, std::make_shared<TLockData<TData>>(std::make_shared<CWriteLock>(_mutexID, _mutex)), _requestType);
 
-					if (!success) {
+					if (!iter) {
 #ifdef LOG_THREAD_SAFE
 						LOG_TRACE(LogClass::NORMAL, "An error occured while adding mutex. Line:?", __LINE__);
 #endif
@@ -290,7 +420,6 @@ namespace NThreadSafe {
 					}
 
 					AddToHeldLocks(_mutexID);
-					iter->second->GetILock()->AcquireLock(_requestType);
 				}
 				else {
 #ifdef LOG_THREAD_SAFE
@@ -303,6 +432,8 @@ namespace NThreadSafe {
 				//write olmayan kilitler icin yeniden duzenleme sistemine gerek yok.
 				if (_requestType == ELockType::Write && NeedToReset(_mutexID)) {
 					//Bu thread'e ait tum locklari yeniden duzenle.
+					profilerInstance.RecordReorder(_mutexID);
+					TDiag::Event(ELockEvent::Reorder, _mutexID, _requestType);
 					ReorderAll();
 				}
 
@@ -311,7 +442,7 @@ namespace NThreadSafe {
 		public:
 		// ikinci deger false ise hic denemeye gerek yok.
 			std::pair<std::shared_ptr<ILock>, bool> 
-			TryAcquireLock(std::shared_mutex& _mutex, uintptr_t _mutexID, ELockType _requestType) noexcept override {
+			TryAcquireLock(std::shared_mutex& _mutex, TLockID _mutexID, ELockType _requestType) noexcept override {
 				if (_mutexID == 0) return { nullptr, false };
 				const TID& threadID = std::this_thread::get_id();
 
@@ -332,6 +463,8 @@ namespace NThreadSafe {
 					return { mData, true };
 				}
 				case EAcquireResult::NEED_TO_CONVERT: {
+					profilerInstance.RecordConversion(_mutexID);
+					TDiag::Event(ELockEvent::Convert, _mutexID, ELockType::Write);
 					ReleaseLock(_mutexID); //Varolan dataya ait mutex'i serbest birak.
 					return { nullptr , RegisterMutex(_mutex, _mutexID, ELockType::Write) }; //yeniden kaydet.
 				}
@@ -343,18 +476,27 @@ namespace NThreadSafe {
 				AddToHeldLocks(_mutexID);
 				mData->AcquireLock(_requestType);
 
+				//Kayit okunduktan sonra son sahibi tarafindan silindiyse sahiplik eklenmemistir: alinan guard birakilip yeni kayitla denenir.
+				if (mData->IsRemoved()) {
+					mData->RemoveGuard();
+					RemoveFromHeldLocks(_mutexID);
+					return TryAcquireLock(_mutex, _mutexID, _requestType);
+				}
+
 				if (_requestType != ELockType::Write) return { nullptr , true }; // kilit alindi ve write olmayan kilitler icin yeniden duzenleme sistemine gerek yok.
 
 				if (!NeedToReset(_mutexID)) return { nullptr , true }; // siralamaya gerek yok ve kilit alindi.
 
 				//Bu thread'e ait tum locklari yeniden duzenle.
+				profilerInstance.RecordReorder(_mutexID);
+				TDiag::Event(ELockEvent::Reorder, _mutexID, _requestType);
 				ReorderAll();
 
 				//Siralama islemleri bitti ve kilit alindi.
 				return { nullptr , true };
 			}
 
-			void ReleaseLock(uintptr_t _mutexID, bool bOperationCall = false) noexcept {
+			void ReleaseLock(TLockID _mutexID, bool bOperationCall = false) noexcept {
 				if (_mutexID == 0) return;
 
 				if (bOperationCall) {
@@ -363,22 +505,14 @@ namespace NThreadSafe {
 					return;
 				}
 
-				std::shared_ptr<TLockData<TData>> mutexData = nullptr;
-
-				{
-					std::lock_guard<std::mutex> muteData(m_mutexData);
-					auto found = m_mutexes.find(_mutexID);
-					if (found == m_mutexes.end()) {
+				std::shared_ptr<TLockData<TData>> mutexData = LoadRecord(_mutexID);
+				if (!mutexData) {
 #ifdef LOG_THREAD_SAFE
-						LOG_TRACE(LogClass::NORMAL, "mutexData of mutexID(?) is doesn't exists.", _mutexID);
+					LOG_TRACE(LogClass::NORMAL, "mutexData of mutexID(?) is doesn't exists.", _mutexID);
 #endif
-						return;
-					}
-					mutexData = found->second;
+					return;
 				}
 
-				if (!mutexData) return;
-
 				std::shared_ptr<ILock> iLock = mutexData->GetILock();
 				if (!iLock) {
 #ifdef LOG_THREAD_SAFE
@@ -393,88 +527,402 @@ namespace NThreadSafe {
 				if (bShouldRemove) {
 					//Bekleyen operasyon varsa
 					if (mutexData->GetOperationCount() > 0) {
-						//Mutex kaldirilacagi icin bekleyen operasyonlari gerceklestir.
-						iLock->AddOwnership();
-						RunOperationsOfMutex(_mutexID);
-						return;
+						if (iLock->GetType() == ELockType::Write) {
+							//Yazma kilidi bu thread'de: std::shared_mutex baska thread'de birakilamaz, operasyonlar burada calisir.
+							mutexData->RunOperations(CStopToken{});
+						}
+						else {
+							//Mutex kaldirilacagi icin bekleyen operasyonlari gerceklestir.
+							HandOverToOperations(*iLock, _mutexID);
+							RemoveFromHeldLocks(_mutexID);
+							return;
+						}
 					}
 					RemoveFromMutexes(_mutexID);
 					RemoveFromHeldLocks(_mutexID); //thread kayitlarindan da sil
 				}
 			}
+
+			//Toplu okuma (bkz. read_batch.h). Bos kayitlar atlanir; kayitlar mutexID'ye gore siralanir ve tekillestirilir.
+			//Kilitler beklenmeden alinir, alinamayanlar batch'in mesgul listesinde doner.
+			CReadBatch<TData, CNewThreadTracker> AcquireReadBatch(std::vector<TData> _records) {
+				_records.erase(std::remove(_records.begin(), _records.end(), nullptr), _records.end());
+				std::sort(_records.begin(), _records.end(), [](const TData& left, const TData& right) { return left->m_mutexID < right->m_mutexID; });
+				_records.erase(std::unique(_records.begin(), _records.end(), [](const TData& left, const TData& right) { return left->m_mutexID == right->m_mutexID; }), _records.end());
+
+				//Kapasite onceden ayrilir: kilitler alinmaya baslandiktan sonra bellek hatasi olusmaz.
+				std::vector<TData> acquired{};
+				std::vector<TData> busy{};
+				acquired.reserve(_records.size());
+				busy.reserve(_records.size());
+				TryAcquireReadBatch(_records, acquired, busy);
+
+				const uint64_t holdStart = acquired.empty() ? 0 : profilerInstance.SampleHoldStart();
+				return CReadBatch<TData, CNewThreadTracker>(this->shared_from_this(), std::move(acquired), std::move(busy), holdStart);
+			}
+
+			//CReadBatch kullanir. Her kayit icin ReleaseLock ile ayni sonucu verir, tablo ve thread kaydi birer kez kilitlenir.
+			void ReleaseReadBatch(const std::vector<TData>& _records, uint64_t _holdStart) noexcept {
+				const size_t count = _records.size();
+				if constexpr (THasInlineLock<typename TData::element_type>::value) {
+					for (size_t i = 0; i < count; ++i) {
+						if (i + BATCH_PREFETCH_DISTANCE < count) THREAD_SAFE_PREFETCH(_records[i + BATCH_PREFETCH_DISTANCE].get());
+						const TData& data = _records[i];
+						TInlineAcquirer::ReleaseDetached(data->m_inlineLock, data->m_mutexID, ELockType::Read);
+						profilerInstance.RecordHold(data->m_mutexID, _holdStart);
+					}
+				}
+				else {
+					std::vector<TLockDataPtr> mutexDatas(count);
+					{
+						std::lock_guard<std::mutex> muteData(m_mutexData);
+						for (size_t i = 0; i < count; ++i) {
+							if (i + BATCH_PREFETCH_DISTANCE < count) m_mutexes.Prefetch(_records[i + BATCH_PREFETCH_DISTANCE]->m_mutexID);
+							if (TLockDataPtr* found = m_mutexes.Find(_records[i]->m_mutexID)) {
+								mutexDatas[i] = *found;
+							}
+						}
+					}
+
+					std::vector<TLockID> removed{};
+					std::vector<TLockID> handedOver{};
+					removed.reserve(count);
+					for (size_t i = 0; i < count; ++i) {
+						if (i + BATCH_PREFETCH_DISTANCE < count) THREAD_SAFE_PREFETCH(mutexDatas[i + BATCH_PREFETCH_DISTANCE].get());
+						const TLockID mutexID = _records[i]->m_mutexID;
+						profilerInstance.RecordHold(mutexID, _holdStart);
+						if (!mutexDatas[i]) continue;
+
+						std::shared_ptr<ILock> iLock = mutexDatas[i]->GetILock();
+						if (!iLock) continue;
+
+						iLock->RemoveOwnership();
+						if (!iLock->ShouldRemove()) continue;
+
+						if (mutexDatas[i]->GetOperationCount() > 0) {
+							HandOverToOperations(*iLock, mutexID);
+							try {
+								handedOver.push_back(mutexID);
+							}
+							catch (...) {
+								RemoveFromHeldLocks(mutexID);
+							}
+							continue;
+						}
+						removed.push_back(mutexID);
+					}
+					RemoveFromHeldLocks(handedOver); //kayitlar mutexID sirasinda oldugu icin siralidir.
+					if (removed.empty()) return;
+
+					std::vector<std::shared_ptr<ILock>> unpublished{};
+					unpublished.reserve(removed.size());
+					{
+						std::lock_guard<std::mutex> muteData(m_mutexData);
+						//Bu arada kilidi alan olduysa kayit silinmez.
+						removed.erase(std::remove_if(removed.begin(), removed.end(), [this, &unpublished](TLockID mID) {
+							TLockDataPtr* found = m_mutexes.Find(mID);
+							if (!found) return true;
+							auto iLock = (*found)->GetILock();
+							if (!iLock) {
+								m_mutexes.Erase(mID);
+								return false;
+							}
+							if (!UnpublishIfUnowned(*iLock)) return true;
+							unpublished.push_back(std::move(iLock));
+							return false;
+						}), removed.end());
+					}
+					for (auto& iLock : unpublished) iLock->RemoveGuard();
+					RemoveFromHeldLocks(removed); //kayitlar mutexID sirasinda oldugu icin removed da siralidir.
+				}
+			}
 		private:
-			void RunOperationsOfMutex(uintptr_t _mutexID) {
-				std::stringstream ss{};
-				ss << "Operations_" << _mutexID;
-				futureInstance.addTask<void>(ss.str(), [self = this->shared_from_this(), _mutexID](std::atomic<bool>& bForce) {
-					auto mutexInfo = self->GetMutexData(_mutexID);
-					if (!mutexInfo) {
-#ifdef LOG_THREAD_SAFE
-						LOG_TRACE(LogClass::NORMAL, "OP: MutexInfo doesn't exists. Line: ?.", __LINE__);
-#endif
-						return;
+			void TryAcquireReadBatch(const std::vector<TData>& _records, std::vector<TData>& _acquired, std::vector<TData>& _busy) noexcept {
+				const size_t count = _records.size();
+				if constexpr (THasInlineLock<typename TData::element_type>::value) {
+					//Thread kaydina eklenmez (detached): kayit basina FindHeld taramasi yapilmaz.
+					for (size_t i = 0; i < count; ++i) {
+						if (i + BATCH_PREFETCH_DISTANCE < count) THREAD_SAFE_PREFETCH(_records[i + BATCH_PREFETCH_DISTANCE].get());
+						const TData& data = _records[i];
+						if (TInlineAcquirer::TryAcquireDetached(data->m_inlineLock, data->m_mutexID, ELockType::Read)) {
+							_acquired.push_back(data);
+							continue;
+						}
+						profilerInstance.RecordBusy(data->m_mutexID);
+						TDiag::Event(ELockEvent::Busy, data->m_mutexID, ELockType::Read);
+						_busy.push_back(data);
 					}
+				}
+				else {
+					//1: tablo bir kez kilitlenir. Yeni kayitlar RegisterMutex gibi olusturulup alinir, var olanlarin kilidi toplanir.
+					//Kayit verisi BATCH_PREFETCH_DISTANCE, tablo slotu (mutexID'si okunacagi icin) bunun yarisi kadar ileriden cekilir.
+					std::vector<std::shared_ptr<ILock>> existing(count);
+					std::vector<uint8_t> registered(count, 0);
+					{
+						std::lock_guard<std::mutex> muteData(m_mutexData);
+						for (size_t i = 0; i < count; ++i) {
+							if (i + BATCH_PREFETCH_DISTANCE < count) THREAD_SAFE_PREFETCH(_records[i + BATCH_PREFETCH_DISTANCE].get());
+							if (i + BATCH_PREFETCH_DISTANCE / 2 < count) m_mutexes.Prefetch(_records[i + BATCH_PREFETCH_DISTANCE / 2]->m_mutexID);
+
+							const TData& data = _records[i];
+							if (TLockDataPtr* found = m_mutexes.Find(data->m_mutexID)) {
+								existing[i] = (*found)->GetILock();
+								continue;
+							}
 
-					auto iLock = mutexInfo->GetILock();
+							TLockDataPtr* iter = PublishAcquired(data->m_mutexID, std::make_shared<TLockData<TData>>(std::make_shared<CReadLock>(data->m_mutexID, data->m_mutex)), ELockType::Read);
+							if (!iter) continue;
+							registered[i] = 1;
+						}
+					}
 
-					if (!iLock) {
-#ifdef LOG_THREAD_SAFE
-						LOG_TRACE(LogClass::NORMAL, "OP: LockData ptr is null. Line: ?.", __LINE__);
-#endif
-						return;
+					//2: var olan kayitlar tablo kilidi disinda, TryAcquireLock gibi alinir. Beklenmez.
+					for (size_t i = 0; i < count; ++i) {
+						if (i + BATCH_PREFETCH_DISTANCE < count && existing[i + BATCH_PREFETCH_DISTANCE]) THREAD_SAFE_PREFETCH(existing[i + BATCH_PREFETCH_DISTANCE].get());
+						const TData& data = _records[i];
+						if (registered[i]) {
+							profilerInstance.RecordAcquire(data->m_mutexID);
+							_acquired.push_back(data);
+							continue;
+						}
+
+						ILock* iLock = existing[i].get();
+						if (iLock && iLock->CanAcquire(ELockType::Read) == EAcquireResult::AVAIL) {
+							iLock->AcquireLock(ELockType::Read);
+							if (!iLock->IsRemoved()) {
+								profilerInstance.RecordAcquire(data->m_mutexID);
+								_acquired.push_back(data);
+								continue;
+							}
+							iLock->RemoveGuard(); //bu arada silinmis, beklenmedigi icin mesgul sayilir.
+						}
+						profilerInstance.RecordBusy(data->m_mutexID);
+						TDiag::Event(ELockEvent::Busy, data->m_mutexID, ELockType::Read);
+						_busy.push_back(data);
 					}
 
+					//3: thread kaydi tek seferde. Okuma kilitleri yeniden siralama gerektirmez.
+					AddToHeldLocks(_acquired);
+				}
+			}
+
+			//Kilidi alir, _func(TElement&)'i calistirir, birakir; wrapper olusturulmaz. SUCCESS disinda _func calismamistir.
+			template<typename TFunc>
+			EWrapperResult RunLocked(const TData& _data, ELockType _requestType, TFunc& _func, bool bWait) {
+				auto& inlineLock = _data->m_inlineLock;
+				EWrapperResult result = TInlineAcquirer::Acquire(inlineLock, _data->m_mutexID, _requestType, bWait);
+				if (result != EWrapperResult::SUCCESS) return result;
+
+				struct TReleaseGuard {
+					decltype(inlineLock)& m_lock;
+					~TReleaseGuard() { TInlineAcquirer::Release(m_lock); }
+				} guard{ inlineLock };
+				_func(*_data);
+				return EWrapperResult::SUCCESS;
+			}
+
+			//With ve TryWith: kilit mesgulse ve bDefer ise _func operasyon olarak eklenir.
+			//Tracker kayitlarinda maliyeti kilit kaydini olusturup silmek belirler, wrapper'siz yolun kazanci yoktur; bu yuzden sadece inline kilitli veriler icin.
+			template<typename TFunc>
+			EApplyResult Apply(const TData& _data, ELockType _requestType, TFunc&& _func, bool bWait, bool bDefer) {
+				static_assert(THasInlineLock<typename TData::element_type>::value, "With/TryWith require inline-locked data (IInlineSafeData); use CDataWrapper for tracker-managed records.");
+				if (!_data || _requestType == ELockType::None) return EApplyResult::DATA_NOT_EXISTS;
+
+				EWrapperResult result = RunLocked(_data, _requestType, _func, bWait);
+				if (result == EWrapperResult::SUCCESS) return EApplyResult::APPLIED;
+				if (result == EWrapperResult::DEADLOCK) return EApplyResult::DEADLOCK; //beklemek deadlock olusturuyorsa operasyon da bekleyemez.
+				if (result != EWrapperResult::BUSY) return EApplyResult::DATA_NOT_EXISTS;
+				if (!bDefer) return EApplyResult::BUSY;
+
+				//Yavas yol: callable operasyon kuyruguna tasinir. Kopyalanamayan callable'lar da tasinabilsin diye shared_ptr icinde tutulur.
+				auto func = std::make_shared<std::decay_t<TFunc>>(std::forward<TFunc>(_func));
+				auto opRes = AddOperationWithData(_data->m_mutexID, [func](TData data) { (*func)(*data); }, _data);
+				if (opRes == EAddOperationResult::ADDED) return EApplyResult::DEFERRED;
+				if (opRes == EAddOperationResult::LOCK_AVAIL) {
+					//Bu arada kilit serbest kaldi, bir kez daha dene.
+					return RunLocked(_data, _requestType, *func, false) == EWrapperResult::SUCCESS ? EApplyResult::APPLIED : EApplyResult::BUSY;
+				}
 #ifdef LOG_THREAD_SAFE
-					size_t opCount = mutexInfo->GetOperationCount();
-					LOG_TRACE(LogClass::NORMAL, "? operations are going to process for mutexID: ?", opCount, _mutexID);
+				LOG_ERR(LogClass::NORMAL, "With: AddOperation failed for mutexID(?).", _data->m_mutexID);
 #endif
-					
-					//auto isWriteLock = dynamic_cast<CWriteLock*>(iLock.get());
-					auto isWriteLock = iLock->GetType() == ELockType::Write;
-					if (!isWriteLock) {
-						iLock->RemoveGuard(); //varolan okuma kilidini kaldir, ayni mutex ile yazma kilidi alacagiz.
-						std::shared_mutex& _mutex = iLock->GetMutex();
-						std::unique_lock<std::shared_mutex> lockMute(_mutex);
+				return EApplyResult::BUSY;
+			}
+
+			//Okuma kilidi birakilirken bekleyen operasyonlar varsa kilit executor gorevine devredilir.
+			//Sahiplik, kayit gorev bitene kadar silinmesin diye korunur; ama bu thread artik kilidi tutmaz:
+			//bekci yayini burada kaldirilir, gorev ReleaseLock(_mutexID, true) ile kaydi tamamen siler.
+			//Executor gorevi kabul etmezse (kapanis) ya da gonderim hata atarsa kilit hala bu thread'dedir, operasyonlar burada calisir.
+			void HandOverToOperations(ILock& _iLock, TLockID _mutexID) noexcept {
+				_iLock.AddOwnership();
+				heldRegistryInstance.Unpublish(_mutexID);
+				bool bPosted = false;
+				try {
+					bPosted = RunOperationsOfMutex(_mutexID);
+				}
+				catch (...) {
 #ifdef LOG_THREAD_SAFE
-						LOG_TRACE(LogClass::NORMAL, "Operations running for mutex:? with convert mutex", _mutexID);
+					LOG_ERR(LogClass::NORMAL, "Operations of mutexID(?) could not be posted.", _mutexID);
 #endif
-						mutexInfo->RunOperations(bForce);
-					}
-					else {
-						//Zaten writelock'a sahip oldugu icin dogrudan operasyonlara gecelim.
+				}
+				if (bPosted) return;
+
+				try {
+					RunHandedOverOperations(_mutexID, CStopToken{});
+				}
+				catch (...) {
 #ifdef LOG_THREAD_SAFE
-						LOG_TRACE(LogClass::NORMAL, "Operations running for mutex:? normally", _mutexID);
+					LOG_ERR(LogClass::NORMAL, "Operations of mutexID(?) could not be run, lock record is dropped.", _mutexID);
 #endif
-						mutexInfo->RunOperations(bForce);
-					}
-					self->ReleaseLock(_mutexID, true);
+					ReleaseLock(_mutexID, true);
+				}
+			}
+
+			bool RunOperationsOfMutex(TLockID _mutexID) {
+				return executorInstance.Post([self = this->shared_from_this(), _mutexID](const CStopToken& bForce) {
+					self->RunHandedOverOperations(_mutexID, bForce);
 				});
 			}
-		public:
-			//Datayi yoneten sinif kullanir.
-			EAddOperationResult AddOperationWithData(uintptr_t _mutexID, std::function<void(TData)>&& _op, TData _data) {
-				std::shared_ptr<TLockData<TData>> mutexData = nullptr;
 
-				{
-					std::lock_guard<std::mutex> muteData(m_mutexData);
-					auto found = m_mutexes.find(_mutexID);
-					if (found == m_mutexes.end())/*eger bulamadiysa o zaman operasyonlar bitmistir. Tekrar kilit almayi dene*/ {
+			//Devredilen kilidin operasyonlarini yazma kilidi altinda calistirir ve kaydi siler.
+			void RunHandedOverOperations(TLockID _mutexID, const CStopToken& bForce) {
+				auto mutexInfo = GetMutexData(_mutexID);
+				if (!mutexInfo) {
 #ifdef LOG_THREAD_SAFE
-						LOG_TRACE(LogClass::NORMAL, "There is no mutexData of mutexID(?): to add operation, so lock is available", _mutexID);
+					LOG_TRACE(LogClass::NORMAL, "OP: MutexInfo doesn't exists. Line: ?.", __LINE__);
 #endif
-						return EAddOperationResult::LOCK_AVAIL;
-					}
-					else {
-						mutexData = found->second;
+					return;
+				}
+
+				auto iLock = mutexInfo->GetILock();
+
+				if (!iLock) {
+#ifdef LOG_THREAD_SAFE
+					LOG_TRACE(LogClass::NORMAL, "OP: LockData ptr is null. Line: ?.", __LINE__);
+#endif
+					return;
+				}
+
+				//auto isWriteLock = dynamic_cast<CWriteLock*>(iLock.get());
+				auto isWriteLock = iLock->GetType() == ELockType::Write;
+				if constexpr (TDiag::EVENTS) {
+					TDiag::Event(ELockEvent::OperationsRun, _mutexID, iLock->GetType(), static_cast<uint32_t>(mutexInfo->GetOperationCount()));
+				}
+				if (!isWriteLock) {
+					iLock->RemoveGuard(); //varolan okuma kilidini kaldir, ayni mutex ile yazma kilidi alacagiz.
+					std::shared_mutex& _mutex = iLock->GetMutex();
+					std::unique_lock<std::shared_mutex> lockMute(_mutex, std::defer_lock);
+					{
+						CWaitScope waitScope(_mutexID, false); //operasyonlar iptal edilemez, sadece raporlanir.
+						lockMute.lock();
 					}
+					mutexInfo->RunOperations(bForce);
 				}
-				if (!mutexData) return EAddOperationResult::FAILED;
+				else {
+					//Zaten writelock'a sahip oldugu icin dogrudan operasyonlara gecelim.
+					mutexInfo->RunOperations(bForce);
+				}
+				ReleaseLock(_mutexID, true);
+			}
+		public:
+			//Datayi yoneten sinif kullanir.
+			EAddOperationResult AddOperationWithData(TLockID _mutexID, std::function<void(TData)>&& _op, TData _data) {
+				if constexpr (THasInlineLock<typename TData::element_type>::value) {
+					//Inline kilitli veriler operasyonlarini kendi icinde tutar, global tabloya ugranmaz.
+					if (!_data) return EAddOperationResult::FAILED;
+					auto& inlineLock = _data->m_inlineLock;
+					TDiag::Event(ELockEvent::OperationAdded, _mutexID);
+					return TInlineAcquirer::AddOperation(inlineLock, _mutexID, [op = std::move(_op), data = std::move(_data)]() { op(data); });
+				}
+
+				std::shared_ptr<TLockData<TData>> mutexData = LoadRecord(_mutexID);
+				if (!mutexData)/*eger bulamadiysa o zaman operasyonlar bitmistir. Tekrar kilit almayi dene*/ {
 #ifdef LOG_THREAD_SAFE
-				LOG_TRACE(LogClass::NORMAL, "Operation addded for mutexID :? ", _mutexID);
+					LOG_TRACE(LogClass::NORMAL, "There is no mutexData of mutexID(?): to add operation, so lock is available", _mutexID);
 #endif
+					return EAddOperationResult::LOCK_AVAIL;
+				}
+				TDiag::Event(ELockEvent::OperationAdded, _mutexID);
 				mutexData->AddOperation(std::move(_op), _data);
 				return EAddOperationResult::ADDED;
 			}
+
+			//Asenkron kilit alma: kilit musaitse _onGranted hemen, degilse kilit sirayla (FIFO) devredildiginde kilidi birakan thread'de cagrilir.
+			//Thread beklemez. Sadece inline kilitli veriler icin kullanilabilir: std::shared_mutex baska thread'e devredilemez.
+			//_onGranted kisa tutulmalidir; uzun isler wrapper ile birlikte baska bir thread'e tasinmalidir.
+			void AcquireAsync(TData _data, ELockType _requestType, std::function<void(TWrapper)>&& _onGranted) {
+				static_assert(THasInlineLock<typename TData::element_type>::value, "AcquireAsync requires an inline-locked data type.");
+				if (!_data || _requestType == ELockType::None) {
+					_onGranted(TWrapper());
+					return;
+				}
+
+				auto& inlineLock = _data->m_inlineLock;
+				if (TInlineAcquirer::TryAcquireDetached(inlineLock, _data->m_mutexID, _requestType)) {
+					_onGranted(TWrapper(ADOPT_LOCK, this->shared_from_this(), std::move(_data), _requestType));
+					return;
+				}
+
+				const TLockID mutexID = _data->m_mutexID;
+				auto onGranted = std::make_shared<std::function<void(TWrapper)>>(std::move(_onGranted));
+				auto opRes = TInlineAcquirer::AddWaiter(inlineLock, mutexID, _requestType,
+					[self = this->shared_from_this(), data = _data, _requestType, onGranted]() {
+						(*onGranted)(TWrapper(ADOPT_LOCK, self, data, _requestType));
+					});
+
+				if (opRes == EAddOperationResult::FAILED) {
+#ifdef LOG_THREAD_SAFE
+					LOG_ERR(LogClass::NORMAL, "AcquireAsync: waiter could not be added for mutexID(?).", mutexID);
+#endif
+					(*onGranted)(TWrapper());
+				}
+			}
+
+			//Kilit alindiginda hazir olan future dondurur. Kilidi tutan thread bu future'i beklememelidir.
+			std::future<TWrapper> AcquireAsync(TData _data, ELockType _requestType) {
+				auto promise = std::make_shared<std::promise<TWrapper>>();
+				auto future = promise->get_future();
+				AcquireAsync(std::move(_data), _requestType, [promise](TWrapper wrapper) {
+					promise->set_value(std::move(wrapper));
+				});
+				return future;
+			}
+
+			//Kisa yazma islemleri icin kilit elizyonu (bkz. lock_elision.h): RTM, tek CAS, en son CDataWrapper ile yazma.
+			//_func(TElement&) kisa olmali ve sadece veriye yazmalidir. Inline kilitli olmayan veriler dogrudan wrapper yolunu kullanir.
+			template<typename TFunc>
+			EWrapperResult WriteElided(const TData& _data, TFunc&& _func) {
+				if (!_data) return EWrapperResult::DATA_NOT_EXISTS;
+				if constexpr (THasInlineLock<typename TData::element_type>::value) {
+					if (CLockElision::TryRun<TDiagPolicy>(*_data, _func) != EElisionPath::None) return EWrapperResult::SUCCESS;
+				}
+
+				TWrapper wrapper(this->shared_from_this(), _data, typename TWrapper::TMutexRef(_data->m_mutex), _data->m_mutexID, ELockType::Write);
+				if (!wrapper) return wrapper.GetResult();
+				_func(*wrapper.get());
+				return EWrapperResult::SUCCESS;
+			}
+
+			//Sadece inline kilitli veriler: kilidi alip _func(TElement&)'i calistirir ve birakir; wrapper, std::function ve thread kaydi disinda ek bellek yoktur.
+			//Kilit beklenir (CDataWrapper gibi: reentrant erisim, donusum, deadlock tespiti). Bekleme zaman asimina ugrarsa ve bDefer ise
+			//_func operasyon olarak eklenir ve kilit musait oldugunda yazma kilidi altinda, baska bir thread'de calisir (DEFERRED).
+			//Ertelenebilecek callable'lar yigindaki degiskenleri referansla yakalamamalidir.
+			template<typename TFunc>
+			EApplyResult With(const TData& _data, ELockType _requestType, TFunc&& _func, bool bDefer = true) {
+				return Apply(_data, _requestType, std::forward<TFunc>(_func), true, bDefer);
+			}
+
+			//With gibi, ama kilit mesgulse beklemez: bDefer ise operasyon olarak ekler, degilse BUSY doner.
+			template<typename TFunc>
+			EApplyResult TryWith(const TData& _data, ELockType _requestType, TFunc&& _func, bool bDefer = true) {
+				return Apply(_data, _requestType, std::forward<TFunc>(_func), false, bDefer);
+			}
+
+#ifdef THREAD_SAFE_HAS_COROUTINES
+			//co_await tracker->Acquire(data, ELockType::Write): kilit musait degilse coroutine askiya alinir (bkz. coroutine_acquire.h).
+			CAcquireAwaitable<TData, TDiagPolicy> Acquire(TData _data, ELockType _requestType, TCoroutineExecutor _executor = nullptr) {
+				return CAcquireAwaitable<TData, TDiagPolicy>(this->shared_from_this(), std::move(_data), _requestType, std::move(_executor));
+			}
+#endif
 		};
 	};
 };
@@ -1,19 +1,166 @@
 #pragma once
 #include <singleton.h>
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include <random>
-#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+Her thread kendi motorunu (thread_local) kullanir: paylasilan durum ve kilit yoktur.
+Motorlar ana tohumdan (master seed) turetilir; set_seed ile ayni tohum ve ayni seed_thread akis numaralari ayni diziyi uretir.
+seed_thread cagirmayan thread'ler ilk kullanimda sirayla akis numarasi alir.
+
+randomInstance.set_seed(42);
+randomInstance.seed_thread(workerIndex); // tekrarlanabilir benchmark icin
+std::vector<int> keys = randomInstance.generate_numbers(1000000, 1, 90);
+*/
 namespace NUtility {
+	//xoshiro256++ (Blackman & Vigna). Kriptografik degildir; mt19937'den hizli ve durumu 32 byte'tir.
+	class CXoshiro256pp {
+	private:
+		uint64_t m_state[4];
+	private:
+		static uint64_t rotl(uint64_t x, int k) noexcept {
+			return (x << k) | (x >> (64 - k));
+		}
+	public:
+		using result_type = uint64_t;
+
+		explicit CXoshiro256pp(uint64_t seed = 0) noexcept {
+			this->seed(seed);
+		}
+
+		//Durum splitmix64 ile doldurulur, boylece hic bir tohum sifir durum uretmez.
+		void seed(uint64_t seed) noexcept {
+			for (auto& word : m_state) {
+				seed += 0x9E3779B97F4A7C15ull;
+				uint64_t z = seed;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+				word = z ^ (z >> 31);
+			}
+		}
+
+		static constexpr result_type min() noexcept { return 0; }
+		static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+		result_type operator()() noexcept {
+			const uint64_t result = rotl(m_state[0] + m_state[3], 23) + m_state[0];
+			const uint64_t t = m_state[1] << 17;
+			m_state[2] ^= m_state[0];
+			m_state[3] ^= m_state[1];
+			m_state[1] ^= m_state[2];
+			m_state[0] ^= m_state[3];
+			m_state[2] ^= t;
+			m_state[3] = rotl(m_state[3], 45);
+			return result;
+		}
+	};
+
+	enum class ERandomEngine : uint8_t {
+		Xoshiro, // varsayilan
+		Mt19937,
+	};
+
 	class CRandomGenerator : public CSingleton<CRandomGenerator> {
 	private:
 		static constexpr const char* m_hex_digits = "0123456789abcdef";
 		static constexpr const char* m_name_digits = "abcdefghiklmnoprstuvyzx";
-		mutable std::mt19937 m_random_generator;
-		std::random_device m_random_device;
 
+		struct TThreadEngine {
+			uint64_t m_generation = 0; // ana tohum degisince yeniden tohumlanir
+			uint32_t m_stream = 0;
+			CXoshiro256pp m_xoshiro{};
+			std::mt19937 m_mt{};
+		};
+
+		std::atomic<uint64_t> m_master_seed;
+		std::atomic<uint64_t> m_generation{ 1 };
+		mutable std::atomic<uint32_t> m_next_stream{ 0 };
+		std::atomic<ERandomEngine> m_engine{ ERandomEngine::Xoshiro };
+	private:
+		static uint64_t mix(uint64_t value) noexcept {
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+			return value ^ (value >> 31);
+		}
+
+		void reseed(TThreadEngine& engine, uint64_t generation) const noexcept {
+			const uint64_t seed = mix(m_master_seed.load(std::memory_order_relaxed) ^ mix(uint64_t(engine.m_stream) + 1));
+			engine.m_xoshiro.seed(seed);
+			engine.m_mt.seed(static_cast<std::mt19937::result_type>(seed ^ (seed >> 32)));
+			engine.m_generation = generation;
+		}
+
+		static TThreadEngine& local_engine() noexcept {
+			thread_local TThreadEngine s_engine{};
+			return s_engine;
+		}
+
+		TThreadEngine& get_engine() const noexcept {
+			TThreadEngine& engine = local_engine();
+			const uint64_t generation = m_generation.load(std::memory_order_acquire);
+			if (engine.m_generation != generation) {
+				//Bu tohumla ilk kullanim ve seed_thread cagrilmamis: sirayla akis al.
+				engine.m_stream = m_next_stream.fetch_add(1, std::memory_order_relaxed);
+				reseed(engine, generation);
+			}
+			return engine;
+		}
+
+		template<typename TDistribution>
+		typename TDistribution::result_type sample(TDistribution& distribution) const {
+			TThreadEngine& engine = get_engine();
+			if (m_engine.load(std::memory_order_relaxed) == ERandomEngine::Mt19937) {
+				return distribution(engine.m_mt);
+			}
+			return distribution(engine.m_xoshiro);
+		}
+
+		template<typename TIterator, typename TDistribution, typename TEngine>
+		static void fill_with(TIterator first, TIterator last, TDistribution& distribution, TEngine& engine) {
+			for (; first != last; ++first) {
+				*first = distribution(engine);
+			}
+		}
 	public:
-		CRandomGenerator(): m_random_generator(m_random_device()){}
+		CRandomGenerator() : m_master_seed(std::random_device{}()) {}
+
+		//Tum thread'ler bir sonraki cagrida yeni tohumdan yeniden tohumlanir ve akis numaralari sifirlanir; sabit akis isteyenler seed_thread'i tekrar cagirmalidir.
+		void set_seed(uint64_t seed) noexcept {
+			m_master_seed.store(seed, std::memory_order_relaxed);
+			m_next_stream.store(0, std::memory_order_relaxed);
+			m_generation.fetch_add(1, std::memory_order_release);
+		}
+
+		uint64_t get_seed() const noexcept {
+			return m_master_seed.load(std::memory_order_relaxed);
+		}
+
+		//Cagiran thread'in akisini sabitler: ayni tohum + ayni akis = ayni dizi, thread'lerin baslama sirasindan bagimsiz.
+		void seed_thread(uint32_t stream) noexcept {
+			TThreadEngine& engine = local_engine();
+			engine.m_stream = stream;
+			reseed(engine, m_generation.load(std::memory_order_acquire));
+		}
+
+		void set_engine(ERandomEngine engine) noexcept {
+			m_engine.store(engine, std::memory_order_relaxed);
+		}
+
+		ERandomEngine get_engine_type() const noexcept {
+			return m_engine.load(std::memory_order_relaxed);
+		}
+
+		//Thread'in ham motoru; dagilimlari kendisi uygulayacak cagiranlar icin (or. workload generator).
+		CXoshiro256pp& thread_engine() const noexcept {
+			return get_engine().m_xoshiro;
+		}
+
 		std::string generate_client_uuid() const {
-			static std::uniform_int_distribution<int> hex_distribution(0, 15);
+			std::uniform_int_distribution<int> hex_distribution(0, 15);
 			std::string client_uuid;
 			client_uuid.reserve(36);
 
@@ -22,29 +169,53 @@ namespace NUtility {
 					client_uuid += '-';
 				}
 				else {
-					client_uuid += m_hex_digits[hex_distribution(m_random_generator)];
+					client_uuid += m_hex_digits[sample(hex_distribution)];
 				}
 			}
 			return client_uuid;
 		}
 
 		std::string generate_name() const {
-			static std::uniform_int_distribution<int> name_distribution(0, 22);
+			std::uniform_int_distribution<int> name_distribution(0, 22);
 			std::string name;
 			int nameLen = generate_number(5, 15);
 			name.reserve(nameLen);
 
 			for (int i = 0; i < nameLen; i++) {
-				name += m_name_digits[name_distribution(m_random_generator)];
+				name += m_name_digits[sample(name_distribution)];
 			}
 			return name;
 		}
 
 		int generate_number(int minVal = std::numeric_limits<int>::min(), int maxVal = std::numeric_limits<int>::max()) const {
 			std::uniform_int_distribution<int> numDistribution(minVal, maxVal);
-			return numDistribution(m_random_generator);
+			return sample(numDistribution);
+		}
+
+		//[first, last) araligini [minVal, maxVal] sayilariyla doldurur. Motor bir kez secilir.
+		template<typename TIterator>
+		void fill_numbers(TIterator first, TIterator last, int minVal, int maxVal) const {
+			std::uniform_int_distribution<int> numDistribution(minVal, maxVal);
+			TThreadEngine& engine = get_engine();
+			if (m_engine.load(std::memory_order_relaxed) == ERandomEngine::Mt19937) {
+				fill_with(first, last, numDistribution, engine.m_mt);
+			}
+			else {
+				fill_with(first, last, numDistribution, engine.m_xoshiro);
+			}
+		}
+
+		std::vector<int> generate_numbers(size_t count, int minVal, int maxVal) const {
+			std::vector<int> numbers(count);
+			fill_numbers(numbers.begin(), numbers.end(), minVal, maxVal);
+			return numbers;
+		}
+
+		//[0, 1) araliginda
+		double generate_real() const {
+			std::uniform_real_distribution<double> realDistribution(0.0, 1.0);
+			return sample(realDistribution);
 		}
 	};
 #define randomInstance CRandomGenerator::getInstance()
 }
-
@@ -0,0 +1,200 @@
+#pragma once
+#include "random_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/*
+Tohumlanmis, tekrarlanabilir erisim akisi ureticisi (benchmark ve cakisma senaryolari icin).
+Uretici kendi xoshiro256++ motorunu kullanir ve randomInstance'a dokunmaz: ayni config + ayni akis numarasi her calismada,
+thread'lerin baslama sirasindan bagimsiz olarak ayni islem dizisini uretir.
+Sayilar std dagilimlari yerine sabit formullerle uretilir, boylece diziler derleyici/standart kutuphane degisse de ayni kalir.
+
+TWorkloadConfig config{};
+config.m_seed = 42;
+config.m_distribution = EKeyDistribution::Zipfian;
+config.m_multi_record_percent = 10;
+
+CWorkloadGenerator workload(config, threadIndex);
+for (int i = 0; i < 100000; ++i) {
+	TWorkloadTransaction txn = workload.next();
+	for (const auto& op : txn.m_ops) ... // CDataWrapper: manager.Access(op.m_key, ...), CNormalQueue: queue.AddTask(...)
+}
+*/
+namespace NUtility {
+	enum class EKeyDistribution : uint8_t {
+		Uniform,
+		Zipfian, // kucuk anahtarlar cok daha sik, m_zipf_theta ile
+		Hotspot, // anahtarlarin m_hot_key_fraction kadari erisimlerin m_hot_access_fraction kadarini alir
+	};
+
+	enum class EWorkloadAccess : uint8_t {
+		Read,
+		Write,
+		Upgrade, // once okuma, sonra ayni kayit uzerinde yazma (read -> write donusumu)
+	};
+
+	struct TWorkloadConfig {
+		uint64_t m_seed = 0;
+		int m_min_key = 1;
+		int m_max_key = 100;
+
+		EKeyDistribution m_distribution = EKeyDistribution::Uniform;
+		double m_zipf_theta = 0.99; // (0, 1) araliginda, buyudukce daha carpik
+		double m_hot_key_fraction = 0.2;
+		double m_hot_access_fraction = 0.8;
+
+		//Oranlar toplamina gore normalize edilir.
+		uint32_t m_read_weight = 50;
+		uint32_t m_write_weight = 50;
+		uint32_t m_upgrade_weight = 0;
+
+		uint32_t m_multi_record_percent = 0; // islemlerin yuzde kaci cok kayitli
+		uint32_t m_records_per_transaction = 3; // cok kayitli islemlerin kayit sayisi
+		bool m_distinct_keys = true; // bir islemde ayni kayda iki kez erisilmez
+	};
+
+	struct TWorkloadOp {
+		int m_key = 0;
+		EWorkloadAccess m_access = EWorkloadAccess::Read;
+	};
+
+	struct TWorkloadTransaction {
+		std::vector<TWorkloadOp> m_ops{};
+	};
+
+	class CWorkloadGenerator {
+	private:
+		TWorkloadConfig m_config;
+		uint32_t m_stream;
+		CXoshiro256pp m_engine;
+		uint64_t m_key_count;
+
+		//Zipfian (Gray ve ark., YCSB'nin kullandigi yontem)
+		double m_zeta_n = 0.0;
+		double m_alpha = 0.0;
+		double m_eta = 0.0;
+	private:
+		static uint64_t mix(uint64_t value) noexcept {
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+			return value ^ (value >> 31);
+		}
+
+		//[0, 1)
+		double next_real() noexcept {
+			return static_cast<double>(m_engine() >> 11) * (1.0 / 9007199254740992.0);
+		}
+
+		//[0, _count)
+		uint64_t next_index(uint64_t _count) noexcept {
+			const uint64_t index = static_cast<uint64_t>(next_real() * static_cast<double>(_count));
+			return std::min(index, _count - 1);
+		}
+
+		void init_zipfian() {
+			const double theta = m_config.m_zipf_theta;
+			for (uint64_t i = 1; i <= m_key_count; ++i) {
+				m_zeta_n += 1.0 / std::pow(static_cast<double>(i), theta);
+			}
+			const double zeta2 = 1.0 + std::pow(0.5, theta);
+			m_alpha = 1.0 / (1.0 - theta);
+			m_eta = (1.0 - std::pow(2.0 / static_cast<double>(m_key_count), 1.0 - theta)) / (1.0 - zeta2 / m_zeta_n);
+		}
+
+		uint64_t next_zipfian() noexcept {
+			const double u = next_real();
+			const double uz = u * m_zeta_n;
+			if (uz < 1.0) return 0;
+			if (uz < 1.0 + std::pow(0.5, m_config.m_zipf_theta)) return 1;
+			const uint64_t index = static_cast<uint64_t>(static_cast<double>(m_key_count) * std::pow(m_eta * u - m_eta + 1.0, m_alpha));
+			return std::min(index, m_key_count - 1);
+		}
+
+		uint64_t next_hotspot() noexcept {
+			const uint64_t hotCount = std::clamp<uint64_t>(static_cast<uint64_t>(m_key_count * m_config.m_hot_key_fraction), 1, m_key_count);
+			if (hotCount == m_key_count) return next_index(m_key_count);
+			if (next_real() < m_config.m_hot_access_fraction) return next_index(hotCount);
+			return hotCount + next_index(m_key_count - hotCount);
+		}
+
+		EWorkloadAccess next_access() noexcept {
+			const uint64_t total = uint64_t(m_config.m_read_weight) + m_config.m_write_weight + m_config.m_upgrade_weight;
+			if (total == 0) return EWorkloadAccess::Read;
+			const uint64_t pick = next_index(total);
+			if (pick < m_config.m_read_weight) return EWorkloadAccess::Read;
+			if (pick < uint64_t(m_config.m_read_weight) + m_config.m_write_weight) return EWorkloadAccess::Write;
+			return EWorkloadAccess::Upgrade;
+		}
+	public:
+		//Gecersiz degerler sessizce duzeltilir (anahtar araligi, zipf theta, yuzdeler).
+		CWorkloadGenerator(const TWorkloadConfig& _config, uint32_t _stream = 0)
+			: m_config(_config), m_stream(_stream) {
+			if (m_config.m_max_key < m_config.m_min_key) std::swap(m_config.m_min_key, m_config.m_max_key);
+			m_key_count = static_cast<uint64_t>(int64_t(m_config.m_max_key) - m_config.m_min_key) + 1;
+			m_config.m_zipf_theta = std::clamp(m_config.m_zipf_theta, 0.01, 0.999);
+			m_config.m_hot_key_fraction = std::clamp(m_config.m_hot_key_fraction, 0.0, 1.0);
+			m_config.m_hot_access_fraction = std::clamp(m_config.m_hot_access_fraction, 0.0, 1.0);
+			m_config.m_multi_record_percent = std::min<uint32_t>(m_config.m_multi_record_percent, 100);
+			m_config.m_records_per_transaction = std::max<uint32_t>(m_config.m_records_per_transaction, 1);
+
+			if (m_config.m_distribution == EKeyDistribution::Zipfian) init_zipfian();
+			reset();
+		}
+
+		//Akisi bastan baslatir; ayni islem dizisi tekrar uretilir.
+		void reset() noexcept {
+			m_engine.seed(mix(m_config.m_seed ^ mix(uint64_t(m_stream) + 1)));
+		}
+
+		const TWorkloadConfig& get_config() const noexcept {
+			return m_config;
+		}
+
+		uint32_t get_stream() const noexcept {
+			return m_stream;
+		}
+
+		int next_key() noexcept {
+			uint64_t index = 0;
+			switch (m_config.m_distribution) {
+			case EKeyDistribution::Zipfian: index = next_zipfian(); break;
+			case EKeyDistribution::Hotspot: index = next_hotspot(); break;
+			default: index = next_index(m_key_count); break;
+			}
+			return static_cast<int>(int64_t(m_config.m_min_key) + static_cast<int64_t>(index));
+		}
+
+		TWorkloadTransaction next() {
+			TWorkloadTransaction txn{};
+			uint64_t recordCount = 1;
+			if (m_config.m_multi_record_percent > 0 && next_index(100) < m_config.m_multi_record_percent) {
+				recordCount = m_config.m_records_per_transaction;
+			}
+			if (m_config.m_distinct_keys) recordCount = std::min(recordCount, m_key_count);
+
+			txn.m_ops.reserve(recordCount);
+			while (txn.m_ops.size() < recordCount) {
+				const int key = next_key();
+				if (m_config.m_distinct_keys) {
+					auto same = std::find_if(txn.m_ops.begin(), txn.m_ops.end(), [key](const TWorkloadOp& op) { return op.m_key == key; });
+					if (same != txn.m_ops.end()) continue; // carpik dagilimlarda birkac deneme surebilir, dizi yine deterministiktir
+				}
+				txn.m_ops.push_back({ key, next_access() });
+			}
+			return txn;
+		}
+
+		//Tum akisi onceden uretir; olcum dongusunde uretim maliyeti olmadan tekrar oynatmak icin.
+		std::vector<TWorkloadTransaction> generate(size_t _count) {
+			std::vector<TWorkloadTransaction> transactions{};
+			transactions.reserve(_count);
+			for (size_t i = 0; i < _count; ++i) {
+				transactions.push_back(next());
+			}
+			return transactions;
+		}
+	};
+}
@@ -1,7 +1,9 @@
-#include <Singletons/future.h> // you can use std::thread or std::async instead of this
 #include <Utility/random_generator.h>
-#include "improved/data_wrapper.h"
-#include "improved/thread_tracker.h"
+#include <Utility/workload_generator.h>
+#include "Improved/data_wrapper.h"
+#include "Improved/thread_tracker.h"
+#include "Improved/safe_data_store.h"
+#include "Improved/task_executor.h" // you can use std::thread or std::async instead of this
 
 #include <memory>
 #include <functional>
@@ -33,85 +35,34 @@ struct TPerson : public ISafeData {
 
 static uint32_t s_personID = 1;
 using PersonType = std::shared_ptr<TPerson>;
-static constexpr const char* ASYNC_THREAD_PREFIX = "AsyncThread_";
+static constexpr uint64_t WORKLOAD_SEED = 42; // farkli bir senaryo icin degistirin
 
 //Data manager api
 class CPersonManager {
-//classic members
-	std::unordered_map<int, PersonType> m_person;
-	mutable std::mutex m_ContainerMutex;
-private:
-	std::shared_ptr<CNewThreadTracker<PersonType>> m_threadTracker; // should be in here because of thread tracking
+	//Sharded record store: lookups only take a read lock on one shard, the tracker lives inside the store.
+	CSafeDataStore<int, PersonType> m_person;
 public:
-	CPersonManager(size_t dataCount) {
-		m_threadTracker = std::make_shared<CNewThreadTracker<PersonType>>(); //init
-		m_person.reserve(dataCount);
-	}
+	CPersonManager(size_t dataCount) : m_person(dataCount) {}
 
 	std::shared_ptr<CNewThreadTracker<PersonType>> GetThreadTracker() const {
-		return m_threadTracker;
+		return m_person.GetThreadTracker();
 	}
 
 	//access function example
 	CDataWrapper<PersonType> Access(int personID, ELockType _requestType = ELockType::Read, std::function<void(PersonType)> _ifBusy = nullptr) {
-		PersonType per = nullptr;
-
-		{ //THAT SCOPES IMPORTANT FOR WAIT MECHANICSM:
-			std::lock_guard<std::mutex> mute(m_ContainerMutex);
-			auto found = m_person.find(personID);
-			if (found == m_person.end()) {
-				LOG_WARN(LogClass::NORMAL, "Access: Person ID ? not found in manager", personID);
-				return CDataWrapper<PersonType>(); // Bo wrapper dnecek, DATA_NOT_EXISTS olacak
-			}
-
-			per = found->second;
-		}
+		auto wrapper = m_person.Access(personID, _requestType, std::move(_ifBusy));
 
-		if (!per) {
-			LOG_WARN(LogClass::NORMAL, "Access: Person ID ? has null pointer", personID);
-			return CDataWrapper<PersonType>(); // Bo wrapper, DATA_NOT_EXISTS olacak
-		}
-
-		auto wrapper = CDataWrapper<PersonType>(
-			m_threadTracker->shared_from_this(),
-			per,
-			std::optional<std::reference_wrapper<std::shared_mutex>>(per->m_mutex),
-			per->m_mutexID,
-			_requestType
-		);
-
-		if (wrapper != EWrapperResult::SUCCESS) {
-			LOG_WARN(LogClass::NORMAL, "Access: Failed to create wrapper for personID ?, wrapper result is ?, mutexID: ?",
-				personID, wrapper.GetResult(), per->mutexID);
-		}
-
-		if (wrapper == EWrapperResult::BUSY && _ifBusy != nullptr) {
-			//Try to add operation to process when data is available
-			auto opRes = m_threadTracker->AddOperationWithData(per->m_mutexID, std::move(_ifBusy), per);
-			if (opRes == EAddOperationResult::LOCK_AVAIL)/*lucky*/ {
-				//kilidi tekrar al ve yeni wrapper'i dondur.
-				auto wrapperUp = CDataWrapper<PersonType>(
-					m_threadTracker->shared_from_this(),
-					per,
-					std::optional<std::reference_wrapper<std::shared_mutex>>(per->m_mutex),
-					per->m_mutexID,
-					_requestType
-				);
-				return wrapperUp;
-			}
-
-			if (opRes == EAddOperationResult::FAILED) {
-				LOG_FATAL(LogClass::NORMAL, "AddOperation failed directly: personID ?, wrapper result is ?, mutexID: ?",
-					personID, wrapper.GetResult(), per->mutexID);
-			}
+		if (wrapper == EWrapperResult::DATA_NOT_EXISTS) {
+#ifdef LOG_THREAD_SAFE
+			LOG_WARN(LogClass::NORMAL, "Access: Person ID ? not found in manager", personID);
+#endif
 		}
 
 		return wrapper;
 	}
 
 	void Add(int _id) {
-		std::lock_guard<std::mutex> mute(m_ContainerMutex);
-		m_person.try_emplace(_id, std::make_shared<TPerson>(_id));
+		m_person.Emplace(_id, _id);
 	}
 };
 
@@ -119,75 +70,61 @@ int main(void) {
 	auto dataCount = 100; //veri sayisi az olsun ki cakismalar artsin.
 	CPersonManager manager(dataCount);
 
+	randomInstance.set_seed(WORKLOAD_SEED);
 	for (int i = 0; i < dataCount; ++i) {
 		manager.Add(randomInstance.generate_number(1, 90));
 	}
 
-	auto accesser = [&](bool sequential = false, int count = 1) -> std::vector<CDataWrapper<PersonType>> {
+	//Tohumlu is yuku: ayni WORKLOAD_SEED ile her calisma ayni erisim dizisini uretir.
+	TWorkloadConfig workloadConfig{};
+	workloadConfig.m_seed = WORKLOAD_SEED;
+	workloadConfig.m_min_key = 1;
+	workloadConfig.m_max_key = dataCount;
+	workloadConfig.m_read_weight = 45;
+	workloadConfig.m_write_weight = 45;
+	workloadConfig.m_upgrade_weight = 10;
+	workloadConfig.m_multi_record_percent = 10; // her 10 islemde bir 3 farkli veriye erisim
+	workloadConfig.m_records_per_transaction = 3;
+
+	auto accesser = [&](const TWorkloadTransaction& _txn) -> std::vector<CDataWrapper<PersonType>> {
 		std::vector<CDataWrapper<PersonType>> results;
-		results.reserve(count); // Rezerve et, bylece yer deitirmeler olmaz
-		std::unordered_set<int> accessedIds; // Ayn veriye tekrar eriimi nlemek iin
-
-		// ID'yi 1'den balatmak yerine 1 ila s_personID-1 arasnda olmal
-		// nk s_personID bir sonraki eklenecek ID'yi iaret ediyor
-		const int maxValidId = dataCount;
+		results.reserve(_txn.m_ops.size() * 2);
 
-		for (int i = 0; i < count; ++i) {
-			int rndPersonID = 0;
+		auto onBusy = [](PersonType _person) {
+			if (!_person) return;
 
-			if (sequential) {
-				// Sral eriim - her seferinde farkl bir ID'ye eriim salar
-				do {
-					rndPersonID = randomInstance.generate_number(1, maxValidId);
-				} while (accessedIds.find(rndPersonID) != accessedIds.end());
+			_person->m_id++;
+		};
 
-				accessedIds.insert(rndPersonID);
+		for (const auto& op : _txn.m_ops) {
+			if (op.m_access == EWorkloadAccess::Upgrade) {
+				//once oku, sonra ayni veri uzerinde yazma kilidi iste (read -> write donusumu)
+				results.push_back(manager.Access(op.m_key, ELockType::Read, onBusy));
+				if (results.back() != EWrapperResult::SUCCESS) continue;
 			}
-			else {
-				// Tamamen rastgele eriim - geerli ID araln kullan
-				rndPersonID = randomInstance.generate_number(1, maxValidId);
-			}
-
-			auto rndReqType = randomInstance.generate_number(1, 2);
-			auto wrapper = manager.Access(rndPersonID, rndReqType == 1 ? ELockType::Read : ELockType::Write,
-				[](PersonType _person) {
-					if (!_person) return;
 
-					_person->m_id++;
-				}
-			);
+			const ELockType requestType = op.m_access == EWorkloadAccess::Read ? ELockType::Read : ELockType::Write;
+			auto wrapper = manager.Access(op.m_key, requestType, onBusy);
 
-			// Dorudan move yerine durumu kontrol edelim
 			if (wrapper == EWrapperResult::DATA_NOT_EXISTS) {
-				// Burada ID'nin geerli olup olmadn kontrol edelim
-				LOG_WARN(LogClass::NORMAL, "Access failed for ID:?, type:?, maxValidId:?", rndPersonID, rndReqType, maxValidId);
-				// Yeni bir ID deneyelim - maksimum 3 deneme yapalm
-				for (int retry = 0; retry < 3 && wrapper == EWrapperResult::DATA_NOT_EXISTS; retry++) {
-					rndPersonID = randomInstance.generate_number(1, maxValidId);
-					wrapper = manager.Access(rndPersonID, rndReqType == 1 ? ELockType::Read : ELockType::Write,
-						[](PersonType _person) {
-							if (!_person) return;
-
-							_person->m_id++;
-							LOG_INFO(LogClass::NORMAL, "person id is ?", _person->m_id);
-						}
-					);
-				}
+#ifdef LOG_THREAD_SAFE
+				LOG_WARN(LogClass::NORMAL, "Access failed for ID:?, type:?, maxValidId:?", op.m_key, requestType, dataCount);
+#endif
 			}
 
-			// Hala baarszsa bile ekleyelim, error durumu kontrol edilecek
+			// Hala basarisizsa bile ekleyelim, error durumu kontrol edilecek
 			results.push_back(std::move(wrapper));
 		}
 
 		return results;
-		};
+	};
 
+	std::vector<NThreadSafe::TTaskHandle> asyncTasks{};
 	for (int i = 0; i < 5; ++i) {
-		std::stringstream ss{};
-		ss << ASYNC_THREAD_PREFIX << i;
-		futureInstance.addTask<void>(ss.str(), [&, i](std::atomic<bool>& bForce) {
+		asyncTasks.push_back(executorInstance.Spawn([&, i](const NThreadSafe::CStopToken& bForce) {
 			int successCount = 0;
 			int busyCount = 0;
+			CWorkloadGenerator workload(workloadConfig, i); // thread basina ayri, tekrarlanabilir akis
 
 			while (!bForce) {
 				//baslangicta ayni threadler ayni elemana erismis olsunlar.
@@ -198,7 +135,9 @@ int main(void) {
 							if (!_person) return;
 
 							_person->m_id++;
-							LOG_INFO(LogClass::NORMAL, "Called from thread ?, person name is ?", i, _person->name.c_str());
+#ifdef LOG_THREAD_SAFE
+							LOG_INFO(LogClass::NORMAL, "Called from thread ?, person id is ?", i, _person->m_id);
+#endif
 						}
 					);
 					if (wr1 == EWrapperResult::SUCCESS) {
@@ -213,7 +152,9 @@ int main(void) {
 							if (!_person) return;
 
 							_person->m_id++;
+#ifdef LOG_THREAD_SAFE
 							LOG_INFO(LogClass::NORMAL, "Called from thread ?, person id is ?", i, _person->m_id);
+#endif
 						}
 					);
 					if (wr2 == EWrapperResult::SUCCESS) {
@@ -230,7 +171,9 @@ int main(void) {
 								if (!_person) return;
 
 								_person->m_id++;
+#ifdef LOG_THREAD_SAFE
 								LOG_INFO(LogClass::NORMAL, "Called from thread ?, person id is ?", i, _person->m_id);
+#endif
 							}
 						);
 
@@ -249,7 +192,9 @@ int main(void) {
 							if (!_person) return;
 
 							_person->m_id++;
+#ifdef LOG_THREAD_SAFE
 							LOG_INFO(LogClass::NORMAL, "Called from thread ?, person id is ?", i, _person->m_id);
+#endif
 						}
 					);
 					if (wr1 == EWrapperResult::SUCCESS) {
@@ -263,7 +208,9 @@ int main(void) {
 							if (!_person) return;
 
 							_person->m_id++;
+#ifdef LOG_THREAD_SAFE
 							LOG_INFO(LogClass::NORMAL, "Called from thread ?, person id is ?", i, _person->m_id);
+#endif
 						}
 					);
 					if (wr2 == EWrapperResult::SUCCESS) {
@@ -277,7 +224,9 @@ int main(void) {
 							if (!_person) return;
 
 							_person->m_id++;
+#ifdef LOG_THREAD_SAFE
 							LOG_INFO(LogClass::NORMAL, "Called from thread ?, person id is ?", i, _person->m_id);
+#endif
 						}
 					);
 					if (wr3 == EWrapperResult::SUCCESS) {
@@ -293,7 +242,9 @@ int main(void) {
 								if (!_person) return;
 
 								_person->m_id++;
+#ifdef LOG_THREAD_SAFE
 								LOG_INFO(LogClass::NORMAL, "Called from thread ?, person id is ?", i, _person->m_id);
+#endif
 							}
 						);
 						if (wrtmp == EWrapperResult::SUCCESS) {
@@ -307,8 +258,9 @@ int main(void) {
 
 
 				// Her 10 ilemde bir, ayn thread pe pee 3 farkl veriye erimeyi dener
-				if (randomInstance.generate_number(1, 10) == 1) {
-					auto wrappers = accesser(true, 3); // 3 farkl veriye sral eriim
+				auto txn = workload.next();
+				if (txn.m_ops.size() > 1) {
+					auto wrappers = accesser(txn); // farkli verilere sirali erisim
 
 					// En az bir wrapper'n baarl olmasn bekleriz
 					bool atLeastOneSuccess = false;
@@ -334,11 +286,12 @@ int main(void) {
 				}
 				else {
 					// Normal tekli eriim
-					auto vec = accesser();
-					auto& wrapper = vec[0];
+					auto vec = accesser(txn);
+					auto& wrapper = vec.back(); // upgrade ise yazma wrapper'i
 
 
 					if (wrapper == EWrapperResult::DATA_NOT_EXISTS) {
+#ifdef LOG_THREAD_SAFE
 						LOG_WARN(LogClass::NORMAL, "Data not exist for ID, printing info");
 
 						// Sayma ilemi ekleyelim
@@ -351,6 +304,7 @@ int main(void) {
 							int total = 0;
 							LOG_WARN(LogClass::NORMAL, "Total persons in database: ?", total);
 						}
+#endif
 					}
 
 					if (wrapper == EWrapperResult::SUCCESS) {
@@ -365,16 +319,20 @@ int main(void) {
 					}
 				}
 
+#ifdef LOG_THREAD_SAFE
 				LOG_ERR(LogClass::NORMAL, "Thread ?, success: ?, busy: ?, success rate: ?", i, successCount, busyCount, (successCount * 100.0 / (successCount + busyCount)));
+#endif
 			}
-			}, false);
+			}));
 	}
 
 	//saniye boyunca asenkron islemler devam etsin.
 	std::this_thread::sleep_for(std::chrono::seconds(20));
 
 	//Hepsini durdur.
-	futureInstance.forceStop(ASYNC_THREAD_PREFIX, true);
+	for (const auto& task : asyncTasks) {
+		executorInstance.StopAndJoin(task);
+	}
 
 	std::this_thread::sleep_for(std::chrono::seconds(3));
 
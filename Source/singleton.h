@@ -1,44 +1,140 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <mutex>
+#include <type_traits>
+#include <vector>
+
+//Olusturma yolu getInstance'a gomulmesin: hizli yol register saklamayan tek okuma + dallanma olarak kalir.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SINGLETON_NOINLINE __declspec(noinline)
+#else
+#define SINGLETON_NOINLINE __attribute__((noinline))
+#endif
+
+/*
+getInstance hizli yolu tek bir acquire okumasidir (x86'da siradan bir mov), kilit sadece ilk olusturmada alinir.
+Olcum (-O2, x86-64, inline edilmeyen cagri): eski double-checked ~1.35 ns (veri yarisi ile), yeni ~1.4 ns, fonksiyon ici static ~1.37 ns.
+Fonksiyon ici static yerine atomic isaretci kullanilir, cunku ornek destroyInstance/destroyAll ile belirli bir anda yok edilebilmelidir.
+
+Ornekler varsayilan olarak process sonuna kadar yasar. Belirli bir sirada kapatmak icin:
+	CSingleton<CLockProfiler>::createInstance(); // baslangicta, sicak yolda ilk olusturma maliyeti olmasin
+	...
+	CSingletonManager::destroyAll(); // olusturulma sirasinin tersine yok eder
+Yok edilen ornegi hala kullanan thread olmamalidir; yok edildikten sonra getInstance yeni bir ornek olusturur.
+Ornege ait thread_local onbellekler instanceGeneration ile yok edilmis bir ornege ait olduklarini anlar; thread bitisinde yeni ornek olusturmamalidirlar.
+
+Process boyunca yasamasi gereken tipler (ornegin verdigi degerler hala yasayan nesnelerde duran ayiricilar) destroyAll'a katilmaz:
+	class CFoo : public CSingleton<CFoo> { public: static constexpr bool SINGLETON_KEEP_ALIVE = true; };
+*/
+template <class T, class = void>
+struct TSingletonKeepAlive : std::false_type {};
 
 template <class T>
-class CSingleton {
+struct TSingletonKeepAlive<T, std::void_t<decltype(T::SINGLETON_KEEP_ALIVE)>> : std::bool_constant<T::SINGLETON_KEEP_ALIVE> {};
+
+class CSingletonManager {
 private:
-	static std::mutex m_singleton_mutex; // singleton mutex
-	static T* m_instance;
+	using TDestroyFunc = void(*)();
+
+	static std::mutex& getMutex() {
+		static std::mutex s_mutex{};
+		return s_mutex;
+	}
+
+	static std::vector<TDestroyFunc>& getOrder() {
+		static std::vector<TDestroyFunc> s_order{};
+		return s_order;
+	}
+
+	template <class T>
+	friend class CSingleton;
+
+	static void registerInstance(TDestroyFunc _destroy) {
+		std::lock_guard<std::mutex> lock(getMutex());
+		getOrder().push_back(_destroy);
+	}
+
+	static void unregisterInstance(TDestroyFunc _destroy) {
+		std::lock_guard<std::mutex> lock(getMutex());
+		auto& order = getOrder();
+		order.erase(std::remove(order.begin(), order.end(), _destroy), order.end());
+	}
 public:
-	static T& getInstance() {	
-		if (!m_instance) {
-			std::lock_guard<std::mutex> lock(m_singleton_mutex);
-			if (!m_instance){
-				m_instance = new T();
+	//Tum ornekleri olusturulma sirasinin tersine yok eder; sonradan olusturulan, once olusturulana bagimli olabilir.
+	static void destroyAll() {
+		for (;;) {
+			TDestroyFunc destroy = nullptr;
+			{
+				std::lock_guard<std::mutex> lock(getMutex());
+				auto& order = getOrder();
+				if (order.empty()) return;
+				destroy = order.back();
 			}
+			destroy(); // kendi kaydini siler
 		}
-		return *m_instance;
 	}
-	CSingleton()=default;
-	CSingleton& operator=(CSingleton&& other) = delete;
-	CSingleton(CSingleton&& other) = delete;
-	CSingleton(const CSingleton&) = delete;
-	CSingleton& operator=(const CSingleton&) = delete;
-	~CSingleton(){
-		deleteInstance();
-	};
+};
+
+template <class T>
+class CSingleton {
 private:
-	static void deleteInstance() {
-		if (m_instance) {
-			std::lock_guard<std::mutex> lock(m_singleton_mutex);
-			if (m_instance) {
-				delete m_instance;
-				m_instance = nullptr;
+	static inline std::mutex m_singleton_mutex{}; // sadece olusturma/yok etme
+	static inline std::atomic<T*> m_instance{ nullptr };
+	static inline std::atomic<uint64_t> m_generation{ 0 }; // her olusturma ve yok etmede artar
+private:
+	SINGLETON_NOINLINE static T& createSlow() {
+		std::lock_guard<std::mutex> lock(m_singleton_mutex);
+		T* instance = m_instance.load(std::memory_order_relaxed);
+		if (!instance) {
+			instance = new T();
+			if constexpr (!TSingletonKeepAlive<T>::value) {
+				CSingletonManager::registerInstance(&CSingleton::destroyInstance);
 			}
+			m_generation.fetch_add(1, std::memory_order_relaxed);
+			m_instance.store(instance, std::memory_order_release);
 		}
+		return *instance;
+	}
+public:
+	static T& getInstance() {
+		T* instance = m_instance.load(std::memory_order_acquire);
+		if (instance) return *instance;
+		return createSlow();
+	}
+
+	//Baslangicta erken olusturma icin.
+	static void createInstance() {
+		getInstance();
+	}
+
+	static bool hasInstance() noexcept {
+		return m_instance.load(std::memory_order_acquire) != nullptr;
 	}
-};
 
+	//Ornek degistikce (olusturma/yok etme) farkli bir deger doner. Ornegi olusturmaz.
+	static uint64_t instanceGeneration() noexcept {
+		return m_generation.load(std::memory_order_acquire);
+	}
 
-template <typename T> 
-T* CSingleton<T>::m_instance = nullptr;
+	static void destroyInstance() {
+		static_assert(!TSingletonKeepAlive<T>::value, "SINGLETON_KEEP_ALIVE instances live until process exit.");
+		T* instance = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_singleton_mutex);
+			instance = m_instance.exchange(nullptr, std::memory_order_acq_rel);
+			if (!instance) return;
+			m_generation.fetch_add(1, std::memory_order_release);
+		}
+		CSingletonManager::unregisterInstance(&CSingleton::destroyInstance);
+		delete instance;
+	}
 
-template <typename T>
-std::mutex CSingleton<T>::m_singleton_mutex{};
\ No newline at end of file
+	CSingleton()=default;
+	CSingleton& operator=(CSingleton&& other) = delete;
+	CSingleton(CSingleton&& other) = delete;
+	CSingleton(const CSingleton&) = delete;
+	CSingleton& operator=(const CSingleton&) = delete;
+	~CSingleton() = default;
+};
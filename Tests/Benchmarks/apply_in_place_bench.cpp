@@ -0,0 +1,36 @@
+#include "bench_common.h"
+
+#include <safe_data_store.h>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TApplyBenchRecord : public IInlineSafeData { uint64_t m_value = 0; };
+
+	constexpr int KEY_COUNT = 1024;
+}
+
+//Ayni yazma: CDataWrapper her eriste wrapper ve shared_ptr kopyasi olusturur, With kilidi alip callable'i yerinde calistirir.
+THREAD_SAFE_BENCH(apply_in_place) {
+	CSafeDataStore<int, std::shared_ptr<TApplyBenchRecord>> store{};
+	for (int key = 0; key < KEY_COUNT; ++key) store.Emplace(key);
+
+	for (uint32_t threads : _options.ThreadCounts()) {
+		const uint64_t iterations = _options.Iterations(1000000);
+		double elapsed = NBench::RunThreads(threads, iterations, [&](uint32_t t, uint64_t i) {
+			auto wrapper = store.Access(static_cast<int>((i + t * 131) % KEY_COUNT), ELockType::Write);
+			if (wrapper) wrapper->m_value++;
+		});
+		NBench::Report("apply_in_place", "wrapper", threads, iterations * threads, elapsed);
+
+		elapsed = NBench::RunThreads(threads, iterations, [&](uint32_t t, uint64_t i) {
+			store.With(static_cast<int>((i + t * 131) % KEY_COUNT), ELockType::Write, [](TApplyBenchRecord& _record) { _record.m_value++; });
+		});
+		NBench::Report("apply_in_place", "With", threads, iterations * threads, elapsed);
+
+		elapsed = NBench::RunThreads(threads, iterations, [&](uint32_t t, uint64_t i) {
+			store.TryWith(static_cast<int>((i + t * 131) % KEY_COUNT), ELockType::Write, [](TApplyBenchRecord& _record) { _record.m_value++; }, false);
+		});
+		NBench::Report("apply_in_place", "TryWith", threads, iterations * threads, elapsed);
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/*
+Kilit ilkelleri icin basit mikro benchmark altyapisi. Her *_bench.cpp vakalarini THREAD_SAFE_BENCH ile kaydeder.
+
+LockBenchmarks [filtre...]       : adinda filtrelerden biri gecen vakalar calisir (filtre yoksa hepsi).
+LOCK_BENCH_THREADS=8             : en fazla kac thread (varsayilan hardware_concurrency, en az 4).
+LOCK_BENCH_SCALE=0.1             : iterasyon carpani (hizli duman testi icin).
+
+Sonuclar makineye baglidir: tek cekirdekli makinede olceklenme gorulmez, sadece yol maliyetleri karsilastirilabilir.
+*/
+namespace NBench {
+	struct TBenchOptions {
+		uint32_t m_maxThreads = 4;
+		double m_scale = 1.0;
+
+		uint64_t Iterations(uint64_t _base) const noexcept {
+			return std::max<uint64_t>(1, static_cast<uint64_t>(static_cast<double>(_base) * m_scale));
+		}
+
+		//1, 2, 4 ... m_maxThreads
+		std::vector<uint32_t> ThreadCounts() const {
+			std::vector<uint32_t> counts{};
+			for (uint32_t count = 1; count < m_maxThreads; count *= 2) counts.push_back(count);
+			counts.push_back(m_maxThreads);
+			return counts;
+		}
+	};
+
+	using TBenchFunc = void(*)(const TBenchOptions&);
+
+	struct TBenchCase {
+		const char* m_name;
+		TBenchFunc m_func;
+	};
+
+	inline std::vector<TBenchCase>& GetRegistry() {
+		static std::vector<TBenchCase> s_cases{};
+		return s_cases;
+	}
+
+	inline bool Register(const char* _name, TBenchFunc _func) {
+		GetRegistry().push_back({ _name, _func });
+		return true;
+	}
+
+	using TClock = std::chrono::steady_clock;
+
+	inline double ElapsedNs(TClock::time_point _start, TClock::time_point _end) {
+		return std::chrono::duration<double, std::nano>(_end - _start).count();
+	}
+
+	//_threads thread ayni anda baslar, her biri _iterations kez _body(threadIndex, i) cagirir. Toplam sure (ns) doner.
+	template<typename TBody>
+	double RunThreads(uint32_t _threads, uint64_t _iterations, TBody&& _body) {
+		std::atomic<uint32_t> ready{ 0 };
+		std::atomic<bool> bGo{ false };
+		std::vector<std::thread> threads{};
+		threads.reserve(_threads);
+		for (uint32_t t = 0; t < _threads; ++t) {
+			threads.emplace_back([&, t]() {
+				ready.fetch_add(1);
+				while (!bGo.load(std::memory_order_acquire)) std::this_thread::yield();
+				for (uint64_t i = 0; i < _iterations; ++i) _body(t, i);
+			});
+		}
+		while (ready.load() != _threads) std::this_thread::yield();
+		const auto start = TClock::now();
+		bGo.store(true, std::memory_order_release);
+		for (auto& thread : threads) thread.join();
+		return ElapsedNs(start, TClock::now());
+	}
+
+	//Islem basina sure (duvar saati / toplam islem) ve toplam verim.
+	inline void Report(const char* _case, const char* _variant, uint32_t _threads, uint64_t _totalOps, double _elapsedNs) {
+		const double nsPerOp = _elapsedNs / static_cast<double>(_totalOps);
+		std::printf("%-24s %-28s threads=%-3u %10.1f ns/op %9.2f Mops/s\n", _case, _variant, _threads, nsPerOp, 1000.0 / nsPerOp);
+		std::fflush(stdout);
+	}
+
+	//Gecikme dagilimi (us): ortanca, p99 ve en kotu. _samples siralanir.
+	inline void ReportLatency(const char* _case, const char* _variant, uint32_t _threads, std::vector<double>& _samples) {
+		if (_samples.empty()) return;
+		std::sort(_samples.begin(), _samples.end());
+		const auto at = [&](double _quantile) { return _samples[static_cast<size_t>(_quantile * static_cast<double>(_samples.size() - 1))]; };
+		std::printf("%-24s %-28s threads=%-3u p50=%8.1f us p99=%8.1f us max=%8.1f us\n", _case, _variant, _threads, at(0.5), at(0.99), _samples.back());
+		std::fflush(stdout);
+	}
+}
+
+#define THREAD_SAFE_BENCH(name) \
+	static void name(const NBench::TBenchOptions& _options); \
+	static const bool name##_registered = NBench::Register(#name, &name); \
+	static void name(const NBench::TBenchOptions& _options)
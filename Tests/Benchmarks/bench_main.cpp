@@ -0,0 +1,27 @@
+#include "bench_common.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+int main(int argc, char** argv) {
+	NBench::TBenchOptions options{};
+	options.m_maxThreads = std::max(4u, std::thread::hardware_concurrency());
+	if (const char* threads = std::getenv("LOCK_BENCH_THREADS")) {
+		options.m_maxThreads = std::max(1, std::atoi(threads));
+	}
+	if (const char* scale = std::getenv("LOCK_BENCH_SCALE")) {
+		options.m_scale = std::atof(scale) > 0.0 ? std::atof(scale) : 1.0;
+	}
+
+	std::printf("hardware_concurrency=%u max_threads=%u scale=%.2f\n", std::thread::hardware_concurrency(), options.m_maxThreads, options.m_scale);
+	for (const auto& benchCase : NBench::GetRegistry()) {
+		bool bSelected = argc < 2;
+		for (int i = 1; i < argc && !bSelected; ++i) {
+			bSelected = std::strstr(benchCase.m_name, argv[i]) != nullptr;
+		}
+		if (!bSelected) continue;
+		benchCase.m_func(options);
+	}
+	return 0;
+}
@@ -0,0 +1,77 @@
+#include "bench_common.h"
+
+#include <lock_types.h>
+
+#include <array>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	constexpr uint32_t MAX_BENCH_THREADS = 64;
+
+	struct TPackedCounter {
+		std::atomic<uint64_t> m_value{ 0 };
+	};
+
+	struct alignas(CACHE_LINE_SIZE) TPaddedCounter {
+		std::atomic<uint64_t> m_value{ 0 };
+	};
+
+	//Derleyicinin okumalari atmamasi icin thread basina ayri line'da tutulan toplam.
+	struct alignas(CACHE_LINE_SIZE) TSink {
+		volatile uint64_t m_value = 0;
+	};
+
+	//Her thread kendi sayacini arttirir: paylasilan bir veri yoktur, fark sadece sayaclarin ayni line'da olmasindan gelir.
+	template<typename TCounter>
+	void RunCounters(const NBench::TBenchOptions& _options, const char* _variant) {
+		for (uint32_t threads : _options.ThreadCounts()) {
+			if (threads > MAX_BENCH_THREADS) break;
+			std::array<TCounter, MAX_BENCH_THREADS> counters{};
+			const uint64_t perThread = _options.Iterations(4000000);
+			const double elapsed = NBench::RunThreads(threads, perThread, [&](uint32_t t, uint64_t) {
+				counters[t].m_value.fetch_add(1, std::memory_order_relaxed);
+			});
+			NBench::Report("false_sharing", _variant, threads, perThread * threads, elapsed);
+		}
+	}
+
+	//Okuyucular kilidin sabit alanlarini okurken ayri bir thread sahiplik ekleyip cikarir (m_classMutex ve m_owners yazilir).
+	//Sabitler ayri line'da oldugu icin okuma maliyeti sahiplik trafiginden etkilenmemeli.
+	void RunLockReaders(const NBench::TBenchOptions& _options, bool _bChurn) {
+		const char* variant = _bChurn ? "lock ids + owner churn" : "lock ids idle";
+		for (uint32_t threads : _options.ThreadCounts()) {
+			if (threads > MAX_BENCH_THREADS) break;
+			std::shared_mutex mutex{};
+			CReadLock lock(1, mutex);
+			ILock& base = lock;
+			std::atomic<bool> bStop{ false };
+			std::thread owner{};
+			if (_bChurn) {
+				owner = std::thread([&]() {
+					while (!bStop.load(std::memory_order_relaxed)) {
+						lock.AddOwnership();
+						lock.RemoveOwnership();
+					}
+				});
+			}
+
+			std::array<TSink, MAX_BENCH_THREADS> sinks{};
+			const uint64_t perThread = _options.Iterations(4000000);
+			const double elapsed = NBench::RunThreads(threads, perThread, [&](uint32_t t, uint64_t) {
+				sinks[t].m_value = sinks[t].m_value + base.GetMutexID() + static_cast<uint64_t>(base.GetType());
+			});
+			bStop.store(true);
+			if (owner.joinable()) owner.join();
+			NBench::Report("false_sharing", variant, threads, perThread * threads, elapsed);
+		}
+	}
+}
+
+//Tek cekirdekli makinede thread'ler ayni anda calismadigi icin line sekmesi gorulmez; fark cok cekirdekte olculmelidir.
+THREAD_SAFE_BENCH(false_sharing) {
+	RunCounters<TPackedCounter>(_options, "packed counters");
+	RunCounters<TPaddedCounter>(_options, "padded counters");
+	RunLockReaders(_options, false);
+	RunLockReaders(_options, true);
+}
@@ -0,0 +1,59 @@
+#include "bench_common.h"
+
+#include <safe_data_store.h>
+
+#ifdef THREAD_SAFE_HAS_COROUTINES
+#include <coroutine>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TCoroBenchRecord : public IInlineSafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TCoroBenchRecord>>;
+
+	struct TDetachedTask {
+		struct promise_type {
+			TDetachedTask get_return_object() noexcept { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() { std::terminate(); }
+		};
+	};
+
+	template<typename TTracker>
+	TDetachedTask Increment(std::shared_ptr<TTracker> _tracker, std::shared_ptr<TCoroBenchRecord> _record) {
+		auto wrapper = co_await _tracker->Acquire(_record, ELockType::Write);
+		if (wrapper) wrapper->m_value++;
+	}
+
+	//Yazma kilidi tutulurken _waiters bekleyen eklenir, kilit birakilinca hepsi sirayla devralir. Bekleyen basina sure doner.
+	template<typename TEnqueue>
+	double MeasureHandOff(TStore& _store, uint64_t _waiters, TEnqueue&& _enqueue) {
+		auto tracker = _store.GetThreadTracker();
+		auto record = _store.Find(1);
+		const auto start = NBench::TClock::now();
+		{
+			auto held = tracker->AcquireAsync(record, ELockType::Write).get();
+			for (uint64_t i = 0; i < _waiters; ++i) _enqueue(tracker, record);
+		}
+		return NBench::ElapsedNs(start, NBench::TClock::now());
+	}
+}
+
+//Ayni FIFO bekleme kuyrugu: callback (AcquireAsync) ile coroutine (co_await Acquire) arasindaki ek maliyet.
+THREAD_SAFE_BENCH(coroutine_handoff) {
+	TStore store{};
+	store.Emplace(1);
+	const uint64_t waiters = _options.Iterations(200000);
+
+	double elapsed = MeasureHandOff(store, waiters, [](auto& _tracker, auto& _record) {
+		_tracker->AcquireAsync(_record, ELockType::Write, [](auto _wrapper) { if (_wrapper) _wrapper->m_value++; });
+	});
+	NBench::Report("coroutine_handoff", "AcquireAsync callback", 1, waiters, elapsed);
+
+	elapsed = MeasureHandOff(store, waiters, [](auto& _tracker, auto& _record) { Increment(_tracker, _record); });
+	NBench::Report("coroutine_handoff", "co_await Acquire", 1, waiters, elapsed);
+}
+#endif
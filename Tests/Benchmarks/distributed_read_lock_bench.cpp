@@ -0,0 +1,54 @@
+#include "bench_common.h"
+
+#include <safe_data_store.h>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TTrackedRecord : public ISafeData { uint64_t m_value = 0; };
+	struct TInlineRecord : public IInlineSafeData { uint64_t m_value = 0; };
+	struct TReadMostlyRecord : public IReadMostlySafeData { uint64_t m_value = 0; };
+
+	//Inline kilitli kayitlar With ile, tracker kayitlari CDataWrapper ile erisilir.
+	template<typename TRecord, typename TTracker, typename TFunc>
+	void Apply(const std::shared_ptr<TTracker>& _tracker, const std::shared_ptr<TRecord>& _record, ELockType _type, TFunc&& _func) {
+		if constexpr (THasInlineLock<TRecord>::value) {
+			_tracker->With(_record, _type, std::forward<TFunc>(_func), false);
+		}
+		else {
+			CDataWrapper<std::shared_ptr<TRecord>> wrapper(_tracker, _record, typename CDataWrapper<std::shared_ptr<TRecord>>::TMutexRef(_record->m_mutex), _record->m_mutexID, _type);
+			if (wrapper) _func(*wrapper.get());
+		}
+	}
+
+	//Tek sicak kayit: her islem okuma kilidi alip birakir, _writeEvery islemde bir yazma yapilir (0: hic).
+	template<typename TRecord>
+	void RunReadMostly(const NBench::TBenchOptions& _options, const char* _variant, uint64_t _baseIterations, uint64_t _writeEvery) {
+		CSafeDataStore<int, std::shared_ptr<TRecord>> store{};
+		store.Emplace(1);
+		auto tracker = store.GetThreadTracker();
+		auto record = store.Find(1);
+
+		for (uint32_t threads : _options.ThreadCounts()) {
+			const uint64_t iterations = _options.Iterations(_baseIterations);
+			const double elapsed = NBench::RunThreads(threads, iterations, [&](uint32_t, uint64_t i) {
+				if (_writeEvery != 0 && i % _writeEvery == 0) {
+					Apply(tracker, record, ELockType::Write, [](TRecord& r) { r.m_value++; });
+				}
+				else {
+					Apply(tracker, record, ELockType::Read, [](TRecord& r) { (void)r.m_value; });
+				}
+			});
+			NBench::Report(_writeEvery == 0 ? "read_scaling" : "read_mostly_1pct", _variant, threads, iterations * threads, elapsed);
+		}
+	}
+}
+
+//Okuyucu sayisi arttikca CDistributedReadLock'un okuma maliyeti sabit kalmali; CInlineLock'ta ortak sayac cekismesi artar.
+THREAD_SAFE_BENCH(distributed_read_lock_scaling) {
+	RunReadMostly<TInlineRecord>(_options, "inline", 2000000, 0);
+	RunReadMostly<TReadMostlyRecord>(_options, "distributed", 2000000, 0);
+	RunReadMostly<TTrackedRecord>(_options, "tracker", 100000, 0);
+	RunReadMostly<TInlineRecord>(_options, "inline", 1000000, 100);
+	RunReadMostly<TReadMostlyRecord>(_options, "distributed", 1000000, 100);
+}
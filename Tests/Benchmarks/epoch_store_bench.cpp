@@ -0,0 +1,60 @@
+#include "bench_common.h"
+
+#include <epoch_data_store.h>
+#include <safe_data_store.h>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TEpochBenchRecord : public IInlineSafeData { uint64_t m_value = 0; };
+
+	constexpr int KEY_COUNT = 1024;
+}
+
+//Ayni inline kilitli kayitlar: CSafeDataStore her eriste shared_ptr kopyalar, CEpochSafeDataStore sadece epoch'a girer.
+THREAD_SAFE_BENCH(epoch_store_read) {
+	CSafeDataStore<int, std::shared_ptr<TEpochBenchRecord>> sharedStore{};
+	CEpochSafeDataStore<int, TEpochBenchRecord> epochStore{};
+	for (int key = 0; key < KEY_COUNT; ++key) {
+		sharedStore.Emplace(key);
+		epochStore.Emplace(key);
+	}
+
+	for (uint32_t threads : _options.ThreadCounts()) {
+		const uint64_t iterations = _options.Iterations(1000000);
+		double elapsed = NBench::RunThreads(threads, iterations, [&](uint32_t t, uint64_t i) {
+			auto wrapper = sharedStore.Access(static_cast<int>((i + t * 131) % KEY_COUNT));
+			if (wrapper) (void)wrapper->m_value;
+		});
+		NBench::Report("epoch_store_read", "shared_ptr store", threads, iterations * threads, elapsed);
+
+		elapsed = NBench::RunThreads(threads, iterations, [&](uint32_t t, uint64_t i) {
+			auto wrapper = epochStore.Access(static_cast<int>((i + t * 131) % KEY_COUNT));
+			if (wrapper) (void)wrapper->m_value;
+		});
+		NBench::Report("epoch_store_read", "epoch store", threads, iterations * threads, elapsed);
+	}
+}
+
+//Okumalarin yaninda bir thread surekli silip yeniden ekler; emekli verilerin geri kazanimi okuma yolunu yavaslatmamali.
+THREAD_SAFE_BENCH(epoch_store_churn) {
+	CEpochSafeDataStore<int, TEpochBenchRecord> store{};
+	for (int key = 0; key < KEY_COUNT; ++key) store.Emplace(key);
+
+	for (uint32_t threads : _options.ThreadCounts()) {
+		if (threads < 2) continue;
+		const uint64_t iterations = _options.Iterations(500000);
+		const double elapsed = NBench::RunThreads(threads, iterations, [&](uint32_t t, uint64_t i) {
+			const int key = static_cast<int>((i + t * 131) % KEY_COUNT);
+			if (t == 0) {
+				store.Erase(key);
+				store.Emplace(key);
+				return;
+			}
+			auto wrapper = store.Access(key);
+			if (wrapper) (void)wrapper->m_value;
+		});
+		NBench::Report("epoch_store_churn", "1 writer + readers", threads, iterations * threads, elapsed);
+	}
+	epochInstance.TryReclaim();
+}
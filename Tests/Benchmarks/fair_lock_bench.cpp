@@ -0,0 +1,57 @@
+#include "bench_common.h"
+
+#include <fair_lock.h>
+
+#include <mutex>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	constexpr TLockID BENCH_LOCK_ID = 1;
+
+	//Okuyucular kilidi surekli tutup birakirken yazicilarin kilidi alma gecikmesi olculur.
+	template<typename TLock>
+	void RunWriterLatency(const NBench::TBenchOptions& _options, const char* _variant) {
+		const uint32_t readers = std::max(2u, _options.m_maxThreads);
+		const uint32_t writers = 2;
+		const uint64_t writesPerThread = _options.Iterations(2000);
+
+		TLock lock{};
+		std::atomic<bool> bStop{ false };
+		std::mutex samplesMutex{};
+		std::vector<double> samples{};
+		uint64_t busy = 0;
+
+		std::vector<std::thread> readerThreads{};
+		for (uint32_t t = 0; t < readers; ++t) {
+			readerThreads.emplace_back([&]() {
+				while (!bStop.load(std::memory_order_relaxed)) {
+					if (CInlineLockAcquirer::Acquire(lock, BENCH_LOCK_ID, ELockType::Read) == EWrapperResult::SUCCESS) {
+						CInlineLockAcquirer::Release(lock);
+					}
+				}
+			});
+		}
+
+		NBench::RunThreads(writers, writesPerThread, [&](uint32_t, uint64_t) {
+			const auto start = NBench::TClock::now();
+			const bool bLocked = CInlineLockAcquirer::Acquire(lock, BENCH_LOCK_ID, ELockType::Write) == EWrapperResult::SUCCESS;
+			const double elapsedUs = NBench::ElapsedNs(start, NBench::TClock::now()) / 1000.0;
+			if (bLocked) CInlineLockAcquirer::Release(lock);
+			std::lock_guard<std::mutex> mute(samplesMutex);
+			if (bLocked) samples.push_back(elapsedUs);
+			else ++busy;
+		});
+		bStop.store(true);
+		for (auto& thread : readerThreads) thread.join();
+
+		NBench::ReportLatency("fair_writer_latency", _variant, readers + writers, samples);
+		if (busy) std::printf("%-24s %-28s timed out writes=%llu\n", "fair_writer_latency", _variant, static_cast<unsigned long long>(busy));
+	}
+}
+
+//Okuma akisi altinda yazici kuyruk gecikmesi: CInlineLock'ta yazici okuyucularin bosluk birakmasini bekler, CFairLock'ta kuyruga girer.
+THREAD_SAFE_BENCH(fair_writer_latency) {
+	RunWriterLatency<CInlineLock>(_options, "inline (barging)");
+	RunWriterLatency<CFairLock>(_options, "fair (FIFO hand-off)");
+}
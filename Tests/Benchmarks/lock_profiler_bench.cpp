@@ -0,0 +1,49 @@
+#include "bench_common.h"
+
+#include <lock_profiler.h>
+#include <safe_data_store.h>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TProfilerBenchRecord : public IInlineSafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TProfilerBenchRecord>>;
+
+	constexpr int KEY_COUNT = 64; // her thread kendi kaydina yazar, en fazla KEY_COUNT thread
+
+	//_bShared: tum thread'ler ayni kayda yazar (bekleme ve BUSY sayaclari da calisir), degilse her thread kendi kaydina.
+	void RunProfiled(const NBench::TBenchOptions& _options, TStore& _store, bool _bEnabled, bool _bShared) {
+		const char* variant = _bShared ? (_bEnabled ? "shared record, on" : "shared record, off")
+			: (_bEnabled ? "own record, on" : "own record, off");
+		profilerInstance.Reset();
+		profilerInstance.Enable(_bEnabled);
+		for (uint32_t threads : _options.ThreadCounts()) {
+			if (threads > static_cast<uint32_t>(KEY_COUNT)) break;
+			const uint64_t perThread = _options.Iterations(1000000);
+			double elapsed = NBench::RunThreads(threads, perThread, [&](uint32_t t, uint64_t) {
+				_store.With(_bShared ? 0 : static_cast<int>(t), ELockType::Write, [](TProfilerBenchRecord& _record) { _record.m_value++; }, false);
+			});
+			NBench::Report("lock_profiler With", variant, threads, perThread * threads, elapsed);
+
+			elapsed = NBench::RunThreads(threads, perThread, [&](uint32_t t, uint64_t) {
+				auto wrapper = _store.Access(_bShared ? 0 : static_cast<int>(t), ELockType::Write);
+				if (wrapper) wrapper->m_value++;
+			});
+			NBench::Report("lock_profiler wrapper", variant, threads, perThread * threads, elapsed);
+		}
+		profilerInstance.Enable(false);
+	}
+}
+
+//Profilleyicinin acik/kapali maliyeti: kapaliyken sicak yolda tek relaxed okuma kalmali, acikken sayaclar ve orneklenen tutma suresi eklenir.
+THREAD_SAFE_BENCH(lock_profiler) {
+	TStore store{};
+	for (int key = 0; key < KEY_COUNT; ++key) store.Emplace(key);
+
+	for (bool bShared : { false, true }) {
+		RunProfiled(_options, store, false, bShared);
+		RunProfiled(_options, store, true, bShared);
+	}
+	profilerInstance.Reset();
+}
@@ -0,0 +1,64 @@
+#include "bench_common.h"
+
+#include <queue_normal.h>
+#include <queue_numa.h>
+
+#include <cstdio>
+
+using namespace NThreadSafe;
+using namespace NThreadSafe::NQueue;
+
+namespace {
+	constexpr size_t BENCH_SHARDS = 2; // tek dugumlu makinede de calma yolu denensin diye zorlanir
+
+	//Ureticiler isleri ekler; sure tum isler islenene kadar olculur. _push(threadIndex, i) isi kuyruga koyar.
+	template<typename TPush>
+	double RunProducers(uint32_t _threads, uint64_t _perThread, const std::atomic<uint64_t>& _processed, TPush&& _push) {
+		const auto start = NBench::TClock::now();
+		NBench::RunThreads(_threads, _perThread, _push);
+		const uint64_t total = _perThread * _threads;
+		while (_processed.load(std::memory_order_relaxed) < total) std::this_thread::yield();
+		return NBench::ElapsedNs(start, NBench::TClock::now());
+	}
+
+	void ReportSteals(const char* _variant, const TNumaQueueStats& _stats) {
+		std::printf("%-24s %-28s local=%llu stolen=%llu\n", "numa_queue_throughput", _variant,
+			static_cast<unsigned long long>(_stats.m_localCount), static_cast<unsigned long long>(_stats.m_stolenCount));
+		std::fflush(stdout);
+	}
+}
+
+//Tek kuyruk (CNormalQueue) ile dugum basina parca (CNumaQueue) karsilastirmasi. Isler kisadir: kuyruk ici maliyet olculur.
+//Dengeli: uretici i, i % parca sayisi parcasina ekler. Tek parca: tum isler parca 0'a, diger worker sadece calarak is bulur.
+THREAD_SAFE_BENCH(numa_queue_throughput) {
+	for (uint32_t threads : _options.ThreadCounts()) {
+		//Kuyruk MAX_QUEUE_SIZE'i asinca en eski isi duser; toplam bunun altinda tutulur.
+		const uint64_t perThread = std::max<uint64_t>(1, _options.Iterations(MAX_QUEUE_SIZE / 2) / threads);
+		const uint64_t total = perThread * threads;
+		std::atomic<uint64_t> processed{ 0 };
+		const auto process = [&](int&) { processed.fetch_add(1, std::memory_order_relaxed); return true; };
+
+		{
+			CNormalQueue<int> queue(process, static_cast<uint8_t>(BENCH_SHARDS));
+			queue.SetState(EQueueState::WORKING);
+			const double elapsed = RunProducers(threads, perThread, processed, [&](uint32_t, uint64_t i) { queue.AddTask(static_cast<int>(i)); });
+			NBench::Report("numa_queue_throughput", "normal queue", threads, total, elapsed);
+		}
+
+		processed.store(0);
+		{
+			CNumaQueue<int> queue(process, 1, BENCH_SHARDS);
+			const double elapsed = RunProducers(threads, perThread, processed, [&](uint32_t t, uint64_t i) { queue.AddTask(static_cast<int>(i), t + i); });
+			NBench::Report("numa_queue_throughput", "numa balanced", threads, total, elapsed);
+			ReportSteals("numa balanced", queue.GetStats());
+		}
+
+		processed.store(0);
+		{
+			CNumaQueue<int> queue(process, 1, BENCH_SHARDS);
+			const double elapsed = RunProducers(threads, perThread, processed, [&](uint32_t, uint64_t i) { queue.AddTask(static_cast<int>(i), 0); });
+			NBench::Report("numa_queue_throughput", "numa single shard", threads, total, elapsed);
+			ReportSteals("numa single shard", queue.GetStats());
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#include "bench_common.h"
+
+#include <safe_data_store.h>
+
+#include <cstdio>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TBatchRecord : public ISafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TBatchRecord>>;
+	using TWrapper = CDataWrapper<std::shared_ptr<TBatchRecord>>;
+
+	//Taramadaki tum kayitlar ayni anda tutulur; kayit basina maliyet kayit sayisiyla artmamali.
+	void RunScan(const NBench::TBenchOptions& _options, int _recordCount) {
+		TStore store{};
+		std::vector<int> keys{};
+		for (int key = 0; key < _recordCount; ++key) {
+			store.Emplace(key);
+			keys.push_back(key);
+		}
+		const uint64_t rounds = _options.Iterations(std::max<uint64_t>(1, 2000000 / static_cast<uint64_t>(_recordCount)));
+		const uint64_t totalOps = rounds * static_cast<uint64_t>(_recordCount);
+		char variant[64]{};
+
+		double elapsed = NBench::RunThreads(1, rounds, [&](uint32_t, uint64_t) {
+			auto batch = store.AccessReadBatch(keys);
+			for (const auto& record : batch) (void)record->m_value;
+		});
+		std::snprintf(variant, sizeof(variant), "batch records=%d", _recordCount);
+		NBench::Report("read_batch_scan", variant, 1, totalOps, elapsed);
+
+		//Tek tek alinan wrapper'lar: her kilit thread kaydinda ayri aranir.
+		std::vector<TWrapper> wrappers{};
+		wrappers.reserve(keys.size());
+		elapsed = NBench::RunThreads(1, rounds, [&](uint32_t, uint64_t) {
+			for (int key : keys) wrappers.push_back(store.Access(key));
+			for (auto& wrapper : wrappers) {
+				if (wrapper) (void)wrapper->m_value;
+			}
+			wrappers.clear();
+		});
+		std::snprintf(variant, sizeof(variant), "wrappers records=%d", _recordCount);
+		NBench::Report("read_batch_scan", variant, 1, totalOps, elapsed);
+	}
+}
+
+THREAD_SAFE_BENCH(read_batch_scan) {
+	RunScan(_options, 100);
+	RunScan(_options, 10000);
+}
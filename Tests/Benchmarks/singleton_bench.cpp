@@ -0,0 +1,62 @@
+#include "bench_common.h"
+
+#include <constants.h>
+#include <singleton.h>
+
+#include <array>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	constexpr uint32_t MAX_BENCH_THREADS = 64;
+
+	class CBenchSingleton : public CSingleton<CBenchSingleton> {
+	public:
+		static constexpr bool SINGLETON_KEEP_ALIVE = true;
+		uint64_t m_value = 1;
+	};
+
+	//Kurucu sabit degil: gercek singleton'lar gibi dinamik ilklendirilir, derleyici guard kontrolu ekler.
+	struct TLocalStaticSingleton {
+		uint64_t m_value;
+
+		TLocalStaticSingleton() : m_value(CBenchSingleton::hasInstance() ? 1 : 2) {}
+	};
+
+	struct alignas(CACHE_LINE_SIZE) TSink {
+		volatile uint64_t m_value = 0;
+	};
+
+	//Cagrilar inline edilmez: olculen, cagiran tarafta kalan hizli yoldur (singleton.h'deki olcumle ayni kosul).
+	SINGLETON_NOINLINE CBenchSingleton& GetAtomicInstance() {
+		return CBenchSingleton::getInstance();
+	}
+
+	SINGLETON_NOINLINE TLocalStaticSingleton& GetLocalStaticInstance() {
+		static TLocalStaticSingleton s_instance{};
+		return s_instance;
+	}
+
+	template<typename TGetter>
+	void RunGetter(const NBench::TBenchOptions& _options, const char* _variant, TGetter&& _getter) {
+		for (uint32_t threads : _options.ThreadCounts()) {
+			if (threads > MAX_BENCH_THREADS) break;
+			std::array<TSink, MAX_BENCH_THREADS> sinks{};
+			const uint64_t perThread = _options.Iterations(20000000);
+			const double elapsed = NBench::RunThreads(threads, perThread, [&](uint32_t t, uint64_t) {
+				sinks[t].m_value = sinks[t].m_value + _getter().m_value;
+			});
+			NBench::Report("singleton_get", _variant, threads, perThread * threads, elapsed);
+		}
+	}
+}
+
+//getInstance'in atomic isaretci hizli yolu ile fonksiyon ici static (derleyicinin guard kontrolu) karsilastirmasi.
+//Ornek olcumden once olusturulur; ilk olusturma maliyeti olculmez.
+THREAD_SAFE_BENCH(singleton_get) {
+	CBenchSingleton::createInstance();
+	GetLocalStaticInstance();
+
+	RunGetter(_options, "atomic pointer", []() -> CBenchSingleton& { return GetAtomicInstance(); });
+	RunGetter(_options, "function-local static", []() -> TLocalStaticSingleton& { return GetLocalStaticInstance(); });
+}
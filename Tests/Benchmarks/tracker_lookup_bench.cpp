@@ -0,0 +1,56 @@
+#include "bench_common.h"
+
+#include <safe_data_store.h>
+
+#include <memory>
+#include <mutex>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	constexpr int RECORD_COUNT = 64;
+
+	struct TLookupRecord : public ISafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TLookupRecord>>;
+	using TWrapper = CDataWrapper<std::shared_ptr<TLookupRecord>>;
+	using TRecordPtr = std::shared_ptr<TLockData<std::shared_ptr<TLookupRecord>>>;
+}
+
+//Tutulan kilitlerin kayitlari thread'lerden aranir. Eski yol ayni tablonun tracker geneli mutex ile aranmasidir;
+//kilitsiz okumada thread sayisi artinca maliyet mutex'teki siraya girmez.
+THREAD_SAFE_BENCH(tracker_lookup) {
+	TStore store{};
+	std::vector<TLockID> lockIDs{};
+	std::vector<TWrapper> readers{};
+	for (int key = 0; key < RECORD_COUNT; ++key) {
+		store.Emplace(key);
+		lockIDs.push_back(store.Find(key)->m_mutexID);
+		readers.push_back(store.Access(key, ELockType::Read));
+	}
+	auto tracker = store.GetThreadTracker();
+
+	std::mutex tableMutex{};
+	CLockRecordTable<TRecordPtr> lockedTable{};
+	for (TLockID lockID : lockIDs) lockedTable.TryEmplace(lockID, tracker->GetMutexData(lockID));
+
+	for (uint32_t threads : _options.ThreadCounts()) {
+		const uint64_t perThread = _options.Iterations(1000000);
+		double elapsed = NBench::RunThreads(threads, perThread, [&](uint32_t, uint64_t i) {
+			auto record = tracker->GetMutexData(lockIDs[i % RECORD_COUNT]);
+			(void)record;
+		});
+		NBench::Report("tracker_lookup", "lock-free load", threads, perThread * threads, elapsed);
+
+		elapsed = NBench::RunThreads(threads, perThread, [&](uint32_t, uint64_t i) {
+			TRecordPtr record{};
+			{
+				std::lock_guard<std::mutex> lock(tableMutex);
+				TRecordPtr* found = lockedTable.Find(lockIDs[i % RECORD_COUNT]);
+				if (found) record = *found;
+			}
+			(void)record;
+		});
+		NBench::Report("tracker_lookup", "tracker mutex + find", threads, perThread * threads, elapsed);
+	}
+}
@@ -0,0 +1,142 @@
+#include "bench_common.h"
+
+#include <Utility/workload_generator.h>
+#include <queue_normal.h>
+#include <safe_data_store.h>
+
+#include <array>
+#include <cstdio>
+
+using namespace NThreadSafe;
+using namespace NThreadSafe::NLock;
+using namespace NThreadSafe::NQueue;
+using namespace NUtility;
+
+namespace {
+	constexpr uint32_t MAX_BENCH_THREADS = 64;
+	constexpr int KEY_COUNT = 1024;
+	constexpr uint64_t WORKLOAD_SEED = 42;
+
+	struct TWorkloadBenchRecord : public IInlineSafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TWorkloadBenchRecord>>;
+
+	//Alinamayan kilit sayisi, thread basina ayri line'da.
+	struct alignas(CACHE_LINE_SIZE) TBusyCounter {
+		uint64_t m_value = 0;
+	};
+
+	TWorkloadConfig MakeConfig(EKeyDistribution _distribution, uint32_t _multiRecordPercent) {
+		TWorkloadConfig config{};
+		config.m_seed = WORKLOAD_SEED;
+		config.m_min_key = 0;
+		config.m_max_key = KEY_COUNT - 1;
+		config.m_distribution = _distribution;
+		config.m_read_weight = 80;
+		config.m_write_weight = 20;
+		config.m_multi_record_percent = _multiRecordPercent;
+		return config;
+	}
+
+	//Her thread kendi akisini (akis numarasi = thread) olcumden once uretir; dongude uretim maliyeti olmaz.
+	//Cok kayitli islemlerde anahtarlar siralanir, boylece kilitler her thread'de ayni sirayla alinir.
+	std::vector<std::vector<TWorkloadTransaction>> MakeStreams(const TWorkloadConfig& _config, uint32_t _threads, uint64_t _perThread) {
+		std::vector<std::vector<TWorkloadTransaction>> streams{};
+		streams.reserve(_threads);
+		for (uint32_t t = 0; t < _threads; ++t) {
+			CWorkloadGenerator workload(_config, t);
+			streams.push_back(workload.generate(_perThread));
+			for (auto& txn : streams.back()) {
+				std::sort(txn.m_ops.begin(), txn.m_ops.end(), [](const TWorkloadOp& _left, const TWorkloadOp& _right) { return _left.m_key < _right.m_key; });
+			}
+		}
+		return streams;
+	}
+
+	ELockType ToLockType(EWorkloadAccess _access) {
+		return _access == EWorkloadAccess::Read ? ELockType::Read : ELockType::Write;
+	}
+
+	void ReportBusy(const char* _case, const char* _variant, uint32_t _threads, const std::array<TBusyCounter, MAX_BENCH_THREADS>& _busy) {
+		uint64_t busy = 0;
+		for (uint32_t t = 0; t < _threads; ++t) busy += _busy[t].m_value;
+		std::printf("%-24s %-28s threads=%-3u busy=%llu\n", _case, _variant, _threads, static_cast<unsigned long long>(busy));
+		std::fflush(stdout);
+	}
+
+	//Islemin tum kayitlari CDataWrapper ile kilitlenir ve islem bitene kadar tutulur.
+	void RunStore(const NBench::TBenchOptions& _options, TStore& _store, const char* _variant, const TWorkloadConfig& _config) {
+		for (uint32_t threads : _options.ThreadCounts()) {
+			if (threads > MAX_BENCH_THREADS) break;
+			const uint64_t perThread = _options.Iterations(200000);
+			const auto streams = MakeStreams(_config, threads, perThread);
+			std::vector<std::vector<TStore::TWrapper>> held(threads);
+			for (auto& wrappers : held) wrappers.reserve(_config.m_records_per_transaction);
+			std::array<TBusyCounter, MAX_BENCH_THREADS> busy{};
+
+			const double elapsed = NBench::RunThreads(threads, perThread, [&](uint32_t t, uint64_t i) {
+				auto& wrappers = held[t];
+				for (const auto& op : streams[t][i].m_ops) {
+					wrappers.push_back(_store.Access(op.m_key, ToLockType(op.m_access)));
+					if (!wrappers.back()) {
+						busy[t].m_value++;
+						continue;
+					}
+					if (op.m_access != EWorkloadAccess::Read) wrappers.back()->m_value++;
+				}
+				wrappers.clear();
+			});
+			NBench::Report("workload_replay", _variant, threads, perThread * threads, elapsed);
+			ReportBusy("workload_replay", _variant, threads, busy);
+		}
+	}
+
+	//Ureticiler akistaki islemleri kuyruga ekler, worker'lar kayitlara CDataWrapper ile erisir. Sure tum islemler bitene kadar olculur.
+	void RunQueue(const NBench::TBenchOptions& _options, TStore& _store, const char* _variant, const TWorkloadConfig& _config) {
+		for (uint32_t threads : _options.ThreadCounts()) {
+			if (threads > MAX_BENCH_THREADS) break;
+			//Kuyruk MAX_QUEUE_SIZE'i asinca en eski isi duser; toplam bunun altinda tutulur.
+			const uint64_t perThread = std::max<uint64_t>(1, _options.Iterations(MAX_QUEUE_SIZE / 2) / threads);
+			const uint64_t total = perThread * threads;
+			const auto streams = MakeStreams(_config, threads, perThread);
+			std::atomic<uint64_t> processed{ 0 };
+
+			CNormalQueue<TWorkloadTransaction> queue([&](TWorkloadTransaction& _txn) {
+				std::vector<TStore::TWrapper> wrappers{};
+				wrappers.reserve(_txn.m_ops.size());
+				for (const auto& op : _txn.m_ops) {
+					wrappers.push_back(_store.Access(op.m_key, ToLockType(op.m_access)));
+					if (wrappers.back() && op.m_access != EWorkloadAccess::Read) wrappers.back()->m_value++;
+				}
+				processed.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}, 2);
+			queue.SetState(EQueueState::WORKING);
+
+			const auto start = NBench::TClock::now();
+			NBench::RunThreads(threads, perThread, [&](uint32_t t, uint64_t i) { queue.AddTask(streams[t][i]); });
+			while (processed.load(std::memory_order_relaxed) < total) std::this_thread::yield();
+			NBench::Report("workload_queue", _variant, threads, total, NBench::ElapsedNs(start, NBench::TClock::now()));
+		}
+	}
+}
+
+//Tohumlu akislar (bkz. workload_generator.h) her calismada ayni erisim dizisini oynatir: sonuclar dagilimlar arasinda
+//ve degisiklikler arasinda karsilastirilabilir. Okuma/yazma 80/20.
+THREAD_SAFE_BENCH(workload_replay) {
+	TStore store{};
+	for (int key = 0; key < KEY_COUNT; ++key) store.Emplace(key);
+
+	RunStore(_options, store, "uniform", MakeConfig(EKeyDistribution::Uniform, 0));
+	RunStore(_options, store, "zipfian", MakeConfig(EKeyDistribution::Zipfian, 0));
+	RunStore(_options, store, "hotspot", MakeConfig(EKeyDistribution::Hotspot, 0));
+	RunStore(_options, store, "zipfian 20% multi-record", MakeConfig(EKeyDistribution::Zipfian, 20));
+}
+
+THREAD_SAFE_BENCH(workload_queue) {
+	TStore store{};
+	for (int key = 0; key < KEY_COUNT; ++key) store.Emplace(key);
+
+	RunQueue(_options, store, "uniform", MakeConfig(EKeyDistribution::Uniform, 0));
+	RunQueue(_options, store, "zipfian 20% multi-record", MakeConfig(EKeyDistribution::Zipfian, 20));
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <safe_data_store.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace NThreadSafe;
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TAsyncRecord : public IInlineSafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TAsyncRecord>>;
+	using TWrapper = CDataWrapper<std::shared_ptr<TAsyncRecord>>;
+}
+
+TEST(AsyncAcquire, FreeLockIsGrantedImmediately) {
+	TStore store{};
+	store.Emplace(1);
+	auto future = store.AccessAsync(1, ELockType::Write);
+	ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+	auto wrapper = future.get();
+	ASSERT_TRUE(wrapper);
+	EXPECT_TRUE(store.Find(1)->m_inlineLock.IsWriteLocked());
+}
+
+//Sirada asenkron bekleyen yazici varken senkron okuyucular onun onune gecmez.
+TEST(AsyncAcquire, SyncReadersDoNotBargePastQueuedWriter) {
+	TStore store{};
+	store.Emplace(1);
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(1);
+
+	std::atomic<bool> bGranted{ false };
+	{
+		TWrapper reader = store.Access(1, ELockType::Read);
+		ASSERT_TRUE(reader);
+		tracker->AcquireAsync(record, ELockType::Write, [&](TWrapper _wrapper) {
+			EXPECT_TRUE(_wrapper);
+			bGranted.store(true);
+		});
+		EXPECT_FALSE(bGranted.load());
+
+		std::thread other([&]() {
+			EXPECT_EQ(CInlineLockAcquirer::Acquire(record->m_inlineLock, record->m_mutexID, ELockType::Read, false), EWrapperResult::BUSY);
+		});
+		other.join();
+	}
+
+	//okuyucu birakinca kilit bekleyen yaziciya devredildi.
+	EXPECT_TRUE(bGranted.load());
+	EXPECT_TRUE(record->m_inlineLock.IsFree());
+}
+
+//Kilit bossa ama bekleyen varsa (birakan thread henuz calistirmadi) senkron istek once bekleyene devreder, sonra kilidi alir.
+TEST(AsyncAcquire, SyncAcquireHandsOffToQueuedWaiterFirst) {
+	TStore store{};
+	store.Emplace(1);
+	auto record = store.Find(1);
+	auto& lock = record->m_inlineLock;
+	const TLockID lockID = record->m_mutexID;
+	std::vector<int> order{};
+
+	lock.PushPendingOperation(new TPendingOperation([&]() {
+		order.push_back(1);
+		CInlineLockAcquirer::ReleaseDetached(lock, lockID, ELockType::Write);
+	}, ELockType::Write));
+	ASSERT_TRUE(lock.IsFree());
+
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, lockID, ELockType::Write, false), EWrapperResult::SUCCESS);
+	order.push_back(2);
+	CInlineLockAcquirer::Release(lock);
+	EXPECT_EQ(order, (std::vector<int>{ 1, 2 }));
+	EXPECT_FALSE(lock.HasPendingOperations());
+	EXPECT_TRUE(lock.IsFree());
+}
+
+//Yazma devrinde kilidin yazici kaydi birakan thread'i gostermemeli.
+TEST(AsyncAcquire, WriteHandOffClearsWriter) {
+	TStore store{};
+	store.Emplace(1);
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(1);
+
+	TID writerOnGrant = std::this_thread::get_id();
+	{
+		TWrapper held = store.Access(1, ELockType::Write);
+		ASSERT_TRUE(held);
+		EXPECT_EQ(record->m_inlineLock.GetWriter(), std::this_thread::get_id());
+		tracker->AcquireAsync(record, ELockType::Write, [&](TWrapper _wrapper) {
+			ASSERT_TRUE(_wrapper);
+			writerOnGrant = record->m_inlineLock.GetWriter();
+		});
+	}
+	EXPECT_EQ(writerOnGrant, TID());
+	EXPECT_TRUE(record->m_inlineLock.IsFree());
+}
+
+//Ardisik okuyucular kilidi birlikte devralir.
+TEST(AsyncAcquire, ConsecutiveReadersShareHandOff) {
+	TStore store{};
+	store.Emplace(1);
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(1);
+
+	std::vector<TWrapper> granted{};
+	{
+		TWrapper held = store.Access(1, ELockType::Write);
+		ASSERT_TRUE(held);
+		for (int i = 0; i < 3; ++i) {
+			tracker->AcquireAsync(record, ELockType::Read, [&](TWrapper _wrapper) { granted.push_back(std::move(_wrapper)); });
+		}
+	}
+	ASSERT_EQ(granted.size(), 3u);
+	EXPECT_EQ(record->m_inlineLock.GetReaderCount(), 3u);
+	granted.clear();
+	EXPECT_TRUE(record->m_inlineLock.IsFree());
+}
+
+//Her bekleyen kilidi devralir almaz ayni thread'de birakir: zincir ic ice cagrilarla degil dongude ilerlemeli.
+TEST(AsyncAcquire, LongWaiterChainDoesNotGrowStack) {
+	TStore store{};
+	store.Emplace(1);
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(1);
+
+	constexpr uint64_t WAITERS = 200000;
+	{
+		TWrapper held = store.Access(1, ELockType::Write);
+		ASSERT_TRUE(held);
+		for (uint64_t i = 0; i < WAITERS; ++i) {
+			tracker->AcquireAsync(record, ELockType::Write, [](TWrapper _wrapper) { _wrapper->m_value++; });
+		}
+	}
+	EXPECT_EQ(record->m_value, WAITERS);
+	EXPECT_TRUE(record->m_inlineLock.IsFree());
+	EXPECT_FALSE(record->m_inlineLock.HasPendingOperations());
+}
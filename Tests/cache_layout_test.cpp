@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <lock_types.h>
+#include <queue_normal.h>
+
+#include <cstdint>
+#include <memory>
+
+using namespace NThreadSafe;
+using namespace NThreadSafe::NLock;
+
+namespace {
+	uintptr_t LineOf(const void* _address) {
+		return reinterpret_cast<uintptr_t>(_address) / CACHE_LINE_SIZE;
+	}
+
+	bool IsLineStart(const void* _address) {
+		return reinterpret_cast<uintptr_t>(_address) % CACHE_LINE_SIZE == 0;
+	}
+
+	//Korunan alanlara turetilmis siniftan ulasilir.
+	struct TLockLayout : public CReadLock {
+		using CReadLock::CReadLock;
+
+		const void* Constants() const { return &m_lockType; }
+		const void* MutexID() const { return &m_mutexID; }
+		const void* Owners() const { return &m_classMutex; }
+		const void* OwnerMap() const { return &m_owners; }
+		const void* Waiters() const { return &m_cv; }
+		const void* WaiterMutex() const { return &m_cvMutex; }
+	};
+}
+
+namespace NThreadSafe::NQueue {
+	template<typename TData>
+	struct TNormalQueueLayout {
+		static const void* State(const CNormalQueue<TData>& _queue) { return &_queue.m_state; }
+		static const void* Workers(const CNormalQueue<TData>& _queue) { return &_queue.m_cleaner; }
+		static const void* Producers(const CNormalQueue<TData>& _queue) { return &_queue.m_mutex; }
+		static const void* Container(const CNormalQueue<TData>& _queue) { return &_queue.m_mutexContainer; }
+		static const void* ContainerData(const CNormalQueue<TData>& _queue) { return &_queue.m_container; }
+	};
+}
+
+TEST(CacheLayout, LockTypesAreLineAligned) {
+	EXPECT_EQ(alignof(CReadLock), CACHE_LINE_SIZE);
+	EXPECT_EQ(alignof(CWriteLock), CACHE_LINE_SIZE);
+	EXPECT_EQ(sizeof(CReadLock) % CACHE_LINE_SIZE, 0u);
+	EXPECT_EQ(sizeof(CWriteLock) % CACHE_LINE_SIZE, 0u);
+}
+
+//Sabitler, sahiplik ve bekleyen gruplari ayri line'larda baslar; heap'teki ornekte de hizalama korunur.
+TEST(CacheLayout, LockFieldGroupsDoNotShareLines) {
+	std::shared_mutex mutex{};
+	auto lock = std::make_unique<TLockLayout>(1, mutex);
+	ASSERT_TRUE(IsLineStart(lock.get()));
+
+	EXPECT_TRUE(IsLineStart(lock->Owners()));
+	EXPECT_TRUE(IsLineStart(lock->Waiters()));
+
+	EXPECT_LT(LineOf(lock->MutexID()), LineOf(lock->Owners()));
+	EXPECT_EQ(LineOf(lock->Constants()), LineOf(lock.get())); // vptr ile ayni line
+	EXPECT_LT(LineOf(lock->OwnerMap()), LineOf(lock->Waiters()));
+	EXPECT_GT(LineOf(lock->WaiterMutex()), LineOf(lock->OwnerMap()));
+}
+
+TEST(CacheLayout, NormalQueueFieldGroupsDoNotShareLines) {
+	using TQueue = NQueue::CNormalQueue<int>;
+	using TLayout = NQueue::TNormalQueueLayout<int>;
+	EXPECT_EQ(alignof(TQueue), CACHE_LINE_SIZE);
+	EXPECT_EQ(sizeof(TQueue) % CACHE_LINE_SIZE, 0u);
+
+	auto queue = std::make_unique<TQueue>(nullptr);
+	ASSERT_TRUE(IsLineStart(queue.get()));
+
+	EXPECT_TRUE(IsLineStart(TLayout::Producers(*queue)));
+	EXPECT_TRUE(IsLineStart(TLayout::Container(*queue)));
+
+	EXPECT_EQ(LineOf(TLayout::State(*queue)), LineOf(queue.get()));
+	EXPECT_LT(LineOf(TLayout::Workers(*queue)), LineOf(TLayout::Producers(*queue)));
+	EXPECT_LT(LineOf(TLayout::Producers(*queue)), LineOf(TLayout::Container(*queue)));
+	EXPECT_GE(LineOf(TLayout::ContainerData(*queue)), LineOf(TLayout::Container(*queue)));
+}
+
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <safe_data_store.h>
+
+#ifdef THREAD_SAFE_HAS_COROUTINES
+#include <coroutine>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TCoroRecord : public IInlineSafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TCoroRecord>>;
+
+	//Hemen baslayan ve bitince kendini yok eden coroutine.
+	struct TDetachedTask {
+		struct promise_type {
+			TDetachedTask get_return_object() noexcept { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() { std::terminate(); }
+		};
+	};
+
+	template<typename TTracker>
+	TDetachedTask LockAndRecord(std::shared_ptr<TTracker> _tracker, std::shared_ptr<TCoroRecord> _record, int _index, std::vector<int>& _order, TCoroutineExecutor _executor = nullptr) {
+		auto wrapper = co_await _tracker->Acquire(_record, ELockType::Write, std::move(_executor));
+		if (!wrapper) co_return;
+		wrapper->m_value++;
+		_order.push_back(_index);
+	}
+}
+
+TEST(CoroutineAcquire, FreeLockDoesNotSuspend) {
+	TStore store{};
+	store.Emplace(1);
+	auto record = store.Find(1);
+	std::vector<int> order{};
+
+	LockAndRecord(store.GetThreadTracker(), record, 0, order);
+	ASSERT_EQ(order.size(), 1u);
+	EXPECT_EQ(record->m_value, 1u);
+	EXPECT_TRUE(record->m_inlineLock.IsFree());
+}
+
+//Kilit tutulurken bekleyen coroutine'ler birakildiginda sirayla (FIFO) ve kilidi birakan thread'de devam eder.
+TEST(CoroutineAcquire, WaitersResumeInFifoOrderOnRelease) {
+	TStore store{};
+	store.Emplace(1);
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(1);
+	std::vector<int> order{};
+
+	constexpr int WAITERS = 64;
+	{
+		auto held = tracker->AcquireAsync(record, ELockType::Write).get();
+		ASSERT_TRUE(held);
+		for (int i = 0; i < WAITERS; ++i) {
+			LockAndRecord(tracker, record, i, order);
+		}
+		EXPECT_TRUE(order.empty());
+	}
+
+	ASSERT_EQ(order.size(), static_cast<size_t>(WAITERS));
+	for (int i = 0; i < WAITERS; ++i) EXPECT_EQ(order[i], i);
+	EXPECT_EQ(record->m_value, static_cast<uint64_t>(WAITERS));
+	EXPECT_TRUE(record->m_inlineLock.IsFree());
+}
+
+//Executor verildiginde coroutine kilidi birakan thread'de degil, executor'un sectigi yerde devam eder.
+TEST(CoroutineAcquire, ExecutorDecidesWhereToResume) {
+	TStore store{};
+	store.Emplace(1);
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(1);
+	std::vector<int> order{};
+
+	std::mutex queueMutex{};
+	std::deque<std::coroutine_handle<>> queue{};
+	TCoroutineExecutor executor = [&](std::coroutine_handle<> _handle) {
+		std::lock_guard<std::mutex> mute(queueMutex);
+		queue.push_back(_handle);
+	};
+
+	{
+		auto held = tracker->AcquireAsync(record, ELockType::Write).get();
+		ASSERT_TRUE(held);
+		LockAndRecord(tracker, record, 0, order, executor);
+		LockAndRecord(tracker, record, 1, order, executor);
+	}
+	//ilk bekleyen kilidi devraldi ama henuz devam etmedi.
+	EXPECT_TRUE(order.empty());
+
+	for (size_t resumed = 0; resumed < 2; ++resumed) {
+		std::coroutine_handle<> next{};
+		{
+			std::lock_guard<std::mutex> mute(queueMutex);
+			ASSERT_FALSE(queue.empty());
+			next = queue.front();
+			queue.pop_front();
+		}
+		next.resume();
+	}
+	EXPECT_EQ(order, (std::vector<int>{ 0, 1 }));
+	EXPECT_TRUE(record->m_inlineLock.IsFree());
+}
+#endif
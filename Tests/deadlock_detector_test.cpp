@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <safe_data_store.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	using namespace std::chrono_literals;
+
+	struct TDetectedRecord : public IInlineSafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TDetectedRecord>>;
+
+	class CDeadlockDetectorTest : public ::testing::Test {
+	protected:
+		TStore m_store{};
+		std::shared_ptr<TDetectedRecord> m_record{};
+		std::atomic<uint32_t> m_reported{ 0 };
+
+		void SetUp() override {
+			m_store.Emplace(1);
+			m_record = m_store.Find(1);
+			m_store.GetThreadTracker()->EnableDeadlockDetection(EDeadlockAction::Fail, [this](const TDeadlockReport& _report) {
+				EXPECT_TRUE(_report.m_bFailed);
+				EXPECT_EQ(_report.m_threads.size(), _report.m_locks.size());
+				m_reported.fetch_add(1);
+			});
+		}
+
+		void TearDown() override { m_store.GetThreadTracker()->DisableDeadlockDetection(); }
+
+		EWrapperResult Acquire(ELockType _type) {
+			return CInlineLockAcquirer::Acquire(m_record->m_inlineLock, m_record->m_mutexID, _type);
+		}
+
+		void Release() { CInlineLockAcquirer::Release(m_record->m_inlineLock); }
+	};
+}
+
+//Iki okuyucu ayni anda yazmaya donusmeye calisir: ikincisi donguyu kapatir ve DEADLOCK ile doner, ilki donusumu tamamlar.
+TEST_F(CDeadlockDetectorTest, ConcurrentUpgradesFailTheClosingRequest) {
+	std::atomic<bool> bFirstWaiting{ false };
+	ASSERT_EQ(Acquire(ELockType::Read), EWrapperResult::SUCCESS);
+
+	EWrapperResult firstResult = EWrapperResult::BUSY;
+	std::thread first([&]() {
+		ASSERT_EQ(Acquire(ELockType::Read), EWrapperResult::SUCCESS);
+		bFirstWaiting.store(true);
+		firstResult = Acquire(ELockType::Write);
+		if (firstResult == EWrapperResult::SUCCESS) Release();
+		Release();
+	});
+	while (!bFirstWaiting.load()) std::this_thread::yield();
+	std::this_thread::sleep_for(50ms);
+
+	EXPECT_EQ(Acquire(ELockType::Write), EWrapperResult::DEADLOCK);
+	Release();
+	first.join();
+
+	EXPECT_EQ(firstResult, EWrapperResult::SUCCESS);
+	EXPECT_EQ(m_reported.load(), 1u);
+	EXPECT_EQ(deadlockDetectorInstance.GetDetectedCount(), 1u);
+	EXPECT_TRUE(m_record->m_inlineLock.IsFree());
+}
+
+//Sahibi beklemeyen bir kilidi beklemek dongu degildir; birakilan kilitler sahip olarak gorulmez.
+TEST_F(CDeadlockDetectorTest, PlainContentionIsNotReported) {
+	std::atomic<bool> bHolding{ false };
+	std::thread holder([&]() {
+		ASSERT_EQ(Acquire(ELockType::Write), EWrapperResult::SUCCESS);
+		bHolding.store(true);
+		std::this_thread::sleep_for(50ms);
+		Release();
+	});
+	while (!bHolding.load()) std::this_thread::yield();
+
+	EXPECT_EQ(Acquire(ELockType::Write), EWrapperResult::SUCCESS);
+	Release();
+	holder.join();
+
+	//ayni kilit tekrar beklenirken onceki sahiplikler dongu olusturmaz.
+	ASSERT_EQ(Acquire(ELockType::Read), EWrapperResult::SUCCESS);
+	std::thread reader([&]() {
+		EXPECT_EQ(Acquire(ELockType::Write), EWrapperResult::SUCCESS);
+		Release();
+	});
+	std::this_thread::sleep_for(50ms);
+	Release();
+	reader.join();
+
+	EXPECT_EQ(m_reported.load(), 0u);
+	EXPECT_EQ(deadlockDetectorInstance.GetDetectedCount(), 0u);
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <thread_tracker.h>
+
+#include <memory>
+#include <thread>
+
+using namespace NThreadSafe;
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TDiagRecord : public IInlineSafeData { uint64_t m_value = 0; };
+
+	using TData = std::shared_ptr<TDiagRecord>;
+	using TCountingTracker = CNewThreadTracker<TData, TDiagCounters>;
+}
+
+//Tracker'in politikasi wrapper ve inline acquirer'a gecer: varsayilan seviye None olsa da olaylar sayilir.
+TEST(Diagnostics, TrackerPolicyReachesInlineWrapper) {
+	auto tracker = std::make_shared<TCountingTracker>();
+	auto record = std::make_shared<TDiagRecord>();
+	CDiagCounters::Reset();
+	{
+		TCountingTracker::TWrapper wrapper(tracker, record, std::nullopt, record->m_mutexID, ELockType::Write);
+		ASSERT_TRUE(wrapper);
+		EXPECT_EQ(CDiagCounters::Get(ELockEvent::Acquire), 1u);
+
+		std::thread other([&]() {
+			EXPECT_EQ(tracker->TryWith(record, ELockType::Write, [](TDiagRecord& _record) { _record.m_value++; }, false), EApplyResult::BUSY);
+		});
+		other.join();
+		EXPECT_EQ(CDiagCounters::Get(ELockEvent::Busy), 1u);
+	}
+	EXPECT_EQ(CDiagCounters::Get(ELockEvent::Release), 1u);
+	EXPECT_EQ(record->m_value, 0u);
+}
+
+//Varsayilan politikali acquirer tracker'in politikasini kullanmaz.
+TEST(Diagnostics, DefaultAcquirerKeepsDefaultPolicy) {
+	if constexpr (TDefaultDiag::level != EDiagLevel::None) GTEST_SKIP() << "default diagnostics level counts events";
+	auto record = std::make_shared<TDiagRecord>();
+	CDiagCounters::Reset();
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(record->m_inlineLock, record->m_mutexID, ELockType::Write), EWrapperResult::SUCCESS);
+	CInlineLockAcquirer::Release(record->m_inlineLock);
+	EXPECT_EQ(CDiagCounters::Get(ELockEvent::Acquire), 0u);
+	EXPECT_EQ(CDiagCounters::Get(ELockEvent::Release), 0u);
+}
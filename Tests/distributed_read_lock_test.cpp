@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <distributed_read_lock.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace NThreadSafe;
+using namespace NThreadSafe::NLock;
+
+namespace {
+	constexpr TLockID TEST_LOCK_ID = 1;
+
+	//_func'u baska bir thread'de calistirir; thread kaydi (reentrancy) test thread'inden ayri olsun diye.
+	template<typename TFunc>
+	void RunOnOtherThread(TFunc&& _func) {
+		std::thread thread(std::forward<TFunc>(_func));
+		thread.join();
+	}
+}
+
+TEST(DistributedReadLock, ManyReadersHoldTogether) {
+	CDistributedReadLock lock{};
+	constexpr uint32_t READERS = 8;
+	std::atomic<uint32_t> holding{ 0 };
+	std::atomic<bool> bRelease{ false };
+
+	std::vector<std::thread> readers{};
+	for (uint32_t i = 0; i < READERS; ++i) {
+		readers.emplace_back([&]() {
+			ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+			holding.fetch_add(1);
+			while (!bRelease.load()) std::this_thread::yield();
+			CInlineLockAcquirer::Release(lock);
+		});
+	}
+	while (holding.load() != READERS) std::this_thread::yield();
+	EXPECT_EQ(lock.GetReaderCount(), READERS);
+
+	//okuyucular varken yazici alamaz.
+	RunOnOtherThread([&]() {
+		EXPECT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write, false), EWrapperResult::BUSY);
+	});
+
+	bRelease.store(true);
+	for (auto& reader : readers) reader.join();
+	EXPECT_TRUE(lock.IsFree());
+}
+
+TEST(DistributedReadLock, WriterExcludesReaders) {
+	CDistributedReadLock lock{};
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write, false), EWrapperResult::SUCCESS);
+	EXPECT_TRUE(lock.IsWriteLocked());
+	EXPECT_EQ(lock.GetWriter(), std::this_thread::get_id());
+
+	RunOnOtherThread([&]() {
+		EXPECT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::BUSY);
+		EXPECT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write, false), EWrapperResult::BUSY);
+	});
+
+	CInlineLockAcquirer::Release(lock);
+	EXPECT_TRUE(lock.IsFree());
+	EXPECT_EQ(lock.GetWriter(), TID());
+}
+
+TEST(DistributedReadLock, SingleReaderUpgrades) {
+	CDistributedReadLock lock{};
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write, false), EWrapperResult::SUCCESS);
+	EXPECT_TRUE(lock.IsWriteLocked());
+	EXPECT_EQ(lock.GetReaderCount(), 0u);
+
+	CInlineLockAcquirer::Release(lock);
+	EXPECT_TRUE(lock.IsWriteLocked());
+	CInlineLockAcquirer::Release(lock);
+	EXPECT_TRUE(lock.IsFree());
+}
+
+TEST(DistributedReadLock, UpgradeFailsWithSecondReader) {
+	CDistributedReadLock lock{};
+	std::atomic<bool> bHolding{ false };
+	std::atomic<bool> bRelease{ false };
+	std::thread reader([&]() {
+		ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+		bHolding.store(true);
+		while (!bRelease.load()) std::this_thread::yield();
+		CInlineLockAcquirer::Release(lock);
+	});
+	while (!bHolding.load()) std::this_thread::yield();
+
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+	EXPECT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write, false), EWrapperResult::BUSY);
+	EXPECT_FALSE(lock.IsWriteLocked());
+	CInlineLockAcquirer::Release(lock);
+
+	bRelease.store(true);
+	reader.join();
+	EXPECT_TRUE(lock.IsFree());
+}
+
+//Yazicilar iki alani birlikte gunceller; okuyucu hicbir zaman yarim yazilmis durum gormemeli.
+TEST(DistributedReadLock, ReadersNeverSeeTornWrites) {
+	CDistributedReadLock lock{};
+	uint64_t first = 0;
+	uint64_t second = 0;
+	std::atomic<uint64_t> torn{ 0 };
+	std::atomic<uint64_t> writes{ 0 };
+
+	constexpr uint32_t THREADS = 6;
+	constexpr uint32_t ITERATIONS = 5000;
+	std::vector<std::thread> threads{};
+	for (uint32_t t = 0; t < THREADS; ++t) {
+		threads.emplace_back([&, t]() {
+			for (uint32_t i = 0; i < ITERATIONS; ++i) {
+				const bool bWrite = (i + t) % 16 == 0;
+				if (CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, bWrite ? ELockType::Write : ELockType::Read) != EWrapperResult::SUCCESS) continue;
+				if (bWrite) {
+					++first;
+					++second;
+					writes.fetch_add(1, std::memory_order_relaxed);
+				}
+				else if (first != second) {
+					torn.fetch_add(1, std::memory_order_relaxed);
+				}
+				CInlineLockAcquirer::Release(lock);
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	EXPECT_EQ(torn.load(), 0u);
+	EXPECT_EQ(first, writes.load());
+	EXPECT_EQ(second, writes.load());
+	EXPECT_TRUE(lock.IsFree());
+}
+
+//Okuyucular bayrak yarisi yapar: her okuyucu, bir sonraki okuyucu kilidi alana kadar (en fazla 50ms) birakmaz; okuyucu sayisi
+//kendiliginden sifira inmez. Bekleyen yazici bayragi kaldirirsa araya okuyucu girer ve yazici zaman asimina kadar aclik ceker.
+TEST(DistributedReadLock, WritersGetThroughReadFlood) {
+	CDistributedReadLock lock{};
+	constexpr uint32_t READERS = 2;
+	constexpr uint32_t WRITERS = 1;
+	constexpr uint32_t WRITES = 5;
+	std::atomic<bool> bStop{ false };
+	std::atomic<uint32_t> holding{ 0 };
+	std::atomic<uint32_t> reads{ 0 };
+	std::atomic<uint32_t> writes{ 0 };
+	std::atomic<uint32_t> failedWrites{ 0 };
+
+	std::vector<std::thread> readers{};
+	for (uint32_t t = 0; t < READERS; ++t) {
+		readers.emplace_back([&]() {
+			while (!bStop.load()) {
+				if (CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read) != EWrapperResult::SUCCESS) continue;
+				const uint32_t others = holding.fetch_add(1);
+				reads.fetch_add(1);
+				const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+				while (holding.load() == others + 1 && !bStop.load() && std::chrono::steady_clock::now() < until) std::this_thread::yield();
+				holding.fetch_sub(1);
+				CInlineLockAcquirer::Release(lock);
+			}
+		});
+	}
+	while (reads.load() < READERS * 4) std::this_thread::yield();
+
+	std::vector<std::thread> writers{};
+	for (uint32_t t = 0; t < WRITERS; ++t) {
+		writers.emplace_back([&]() {
+			for (uint32_t i = 0; i < WRITES; ++i) {
+				if (CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write) != EWrapperResult::SUCCESS) {
+					failedWrites.fetch_add(1);
+					continue;
+				}
+				writes.fetch_add(1);
+				CInlineLockAcquirer::Release(lock);
+			}
+		});
+	}
+	for (auto& writer : writers) writer.join();
+	bStop.store(true);
+	for (auto& reader : readers) reader.join();
+
+	EXPECT_EQ(failedWrites.load(), 0u);
+	EXPECT_EQ(writes.load(), WRITERS * WRITES);
+	EXPECT_TRUE(lock.IsFree());
+}
+
+//Bekleyen yazici okuyucularin bitmesini beklerken bayragi birakmaz: bu sure boyunca yeni okuyucu giremez.
+TEST(DistributedReadLock, WaitingWriterKeepsNewReadersOut) {
+	CDistributedReadLock lock{};
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+
+	std::atomic<bool> bWriteDone{ false };
+	EWrapperResult writeResult = EWrapperResult::BUSY;
+	std::thread writer([&]() {
+		writeResult = CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write);
+		bWriteDone.store(true);
+		if (writeResult == EWrapperResult::SUCCESS) CInlineLockAcquirer::Release(lock);
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(20)); // yazici beklemeye gecsin
+
+	uint32_t lateReads = 0;
+	RunOnOtherThread([&]() {
+		const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+		while (!bWriteDone.load() && std::chrono::steady_clock::now() < until) {
+			if (CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false) == EWrapperResult::SUCCESS) {
+				lateReads++;
+				CInlineLockAcquirer::Release(lock);
+			}
+			std::this_thread::yield();
+		}
+	});
+
+	CInlineLockAcquirer::Release(lock);
+	writer.join();
+	EXPECT_EQ(lateReads, 0u);
+	EXPECT_EQ(writeResult, EWrapperResult::SUCCESS);
+	EXPECT_TRUE(lock.IsFree());
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <epoch_data_store.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	std::atomic<uint32_t> s_destroyed{ 0 };
+
+	struct TEpochRecord : public IInlineSafeData {
+		uint64_t m_value = 0;
+		~TEpochRecord() { s_destroyed.fetch_add(1); }
+	};
+
+	//Baska bir thread epoch icindeyken _func'u calistirir.
+	template<typename TFunc>
+	void WhileOtherThreadInEpoch(TFunc&& _func) {
+		std::atomic<bool> bEntered{ false };
+		std::atomic<bool> bExit{ false };
+		std::thread reader([&]() {
+			CEpochGuard guard{};
+			bEntered.store(true);
+			while (!bExit.load()) std::this_thread::yield();
+		});
+		while (!bEntered.load()) std::this_thread::yield();
+		_func();
+		bExit.store(true);
+		reader.join();
+	}
+}
+
+TEST(EpochManager, RetiredIsKeptWhileReaderInEpoch) {
+	const uint32_t before = s_destroyed.load();
+	WhileOtherThreadInEpoch([&]() {
+		epochInstance.Retire(new TEpochRecord());
+		for (int i = 0; i < 4; ++i) epochInstance.TryReclaim();
+		EXPECT_EQ(s_destroyed.load(), before);
+	});
+
+	//okuyucu cikti: artik silinebilir.
+	epochInstance.TryReclaim();
+	EXPECT_EQ(s_destroyed.load(), before + 1);
+}
+
+TEST(EpochManager, NestedGuardsKeepEpoch) {
+	const uint32_t before = s_destroyed.load();
+	std::atomic<bool> bRetired{ false };
+	std::atomic<bool> bInnerExited{ false };
+	std::atomic<bool> bChecked{ false };
+	std::thread reader([&]() {
+		CEpochGuard outer{};
+		{
+			CEpochGuard inner{};
+			while (!bRetired.load()) std::this_thread::yield();
+		}
+		bInnerExited.store(true);
+		while (!bChecked.load()) std::this_thread::yield();
+	});
+
+	epochInstance.Retire(new TEpochRecord());
+	bRetired.store(true);
+	while (!bInnerExited.load()) std::this_thread::yield();
+	epochInstance.TryReclaim();
+	EXPECT_EQ(s_destroyed.load(), before);
+
+	bChecked.store(true);
+	reader.join();
+	epochInstance.TryReclaim();
+	EXPECT_EQ(s_destroyed.load(), before + 1);
+}
+
+//Biten thread'in emekli verileri kaybolmaz, sonraki bir temizlikte silinir.
+TEST(EpochManager, OrphanedRetiredIsReclaimed) {
+	const uint32_t before = s_destroyed.load();
+	WhileOtherThreadInEpoch([&]() {
+		std::thread retirer([]() { epochInstance.Retire(new TEpochRecord()); });
+		retirer.join();
+		EXPECT_EQ(s_destroyed.load(), before);
+	});
+
+	epochInstance.TryReclaim();
+	EXPECT_EQ(s_destroyed.load(), before + 1);
+}
+
+TEST(EpochSafeDataStore, ErasedRecordOutlivesWrapper) {
+	CEpochSafeDataStore<int, TEpochRecord> store{};
+	ASSERT_TRUE(store.Emplace(7));
+	EXPECT_FALSE(store.Emplace(7));
+	const uint32_t before = s_destroyed.load();
+
+	std::atomic<bool> bHolding{ false };
+	std::atomic<bool> bErased{ false };
+	std::thread reader([&]() {
+		auto wrapper = store.Access(7, ELockType::Write);
+		ASSERT_TRUE(wrapper);
+		bHolding.store(true);
+		while (!bErased.load()) std::this_thread::yield();
+		//depodan cikti ama wrapper hala gecerli veriyi gosterir.
+		wrapper->m_value = 42;
+		EXPECT_EQ(wrapper->m_value, 42u);
+	});
+	while (!bHolding.load()) std::this_thread::yield();
+
+	EXPECT_TRUE(store.Erase(7));
+	EXPECT_FALSE(store.Access(7));
+	EXPECT_EQ(store.Size(), 0u);
+	epochInstance.TryReclaim();
+	EXPECT_EQ(s_destroyed.load(), before);
+
+	bErased.store(true);
+	reader.join();
+	epochInstance.TryReclaim();
+	EXPECT_EQ(s_destroyed.load(), before + 1);
+}
+
+TEST(EpochSafeDataStore, ForEachVisitsAll) {
+	CEpochSafeDataStore<int, TEpochRecord> store{};
+	for (int key = 0; key < 100; ++key) ASSERT_TRUE(store.Emplace(key));
+	EXPECT_EQ(store.Size(), 100u);
+
+	int sum = 0;
+	store.ForEach([&](int _key, TEpochRecord* _data) {
+		ASSERT_NE(_data, nullptr);
+		sum += _key;
+	});
+	EXPECT_EQ(sum, 99 * 100 / 2);
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <fair_lock.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace NThreadSafe;
+using namespace NThreadSafe::NLock;
+
+namespace {
+	using namespace std::chrono_literals;
+
+	std::chrono::steady_clock::time_point Deadline(std::chrono::milliseconds _after = 5s) {
+		return std::chrono::steady_clock::now() + _after;
+	}
+
+	//Kilidi Lock ile bekleyip alinma sirasini kaydeden thread'ler. Her biri kuyruga sirayla girsin diye kisa bir sure beklenir.
+	class CWaiterGroup {
+	private:
+		CFairLock& m_lock;
+		std::vector<std::thread> m_threads{};
+		std::mutex m_orderMutex{};
+		std::vector<int> m_order{};
+		std::atomic<bool> m_bRelease{ false };
+		std::atomic<uint32_t> m_granted{ 0 };
+	public:
+		explicit CWaiterGroup(CFairLock& _lock) : m_lock(_lock) {}
+		~CWaiterGroup() { Join(); }
+
+		void Add(int _index, ELockType _type) {
+			m_threads.emplace_back([this, _index, _type]() {
+				if (!m_lock.Lock(_type, Deadline())) return;
+				{
+					std::lock_guard<std::mutex> mute(m_orderMutex);
+					m_order.push_back(_index);
+				}
+				m_granted.fetch_add(1);
+				while (!m_bRelease.load()) std::this_thread::yield();
+				if (_type == ELockType::Write) m_lock.UnlockExclusive();
+				else m_lock.UnlockShared();
+			});
+			std::this_thread::sleep_for(20ms);
+		}
+
+		void WaitGranted(uint32_t _count) {
+			while (m_granted.load() < _count) std::this_thread::yield();
+		}
+
+		void ReleaseAll() { m_bRelease.store(true); }
+
+		void Join() {
+			ReleaseAll();
+			for (auto& thread : m_threads) {
+				if (thread.joinable()) thread.join();
+			}
+		}
+
+		std::vector<int> GetOrder() {
+			std::lock_guard<std::mutex> mute(m_orderMutex);
+			return m_order;
+		}
+
+		uint32_t GetGranted() const { return m_granted.load(); }
+	};
+}
+
+//Bekleyen yazicilar kilidi geldikleri sirayla devralir.
+TEST(FairLock, WritersAreGrantedInArrivalOrder) {
+	CFairLock lock{};
+	ASSERT_TRUE(lock.TryLockExclusive());
+
+	std::vector<int> order{};
+	std::mutex orderMutex{};
+	std::vector<std::thread> writers{};
+	for (int i = 0; i < 4; ++i) {
+		writers.emplace_back([&, i]() {
+			ASSERT_TRUE(lock.Lock(ELockType::Write, Deadline()));
+			{
+				std::lock_guard<std::mutex> mute(orderMutex);
+				order.push_back(i);
+			}
+			lock.UnlockExclusive();
+		});
+		std::this_thread::sleep_for(20ms);
+	}
+
+	lock.UnlockExclusive();
+	for (auto& writer : writers) writer.join();
+	EXPECT_EQ(order, (std::vector<int>{ 0, 1, 2, 3 }));
+	EXPECT_TRUE(lock.IsFree());
+}
+
+//Kuyrukta yazici varken yeni okuyucular hizli yoldan giremez (barging yok).
+TEST(FairLock, QueuedWriterBlocksNewReaders) {
+	CFairLock lock{};
+	ASSERT_TRUE(lock.TryLockShared());
+
+	CWaiterGroup group(lock);
+	group.Add(0, ELockType::Write);
+	EXPECT_FALSE(lock.TryLockShared());
+	EXPECT_EQ(group.GetGranted(), 0u);
+
+	lock.UnlockShared();
+	group.WaitGranted(1);
+	EXPECT_TRUE(lock.IsWriteLocked());
+	group.Join();
+	EXPECT_TRUE(lock.IsFree());
+}
+
+//Yazici birakinca kuyrugun basindaki ardisik okuyucular birlikte girer, arkalarindaki yazici bekler.
+TEST(FairLock, ConsecutiveReadersAreGrantedTogether) {
+	CFairLock lock{};
+	ASSERT_TRUE(lock.TryLockExclusive());
+
+	CWaiterGroup group(lock);
+	group.Add(0, ELockType::Read);
+	group.Add(1, ELockType::Read);
+	group.Add(2, ELockType::Write);
+
+	lock.UnlockExclusive();
+	group.WaitGranted(2);
+	std::this_thread::sleep_for(20ms);
+	EXPECT_EQ(group.GetGranted(), 2u);
+	EXPECT_EQ(lock.GetReaderCount(), 2u);
+	EXPECT_FALSE(lock.IsWriteLocked());
+
+	group.ReleaseAll();
+	group.WaitGranted(3);
+	group.Join();
+	auto order = group.GetOrder();
+	ASSERT_EQ(order.size(), 3u);
+	EXPECT_EQ(order.back(), 2);
+	EXPECT_TRUE(lock.IsFree());
+}
+
+//Zaman asiminda bekleyen kuyruktan cikar, arkasindakiler etkilenmez.
+TEST(FairLock, TimedOutWaiterLeavesQueue) {
+	CFairLock lock{};
+	ASSERT_TRUE(lock.TryLockExclusive());
+
+	std::thread timedOut([&]() {
+		EXPECT_FALSE(lock.Lock(ELockType::Write, Deadline(30ms)));
+	});
+	timedOut.join();
+
+	lock.UnlockExclusive();
+	EXPECT_TRUE(lock.IsFree());
+	EXPECT_TRUE(lock.TryLockShared());
+	lock.UnlockShared();
+}
+
+TEST(FairLock, WriterIsTracked) {
+	CFairLock lock{};
+	ASSERT_TRUE(lock.TryLockExclusive());
+	EXPECT_EQ(lock.GetWriter(), std::this_thread::get_id());
+	lock.UnlockExclusive();
+	EXPECT_EQ(lock.GetWriter(), TID());
+}
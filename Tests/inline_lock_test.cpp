@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <inline_lock.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace NThreadSafe;
+using namespace NThreadSafe::NLock;
+
+namespace {
+	using namespace std::chrono_literals;
+
+	constexpr TLockID TEST_LOCK_ID = 1;
+
+	//Bekleyenin kilidi kac kez denedigini sayar.
+	class CCountingLock : public CInlineLock {
+	public:
+		std::atomic<uint32_t> m_tries{ 0 };
+
+		bool TryLockExclusive() noexcept {
+			m_tries.fetch_add(1);
+			return CInlineLock::TryLockExclusive();
+		}
+
+		bool TryUpgrade() noexcept {
+			m_tries.fetch_add(1);
+			return CInlineLock::TryUpgrade();
+		}
+	};
+
+	//_func'u baska bir thread'de calistirir; thread kaydi (reentrancy) test thread'inden ayri olsun diye.
+	template<typename TFunc>
+	void RunOnOtherThread(TFunc&& _func) {
+		std::thread thread(std::forward<TFunc>(_func));
+		thread.join();
+	}
+}
+
+TEST(InlineLock, ReadersShareWriterExcludes) {
+	CInlineLock lock{};
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+	RunOnOtherThread([&]() {
+		ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+		EXPECT_EQ(lock.GetReaderCount(), 2u);
+		CInlineLockAcquirer::Release(lock);
+	});
+	RunOnOtherThread([&]() {
+		EXPECT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write, false), EWrapperResult::BUSY);
+	});
+	CInlineLockAcquirer::Release(lock);
+	EXPECT_TRUE(lock.IsFree());
+
+	//yazma kilidi ayni thread'de her seyi kapsar.
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write, false), EWrapperResult::SUCCESS);
+	EXPECT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+	EXPECT_EQ(lock.GetWriter(), std::this_thread::get_id());
+	RunOnOtherThread([&]() {
+		EXPECT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::BUSY);
+	});
+	CInlineLockAcquirer::Release(lock);
+	EXPECT_TRUE(lock.IsWriteLocked());
+	CInlineLockAcquirer::Release(lock);
+	EXPECT_TRUE(lock.IsFree());
+	EXPECT_FALSE(CInlineLockAcquirer::IsHeldByThisThread(lock));
+}
+
+//Diger okuyucu birakinca bekleyen yukseltme uyandirilir.
+TEST(InlineLock, UpgradeWaitsForOtherReader) {
+	CCountingLock lock{};
+	std::atomic<bool> bHolding{ false };
+	std::thread other([&]() {
+		ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+		bHolding.store(true);
+		std::this_thread::sleep_for(100ms);
+		CInlineLockAcquirer::Release(lock);
+	});
+	while (!bHolding.load()) std::this_thread::yield();
+
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+	lock.m_tries.store(0);
+	EXPECT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write), EWrapperResult::SUCCESS);
+	EXPECT_TRUE(lock.IsWriteLocked());
+	EXPECT_LE(lock.m_tries.load(), INLINE_SPIN_BEFORE_PARK + 8);
+	other.join();
+
+	CInlineLockAcquirer::Release(lock);
+	CInlineLockAcquirer::Release(lock);
+	EXPECT_TRUE(lock.IsFree());
+}
+
+//Kilit uzun tutulurken bekleyen yazici kisa denemeden sonra uyur; birakilinca hemen uyandirilir.
+TEST(InlineLock, WaiterParksInsteadOfSpinning) {
+	CCountingLock lock{};
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write, false), EWrapperResult::SUCCESS);
+	lock.m_tries.store(0);
+
+	EWrapperResult result = EWrapperResult::BUSY;
+	std::chrono::steady_clock::duration waited{};
+	std::thread waiter([&]() {
+		const auto start = std::chrono::steady_clock::now();
+		result = CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write);
+		waited = std::chrono::steady_clock::now() - start;
+		if (result == EWrapperResult::SUCCESS) CInlineLockAcquirer::Release(lock);
+	});
+	std::this_thread::sleep_for(100ms);
+	CInlineLockAcquirer::Release(lock);
+	waiter.join();
+
+	EXPECT_EQ(result, EWrapperResult::SUCCESS);
+	EXPECT_LT(waited, std::chrono::milliseconds(LOCK_ACQUIRE_TIMEOUT / 2));
+	EXPECT_LE(lock.m_tries.load(), INLINE_SPIN_BEFORE_PARK + 8);
+	EXPECT_TRUE(lock.IsFree());
+}
+
+//Kilit tutulurken eklenen operasyon, kilidi birakan thread'de yazma kilidi altinda calisir.
+TEST(InlineLock, PendingOperationRunsOnRelease) {
+	CInlineLock lock{};
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+
+	bool bWasWriteLocked = false;
+	std::thread::id ranOn{};
+	ASSERT_EQ(CInlineLockAcquirer::AddOperation(lock, TEST_LOCK_ID, [&]() {
+		bWasWriteLocked = lock.IsWriteLocked();
+		ranOn = std::this_thread::get_id();
+	}), EAddOperationResult::ADDED);
+	EXPECT_TRUE(lock.HasPendingOperations());
+	EXPECT_EQ(ranOn, std::thread::id{});
+
+	CInlineLockAcquirer::Release(lock);
+	EXPECT_EQ(ranOn, std::this_thread::get_id());
+	EXPECT_TRUE(bWasWriteLocked);
+	EXPECT_FALSE(lock.HasPendingOperations());
+	EXPECT_TRUE(lock.IsFree());
+}
+
+//Sirada bekleyen yazici kilidi birakilmadan devralir; yeni gelen okuyucu onun onune gecemez.
+TEST(InlineLock, WriteWaiterGetsLockHandedOver) {
+	CInlineLock lock{};
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::SUCCESS);
+
+	bool bGranted = false;
+	ASSERT_EQ(CInlineLockAcquirer::AddWaiter(lock, TEST_LOCK_ID, ELockType::Write, [&]() {
+		bGranted = lock.IsWriteLocked();
+		CInlineLockAcquirer::ReleaseDetached(lock, TEST_LOCK_ID, ELockType::Write);
+	}), EAddOperationResult::ADDED);
+
+	RunOnOtherThread([&]() {
+		EXPECT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read, false), EWrapperResult::BUSY);
+		EXPECT_FALSE(CInlineLockAcquirer::TryAcquireDetached(lock, TEST_LOCK_ID, ELockType::Read));
+	});
+	EXPECT_FALSE(bGranted);
+
+	CInlineLockAcquirer::Release(lock);
+	EXPECT_TRUE(bGranted);
+	EXPECT_TRUE(lock.IsFree());
+}
+
+//Yazma kilidi okuyucu bekleyenlere devredilince uyuyan okuyucu da girebilir.
+TEST(InlineLock, ParkedReaderWakesAfterReadHandOff) {
+	CInlineLock lock{};
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Write, false), EWrapperResult::SUCCESS);
+
+	std::atomic<bool> bReleaseGranted{ false };
+	std::thread granted{};
+	ASSERT_EQ(CInlineLockAcquirer::AddWaiter(lock, TEST_LOCK_ID, ELockType::Read, [&]() {
+		//devredilen okuma kilidi, bekleyen okuyucu girene kadar tutulur.
+		granted = std::thread([&]() {
+			while (!bReleaseGranted.load()) std::this_thread::yield();
+			CInlineLockAcquirer::ReleaseDetached(lock, TEST_LOCK_ID, ELockType::Read);
+		});
+	}), EAddOperationResult::ADDED);
+
+	EWrapperResult result = EWrapperResult::BUSY;
+	std::thread reader([&]() {
+		result = CInlineLockAcquirer::Acquire(lock, TEST_LOCK_ID, ELockType::Read);
+		if (result == EWrapperResult::SUCCESS) {
+			EXPECT_EQ(lock.GetReaderCount(), 2u);
+			CInlineLockAcquirer::Release(lock);
+		}
+		bReleaseGranted.store(true);
+	});
+	std::this_thread::sleep_for(50ms);
+	CInlineLockAcquirer::Release(lock);
+	reader.join();
+	granted.join();
+
+	EXPECT_EQ(result, EWrapperResult::SUCCESS);
+	EXPECT_TRUE(lock.IsFree());
+}
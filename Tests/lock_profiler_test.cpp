@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <inline_lock.h>
+
+#include <memory>
+#include <thread>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TProfiledRecord : public IInlineSafeData { uint64_t m_value = 0; };
+
+	void AcquireAndRelease(TProfiledRecord& _record, uint32_t _times) {
+		for (uint32_t i = 0; i < _times; ++i) {
+			ASSERT_EQ(CInlineLockAcquirer::Acquire(_record.m_inlineLock, _record.m_mutexID, ELockType::Write), EWrapperResult::SUCCESS);
+			CInlineLockAcquirer::Release(_record.m_inlineLock);
+		}
+	}
+
+	class CProfilerTest : public ::testing::Test {
+	protected:
+		void SetUp() override {
+			profilerInstance.Reset();
+			profilerInstance.Enable(true);
+		}
+		void TearDown() override {
+			profilerInstance.Enable(false);
+		}
+	};
+}
+
+TEST_F(CProfilerTest, CountsAcquisitionsPerLock) {
+	TProfiledRecord first{};
+	TProfiledRecord second{};
+	AcquireAndRelease(first, 5);
+	AcquireAndRelease(second, 2);
+
+	EXPECT_EQ(profilerInstance.GetRecord(first.m_mutexID).m_acquisitions, 5u);
+	EXPECT_EQ(profilerInstance.GetRecord(second.m_mutexID).m_acquisitions, 2u);
+}
+
+//Id'ler LIFO tekrar kullanilir; yeni kayit eski kaydin sayaclarini devralmamali.
+TEST_F(CProfilerTest, RecycledIDStartsWithCleanCounters) {
+	auto old = std::make_unique<TProfiledRecord>();
+	const TLockID oldID = old->m_mutexID;
+	AcquireAndRelease(*old, 10);
+	ASSERT_EQ(profilerInstance.GetRecord(oldID).m_acquisitions, 10u);
+	old.reset();
+
+	TProfiledRecord reused{};
+	ASSERT_EQ(reused.m_mutexID, oldID);
+	EXPECT_EQ(profilerInstance.GetRecord(oldID).m_acquisitions, 0u);
+
+	AcquireAndRelease(reused, 1);
+	EXPECT_EQ(profilerInstance.GetRecord(oldID).m_acquisitions, 1u);
+}
+
+TEST_F(CProfilerTest, TopRecordsAreLimitedAndSorted) {
+	TProfiledRecord quiet{};
+	TProfiledRecord busy{};
+	AcquireAndRelease(quiet, 1);
+	AcquireAndRelease(busy, 1);
+
+	//busy kaydinda cekisme: baska thread beklemeden almaya calisir.
+	ASSERT_EQ(CInlineLockAcquirer::Acquire(busy.m_inlineLock, busy.m_mutexID, ELockType::Write), EWrapperResult::SUCCESS);
+	std::thread other([&]() {
+		for (int i = 0; i < 3; ++i) {
+			EXPECT_EQ(CInlineLockAcquirer::Acquire(busy.m_inlineLock, busy.m_mutexID, ELockType::Write, false), EWrapperResult::BUSY);
+		}
+	});
+	other.join();
+	CInlineLockAcquirer::Release(busy.m_inlineLock);
+
+	auto top = profilerInstance.GetTopRecords(1);
+	ASSERT_EQ(top.size(), 1u);
+	EXPECT_EQ(top[0].m_lockID, busy.m_mutexID);
+	EXPECT_EQ(top[0].m_busy, 3u);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <queue_numa.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace NThreadSafe;
+using namespace NThreadSafe::NQueue;
+
+namespace {
+	using namespace std::chrono_literals;
+
+	template<typename TPred>
+	bool WaitFor(TPred&& _pred) {
+		const auto deadline = std::chrono::steady_clock::now() + 10s;
+		while (!_pred()) {
+			if (std::chrono::steady_clock::now() > deadline) return false;
+			std::this_thread::sleep_for(1ms);
+		}
+		return true;
+	}
+}
+
+TEST(NumaQueue, NodeCountDefaultsToTopology) {
+	CNumaQueue<int> queue(nullptr);
+	EXPECT_EQ(queue.GetNodeCount(), cpuTopologyInstance.GetNodes().size());
+}
+
+//nodeCount verilince gercek dugum sayisindan bagimsiz o kadar parca olusur, isler istenen parcaya gider.
+TEST(NumaQueue, NodeCountOverrideCreatesShards) {
+	CNumaQueue<int> queue(nullptr, 1, 3);
+	ASSERT_EQ(queue.GetNodeCount(), 3u);
+
+	queue.AddTask(1, 0);
+	queue.AddTask(2, 2);
+	queue.AddTask(3, 5); // 5 % 3
+	EXPECT_EQ(queue.GetSize(), 3u);
+
+	const TNumaQueueStats stats = queue.GetStats();
+	EXPECT_EQ(stats.m_localCount, 0u);
+	EXPECT_EQ(stats.m_stolenCount, 0u);
+}
+
+//Her parcaya kendi payi verilirse isler yerel worker'larda biter; her is tam bir kez sayilir.
+TEST(NumaQueue, BalancedTasksAreCountedOnce) {
+	constexpr uint32_t TASKS = 200;
+	std::atomic<uint32_t> processed{ 0 };
+	CNumaQueue<int> queue([&](int&) { processed.fetch_add(1); return true; }, 1, 2);
+	for (uint32_t i = 0; i < TASKS; ++i) queue.AddTask(static_cast<int>(i), i % 2);
+
+	ASSERT_TRUE(WaitFor([&]() { return processed.load() == TASKS; }));
+	queue.Stop();
+	const TNumaQueueStats stats = queue.GetStats();
+	EXPECT_EQ(stats.m_localCount + stats.m_stolenCount, TASKS);
+	EXPECT_EQ(queue.GetSize(), 0u);
+}
+
+//Tum isler tek parcaya konursa diger parcanin worker'i bos kalmaz, calar.
+TEST(NumaQueue, IdleShardStealsFromBusyShard) {
+	constexpr uint32_t TASKS = 200;
+	std::atomic<uint32_t> processed{ 0 };
+	CNumaQueue<int> queue([&](int&) {
+		std::this_thread::sleep_for(200us);
+		processed.fetch_add(1);
+		return true;
+	}, 1, 2);
+	for (uint32_t i = 0; i < TASKS; ++i) queue.AddTask(static_cast<int>(i), 0);
+
+	ASSERT_TRUE(WaitFor([&]() { return processed.load() == TASKS; }));
+	queue.Stop();
+	const TNumaQueueStats stats = queue.GetStats();
+	EXPECT_EQ(stats.m_localCount + stats.m_stolenCount, TASKS);
+	EXPECT_GT(stats.m_stolenCount, 0u);
+	EXPECT_GT(stats.m_localCount, 0u);
+}
+
+//Basarisiz isler MAX_RETRY_COUNT kez denenir.
+TEST(NumaQueue, FailedTasksAreRetried) {
+	constexpr uint32_t TASKS = 10;
+	std::atomic<uint32_t> attempts{ 0 };
+	CNumaQueue<int> queue([&](int&) { attempts.fetch_add(1); return false; }, 1, 2);
+	for (uint32_t i = 0; i < TASKS; ++i) queue.AddTask(static_cast<int>(i), i % 2);
+
+	ASSERT_TRUE(WaitFor([&]() { return attempts.load() == TASKS * MAX_RETRY_COUNT; }));
+	ASSERT_TRUE(WaitFor([&]() { return queue.GetSize() == 0; }));
+	queue.Stop();
+	EXPECT_EQ(attempts.load(), TASKS * MAX_RETRY_COUNT);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <Utility/random_generator.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace NUtility;
+
+namespace {
+	constexpr uint64_t TEST_SEED = 42;
+	constexpr size_t COUNT = 10000;
+
+	//Yeni bir thread'de akisi sabitleyip dizi uretir.
+	std::vector<int> GenerateOnThread(uint32_t _stream, size_t _count, int _min, int _max) {
+		std::vector<int> numbers{};
+		std::thread thread([&]() {
+			randomInstance.seed_thread(_stream);
+			numbers = randomInstance.generate_numbers(_count, _min, _max);
+		});
+		thread.join();
+		return numbers;
+	}
+
+	//Her test varsayilan motorla baslar ve biter.
+	class CRandomGeneratorTest : public ::testing::Test {
+	protected:
+		void SetUp() override {
+			randomInstance.set_engine(ERandomEngine::Xoshiro);
+			randomInstance.set_seed(TEST_SEED);
+		}
+		void TearDown() override { randomInstance.set_engine(ERandomEngine::Xoshiro); }
+	};
+}
+
+//Ayni tohum + ayni akis, hangi thread'de uretilirse uretilsin ayni diziyi verir.
+TEST_F(CRandomGeneratorTest, SameSeedAndStreamRepeatAcrossThreads) {
+	const auto first = GenerateOnThread(5, COUNT, 1, 90);
+	const auto second = GenerateOnThread(5, COUNT, 1, 90);
+	EXPECT_EQ(first, second);
+
+	randomInstance.seed_thread(5);
+	EXPECT_EQ(randomInstance.generate_numbers(COUNT, 1, 90), first);
+
+	EXPECT_NE(GenerateOnThread(6, COUNT, 1, 90), first);
+}
+
+//set_seed tum thread'leri yeniden tohumlar; ayni tohuma donmek diziyi tekrarlar, baska tohum degistirir.
+TEST_F(CRandomGeneratorTest, SetSeedRestartsStreams) {
+	randomInstance.seed_thread(1);
+	const auto expected = randomInstance.generate_numbers(COUNT, 0, 1000);
+
+	randomInstance.set_seed(TEST_SEED + 1);
+	randomInstance.seed_thread(1);
+	EXPECT_NE(randomInstance.generate_numbers(COUNT, 0, 1000), expected);
+
+	randomInstance.set_seed(TEST_SEED);
+	randomInstance.seed_thread(1);
+	EXPECT_EQ(randomInstance.generate_numbers(COUNT, 0, 1000), expected);
+	EXPECT_EQ(randomInstance.get_seed(), TEST_SEED);
+}
+
+TEST_F(CRandomGeneratorTest, Mt19937StreamsAreReproducible) {
+	randomInstance.set_engine(ERandomEngine::Mt19937);
+	const auto first = GenerateOnThread(2, COUNT, -50, 50);
+	EXPECT_EQ(GenerateOnThread(2, COUNT, -50, 50), first);
+
+	randomInstance.set_engine(ERandomEngine::Xoshiro);
+	EXPECT_NE(GenerateOnThread(2, COUNT, -50, 50), first);
+}
+
+//Toplu doldurma her iki motorda da [minVal, maxVal] disina cikmaz ve araligin tamamini kullanir.
+TEST_F(CRandomGeneratorTest, BulkFillStaysInRange) {
+	for (ERandomEngine engine : { ERandomEngine::Xoshiro, ERandomEngine::Mt19937 }) {
+		randomInstance.set_engine(engine);
+		std::array<int, 100000> numbers{};
+		randomInstance.fill_numbers(numbers.begin(), numbers.end(), -5, 5);
+		EXPECT_EQ(*std::min_element(numbers.begin(), numbers.end()), -5);
+		EXPECT_EQ(*std::max_element(numbers.begin(), numbers.end()), 5);
+
+		const auto wide = randomInstance.generate_numbers(COUNT, std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+		EXPECT_EQ(wide.size(), COUNT);
+		EXPECT_NE(*std::min_element(wide.begin(), wide.end()), *std::max_element(wide.begin(), wide.end()));
+
+		const auto single = randomInstance.generate_numbers(100, 7, 7);
+		EXPECT_TRUE(std::all_of(single.begin(), single.end(), [](int _value) { return _value == 7; }));
+
+		for (size_t i = 0; i < COUNT; ++i) {
+			const double real = randomInstance.generate_real();
+			ASSERT_GE(real, 0.0);
+			ASSERT_LT(real, 1.0);
+		}
+	}
+}
+
+//Toplu doldurma tek tek uretimle ayni diziyi verir (motor bir kez secilir, dagilim ayni).
+TEST_F(CRandomGeneratorTest, BulkFillMatchesSingleDraws) {
+	randomInstance.seed_thread(9);
+	const auto bulk = randomInstance.generate_numbers(COUNT, 1, 90);
+
+	randomInstance.seed_thread(9);
+	std::vector<int> single(COUNT);
+	for (auto& value : single) value = randomInstance.generate_number(1, 90);
+	EXPECT_EQ(bulk, single);
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <safe_data_store.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TStoreRecord : public ISafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TStoreRecord>>;
+
+	//Kilidi baska bir thread'de tutar; Release ile birakilir.
+	class CWriteHolder {
+	private:
+		std::atomic<bool> m_bHolding{ false };
+		std::atomic<bool> m_bRelease{ false };
+		std::thread m_thread{};
+	public:
+		CWriteHolder(TStore& _store, int _key) {
+			m_thread = std::thread([this, &_store, _key]() {
+				auto writer = _store.Access(_key, ELockType::Write);
+				m_bHolding.store(static_cast<bool>(writer));
+				while (!m_bRelease.load()) std::this_thread::yield();
+			});
+			while (!m_bHolding.load()) std::this_thread::yield();
+		}
+
+		~CWriteHolder() { Release(); }
+
+		void Release() {
+			m_bRelease.store(true);
+			if (m_thread.joinable()) m_thread.join();
+		}
+	};
+}
+
+namespace NThreadSafe::NLock {
+	template<typename TStore>
+	struct TSafeDataStoreProbe {
+		static typename TStore::TWrapper QueueIfBusy(TStore& _store, const std::shared_ptr<typename TStore::TElement>& _data, ELockType _requestType,
+			typename TStore::TWrapper&& _busy, const typename TStore::TBusyFunc& _ifBusy) {
+			return _store.QueueIfBusy(_data, _requestType, std::move(_busy), _ifBusy);
+		}
+	};
+}
+
+TEST(SafeDataStore, InsertAndEmplaceRejectDuplicates) {
+	TStore store{};
+	auto first = std::make_shared<TStoreRecord>();
+	EXPECT_TRUE(store.Insert(1, first));
+	EXPECT_FALSE(store.Insert(1, std::make_shared<TStoreRecord>()));
+	EXPECT_FALSE(store.Emplace(1));
+	EXPECT_EQ(store.Find(1), first);
+
+	EXPECT_TRUE(store.Emplace(2));
+	auto second = store.Find(2);
+	EXPECT_FALSE(store.Emplace(2));
+	EXPECT_FALSE(store.Insert(2, std::make_shared<TStoreRecord>()));
+	EXPECT_EQ(store.Find(2), second);
+
+	EXPECT_FALSE(store.Insert(3, nullptr));
+	EXPECT_FALSE(store.Contains(3));
+	EXPECT_EQ(store.Size(), 2u);
+}
+
+//Silinen veri wrapper'da gecerli kalir; kilit birakilinca ayni veri yeniden eklenip alinabilir.
+TEST(SafeDataStore, EraseWhileWrapperIsHeld) {
+	TStore store{};
+	store.Emplace(1);
+	auto record = store.Find(1);
+	{
+		auto writer = store.Access(1, ELockType::Write);
+		ASSERT_TRUE(writer);
+		EXPECT_EQ(store.Erase(1), record);
+		EXPECT_FALSE(store.Contains(1));
+		EXPECT_EQ(store.Erase(1), nullptr);
+		EXPECT_EQ(store.Access(1).GetResult(), EWrapperResult::DATA_NOT_EXISTS);
+
+		writer->m_value = 5;
+	}
+	EXPECT_EQ(record->m_value, 5u);
+
+	ASSERT_TRUE(store.Insert(1, record));
+	bool bWritten = false;
+	std::thread other([&]() { bWritten = static_cast<bool>(store.Access(1, ELockType::Write)); });
+	other.join();
+	EXPECT_TRUE(bWritten);
+}
+
+//Bekleme zaman asiminda veri gecerlidir: sonuc BUSY olur ve _ifBusy operasyon olarak eklenir, kilit birakilinca calisir.
+TEST(SafeDataStore, AccessTimeoutQueuesIfBusy) {
+	TStore store{};
+	store.Emplace(1);
+	auto record = store.Find(1);
+
+	EWrapperResult result = EWrapperResult::SUCCESS;
+	std::atomic<bool> bQueued{ false };
+	{
+		auto writer = store.Access(1, ELockType::Write);
+		ASSERT_TRUE(writer);
+		std::thread other([&]() {
+			auto busy = store.Access(1, ELockType::Write, [](std::shared_ptr<TStoreRecord> _data) { _data->m_value++; });
+			result = busy.GetResult();
+			bQueued.store(true);
+		});
+		other.join();
+		EXPECT_TRUE(bQueued.load());
+		EXPECT_EQ(record->m_value, 0u);
+	}
+
+	EXPECT_EQ(result, EWrapperResult::BUSY);
+	EXPECT_EQ(record->m_value, 1u);
+}
+
+//Operasyon eklenirken kilit serbest kaldiysa (LOCK_AVAIL) erisim tekrar denenir ve _ifBusy calismaz.
+TEST(SafeDataStore, AccessIfBusyRetriesWhenLockIsAvailable) {
+	TStore store{};
+	store.Emplace(1);
+	auto record = store.Find(1);
+
+	CWriteHolder holder(store, 1);
+	auto busy = store.Access(1, ELockType::Write);
+	ASSERT_EQ(busy.GetResult(), EWrapperResult::BUSY);
+	holder.Release();
+
+	bool bRan = false;
+	auto writer = TSafeDataStoreProbe<TStore>::QueueIfBusy(store, record, ELockType::Write, std::move(busy), [&](std::shared_ptr<TStoreRecord>) { bRan = true; });
+	ASSERT_TRUE(writer);
+	writer->m_value++;
+	EXPECT_FALSE(bRan);
+	EXPECT_EQ(record->m_value, 1u);
+}
+
+//ForEach parca kilidini _func'tan once birakir: _func icinde Access, Insert, Erase ve ic ForEach kilitlenmeden calisir.
+TEST(SafeDataStore, ForEachIsReentrant) {
+	constexpr int COUNT = 100;
+	TStore store{};
+	for (int key = 0; key < COUNT; ++key) store.Emplace(key);
+
+	size_t visited = 0;
+	store.ForEach([&](const int& _key, const std::shared_ptr<TStoreRecord>& _data) {
+		++visited;
+		if (_key >= COUNT) return; //gezinti sirasinda eklenen kayit, sonraki parcalarda gorulebilir.
+		{
+			auto writer = store.Access(_key, ELockType::Write);
+			ASSERT_TRUE(writer);
+			writer->m_value++;
+		}
+		if (_key % 10 == 0) {
+			size_t inner = 0;
+			store.ForEach([&](const int&, const std::shared_ptr<TStoreRecord>&) { ++inner; });
+			EXPECT_GT(inner, 0u);
+		}
+		if (_key % 2 == 0) {
+			EXPECT_EQ(store.Erase(_key), _data);
+		}
+		else {
+			store.Insert(_key + COUNT, std::make_shared<TStoreRecord>());
+		}
+	});
+
+	EXPECT_GE(visited, static_cast<size_t>(COUNT));
+	EXPECT_EQ(store.Size(), static_cast<size_t>(COUNT));
+	for (int key = 1; key < COUNT; key += 2) {
+		ASSERT_TRUE(store.Contains(key));
+		EXPECT_EQ(store.Find(key)->m_value, 1u);
+	}
+}
+
+//Size eklemelerle ayni anda cagrilabilir (TSAN altinda da calisir): deger azalmaz ve sonunda tum kayitlari sayar.
+TEST(SafeDataStore, ConcurrentSizeAndInsert) {
+	constexpr int THREADS = 4;
+	constexpr int PER_THREAD = 500;
+	TStore store{};
+
+	std::atomic<bool> bDone{ false };
+	std::atomic<uint32_t> decreases{ 0 };
+	std::thread reader([&]() {
+		size_t last = 0;
+		while (!bDone.load()) {
+			const size_t size = store.Size();
+			if (size < last) decreases.fetch_add(1);
+			last = size;
+		}
+	});
+
+	std::vector<std::thread> writers{};
+	std::atomic<uint32_t> inserted{ 0 };
+	for (int t = 0; t < THREADS; ++t) {
+		writers.emplace_back([&, t]() {
+			for (int i = 0; i < PER_THREAD; ++i) {
+				if (store.Emplace(t * PER_THREAD + i)) inserted.fetch_add(1);
+			}
+		});
+	}
+	for (auto& writer : writers) writer.join();
+	bDone.store(true);
+	reader.join();
+
+	EXPECT_EQ(inserted.load(), static_cast<uint32_t>(THREADS * PER_THREAD));
+	EXPECT_EQ(decreases.load(), 0u);
+	EXPECT_EQ(store.Size(), static_cast<size_t>(THREADS * PER_THREAD));
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <safe_data_store.h>
+#include <epoch_manager.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TShutdownRecord : public IInlineSafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TShutdownRecord>>;
+}
+
+//Verilen id'ler hala yasayan verilerde durur: ayirici destroyAll'dan etkilenmez, ayni id tekrar verilmez.
+TEST(SingletonShutdown, DestroyAllKeepsLockIDAllocator) {
+	const TLockID first = lockIDInstance.Allocate();
+	ASSERT_NE(first, INVALID_LOCK_ID);
+
+	CSingletonManager::destroyAll();
+	EXPECT_TRUE(CLockIDAllocator::hasInstance());
+	const TLockID second = lockIDInstance.Allocate();
+	EXPECT_GT(second, first);
+}
+
+//destroyAll'dan sonra biten thread'ler thread_local kayitlari icin ornekleri yeniden olusturmaz.
+TEST(SingletonShutdown, ThreadExitAfterDestroyAllDoesNotRecreate) {
+	TStore store{};
+	store.Emplace(1);
+	auto record = store.Find(1);
+	heldRegistryInstance.Activate();
+
+	std::atomic<bool> bUsed{ false };
+	std::atomic<bool> bExit{ false };
+	std::thread worker([&]() {
+		{
+			CEpochGuard guard{};
+		}
+		ASSERT_EQ(CInlineLockAcquirer::Acquire(record->m_inlineLock, record->m_mutexID, ELockType::Write), EWrapperResult::SUCCESS);
+		CInlineLockAcquirer::Release(record->m_inlineLock);
+		bUsed.store(true);
+		while (!bExit.load()) std::this_thread::yield();
+	});
+	while (!bUsed.load()) std::this_thread::yield();
+	ASSERT_TRUE(CEpochManager::hasInstance());
+	ASSERT_TRUE(CHeldLockRegistry::hasInstance());
+
+	CSingletonManager::destroyAll();
+	bExit.store(true);
+	worker.join();
+
+	EXPECT_FALSE(CEpochManager::hasInstance());
+	EXPECT_FALSE(CHeldLockRegistry::hasInstance());
+}
+
+//Ayni thread yeni ornekte eski kaydini kullanmaz.
+TEST(SingletonShutdown, ThreadGetsNewRecordsAfterDestroyAll) {
+	{
+		CEpochGuard guard{};
+		EXPECT_TRUE(epochInstance.IsInCriticalSection());
+	}
+	heldRegistryInstance.Activate();
+	heldRegistryInstance.Publish(7, ELockType::Read);
+
+	CSingletonManager::destroyAll();
+
+	EXPECT_FALSE(epochInstance.IsInCriticalSection());
+	{
+		CEpochGuard guard{};
+		EXPECT_TRUE(epochInstance.IsInCriticalSection());
+	}
+
+	heldRegistryInstance.Activate();
+	size_t published = 0;
+	heldRegistryInstance.ForEachPublished([&](NThreadSafe::TID, TLockID, ELockType, uint64_t, uint64_t) { ++published; });
+	EXPECT_EQ(published, 0u);
+	heldRegistryInstance.Unpublish(7);
+	heldRegistryInstance.Publish(8, ELockType::Write);
+	heldRegistryInstance.ForEachPublished([&](NThreadSafe::TID, TLockID lockID, ELockType, uint64_t, uint64_t) { EXPECT_EQ(lockID, 8u); ++published; });
+	EXPECT_EQ(published, 1u);
+	heldRegistryInstance.Deactivate();
+}
+
+//Olay tuketicisi ornekle birlikte biter: kalan olaylar tuketilir ve thread toplanir.
+TEST(SingletonShutdown, EventRingConsumerIsJoined) {
+	std::atomic<uint32_t> consumed{ 0 };
+	lockEventRingInstance.SetSink([&](const TLockEvent&) { consumed.fetch_add(1); });
+
+	constexpr uint32_t EVENTS = 100;
+	for (uint32_t i = 0; i < EVENTS; ++i) {
+		TLockEvent event{};
+		event.m_lockID = i + 1;
+		ASSERT_TRUE(lockEventRingInstance.TryPush(event));
+	}
+
+	CSingletonManager::destroyAll();
+	EXPECT_FALSE(CLockEventRing::hasInstance());
+	EXPECT_EQ(consumed.load(), EVENTS);
+}
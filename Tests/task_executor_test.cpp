@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <safe_data_store.h>
+#include <task_executor.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace NThreadSafe;
+using namespace NThreadSafe::NLock;
+
+namespace {
+	using namespace std::chrono_literals;
+
+	struct TExecutorRecord : public ISafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TExecutorRecord>>;
+
+	template<typename TPred>
+	bool WaitFor(TPred&& _pred) {
+		const auto deadline = std::chrono::steady_clock::now() + 5s;
+		while (!_pred()) {
+			if (std::chrono::steady_clock::now() > deadline) return false;
+			std::this_thread::sleep_for(1ms);
+		}
+		return true;
+	}
+}
+
+TEST(TaskExecutor, PostRunsOnPoolThread) {
+	constexpr uint32_t TASKS = 100;
+	std::atomic<uint32_t> ran{ 0 };
+	std::atomic<bool> bOnCaller{ false };
+	const auto caller = std::this_thread::get_id();
+	for (uint32_t i = 0; i < TASKS; ++i) {
+		ASSERT_TRUE(executorInstance.Post([&](const CStopToken& bForce) {
+			EXPECT_FALSE(bForce);
+			if (std::this_thread::get_id() == caller) bOnCaller.store(true);
+			ran.fetch_add(1);
+		}));
+	}
+	ASSERT_TRUE(WaitFor([&]() { return ran.load() == TASKS; }));
+	EXPECT_FALSE(bOnCaller.load());
+}
+
+//Hata atan gorev havuz thread'ini sonlandirmaz.
+TEST(TaskExecutor, ThrowingTaskDoesNotStopThePool) {
+	std::atomic<bool> bRan{ false };
+	ASSERT_TRUE(executorInstance.Post([](const CStopToken&) { throw 1; }));
+	ASSERT_TRUE(executorInstance.Post([&](const CStopToken&) { bRan.store(true); }));
+	EXPECT_TRUE(WaitFor([&]() { return bRan.load(); }));
+}
+
+//Durdurma istegi WaitFor'daki gorevi hemen uyandirir.
+TEST(TaskExecutor, SpawnStopsOnRequest) {
+	std::atomic<uint32_t> rounds{ 0 };
+	std::atomic<bool> bExited{ false };
+	TTaskHandle handle = executorInstance.Spawn([&](const CStopToken& bForce) {
+		while (!bForce) {
+			rounds.fetch_add(1);
+			bForce.WaitFor(10s);
+		}
+		bExited.store(true);
+	});
+	ASSERT_TRUE(handle.IsValid());
+	ASSERT_TRUE(WaitFor([&]() { return rounds.load() > 0; }));
+
+	const auto start = std::chrono::steady_clock::now();
+	executorInstance.RequestStop(handle);
+	ASSERT_TRUE(WaitFor([&]() { return bExited.load(); }));
+	EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+	executorInstance.Join(handle);
+	EXPECT_EQ(rounds.load(), 1u);
+}
+
+TEST(TaskExecutor, StopAndJoinWaitsForTheTask) {
+	std::atomic<bool> bExited{ false };
+	TTaskHandle handle = executorInstance.Spawn([&](const CStopToken& bForce) {
+		while (!bForce) std::this_thread::sleep_for(1ms);
+		std::this_thread::sleep_for(20ms);
+		bExited.store(true);
+	});
+	ASSERT_TRUE(handle.IsValid());
+	executorInstance.StopAndJoin(handle);
+	EXPECT_TRUE(bExited.load());
+
+	//toplanmis tutamac tekrar kullanilabilir (etkisiz).
+	executorInstance.StopAndJoin(handle);
+}
+
+//Kapanista bekleyen havuz isleri durdurulmus token ile yine calisir; sonra yeni gorev kabul edilmez.
+TEST(TaskExecutor, ShutdownRejectsNewTasks) {
+	std::atomic<bool> bSpawnedStopped{ false };
+	TTaskHandle handle = executorInstance.Spawn([&](const CStopToken& bForce) {
+		while (!bForce) std::this_thread::sleep_for(1ms);
+		bSpawnedStopped.store(true);
+	});
+	ASSERT_TRUE(handle.IsValid());
+
+	executorInstance.Shutdown();
+	EXPECT_TRUE(bSpawnedStopped.load());
+
+	bool bRan = false;
+	EXPECT_FALSE(executorInstance.Post([&](const CStopToken&) { bRan = true; }));
+	EXPECT_FALSE(executorInstance.Spawn([&](const CStopToken&) { bRan = true; }).IsValid());
+	EXPECT_FALSE(bRan);
+}
+
+//Executor kapaliyken son okuyucu birakirken bekleyen operasyonlar birakan thread'de calisir ve kayit silinir:
+//operasyonlar kaybolmaz, kilit sahipli kalmaz.
+TEST(TaskExecutor, ReadHandOverAfterShutdownRunsInline) {
+	TStore store{};
+	store.Emplace(1);
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(1);
+	executorInstance.Shutdown();
+
+	std::thread::id ranOn{};
+	{
+		auto reader = store.Access(1, ELockType::Read);
+		ASSERT_TRUE(reader);
+		ASSERT_EQ(tracker->AddOperationWithData(record->m_mutexID, [&](std::shared_ptr<TExecutorRecord> _data) {
+			_data->m_value++;
+			ranOn = std::this_thread::get_id();
+		}, record), EAddOperationResult::ADDED);
+	}
+
+	EXPECT_EQ(ranOn, std::this_thread::get_id());
+	EXPECT_EQ(record->m_value, 1u);
+
+	bool bWritten = false;
+	std::thread other([&]() { bWritten = static_cast<bool>(store.Access(1, ELockType::Write)); });
+	other.join();
+	EXPECT_TRUE(bWritten);
+}
@@ -0,0 +1,271 @@
+#include <gtest/gtest.h>
+
+#include <safe_data_store.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace NThreadSafe;
+using namespace NThreadSafe::NLock;
+
+namespace {
+	struct TTrackedRecord : public ISafeData { uint64_t m_value = 0; };
+
+	using TStore = CSafeDataStore<int, std::shared_ptr<TTrackedRecord>>;
+
+	size_t CountPublished(TLockID _lockID) {
+		size_t count = 0;
+		heldRegistryInstance.ForEachPublished([&](TID, TLockID lockID, ELockType, uint64_t, uint64_t) {
+			if (lockID == _lockID) ++count;
+		});
+		return count;
+	}
+
+	template<typename TPred>
+	bool WaitFor(TPred&& _pred) {
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (!_pred()) {
+			if (std::chrono::steady_clock::now() > deadline) return false;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return true;
+	}
+
+	//Devirde okuma kilidi bir thread'de alinip executor thread'inde birakilir; TSAN'in deadlock dedektoru
+	//pthread_rwlock'un baska thread'den birakilmasini izleyemedigi icin devir testleri TSAN altinda atlanir.
+#if defined(__SANITIZE_THREAD__)
+	constexpr bool SKIP_HAND_OVER = true;
+#else
+	constexpr bool SKIP_HAND_OVER = false;
+#endif
+
+	//Bekci yayini sadece kayit aktifken yapilir.
+	class CTrackerReleaseTest : public ::testing::Test {
+	protected:
+		void SetUp() override { heldRegistryInstance.Activate(); }
+		void TearDown() override { heldRegistryInstance.Deactivate(); }
+	};
+}
+
+//Son okuyucu birakirken bekleyen operasyon varsa kilit executor'a devredilir; okuyucunun yayini kalmamali.
+TEST_F(CTrackerReleaseTest, ReadReleaseWithPendingOperationDropsPublication) {
+	if (SKIP_HAND_OVER) GTEST_SKIP() << "cross-thread rwlock release is not supported by the TSAN deadlock detector";
+	TStore store{};
+	store.Emplace(1);
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(1);
+	const TLockID lockID = record->m_mutexID;
+
+	std::atomic<bool> bRan{ false };
+	{
+		auto reader = store.Access(1, ELockType::Read);
+		ASSERT_TRUE(reader);
+		EXPECT_EQ(CountPublished(lockID), 1u);
+		ASSERT_EQ(tracker->AddOperationWithData(lockID, [&](std::shared_ptr<TTrackedRecord> _data) {
+			_data->m_value++;
+			bRan.store(true);
+		}, record), EAddOperationResult::ADDED);
+	}
+
+	ASSERT_TRUE(WaitFor([&]() { return bRan.load(); }));
+	EXPECT_EQ(record->m_value, 1u);
+	EXPECT_EQ(CountPublished(lockID), 0u);
+
+	//kayit executor'da silindikten sonra kilit tekrar alinabilir.
+	ASSERT_TRUE(WaitFor([&]() { return static_cast<bool>(store.Access(1, ELockType::Write)); }));
+}
+
+TEST_F(CTrackerReleaseTest, ReadBatchReleaseWithPendingOperationDropsPublication) {
+	if (SKIP_HAND_OVER) GTEST_SKIP() << "cross-thread rwlock release is not supported by the TSAN deadlock detector";
+	TStore store{};
+	std::vector<int> keys{};
+	for (int key = 0; key < 8; ++key) {
+		store.Emplace(key);
+		keys.push_back(key);
+	}
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(3);
+	const TLockID lockID = record->m_mutexID;
+
+	std::atomic<bool> bRan{ false };
+	{
+		auto batch = store.AccessReadBatch(keys);
+		ASSERT_EQ(batch.GetBusy().size(), 0u);
+		ASSERT_EQ(tracker->AddOperationWithData(lockID, [&](std::shared_ptr<TTrackedRecord>) { bRan.store(true); }, record), EAddOperationResult::ADDED);
+	}
+
+	ASSERT_TRUE(WaitFor([&]() { return bRan.load(); }));
+	for (int key : keys) {
+		EXPECT_EQ(CountPublished(store.Find(key)->m_mutexID), 0u) << "key " << key;
+	}
+}
+
+//Devredilen operasyonlardan biri hata atarsa digerleri yine calisir ve kayit silinir.
+TEST_F(CTrackerReleaseTest, ThrowingHandedOverOperationIsContained) {
+	if (SKIP_HAND_OVER) GTEST_SKIP() << "cross-thread rwlock release is not supported by the TSAN deadlock detector";
+	TStore store{};
+	store.Emplace(1);
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(1);
+
+	std::atomic<bool> bRan{ false };
+	{
+		auto reader = store.Access(1, ELockType::Read);
+		ASSERT_TRUE(reader);
+		ASSERT_EQ(tracker->AddOperationWithData(record->m_mutexID, [](std::shared_ptr<TTrackedRecord>) { throw std::runtime_error("op"); }, record), EAddOperationResult::ADDED);
+		ASSERT_EQ(tracker->AddOperationWithData(record->m_mutexID, [&](std::shared_ptr<TTrackedRecord> _data) {
+			_data->m_value++;
+			bRan.store(true);
+		}, record), EAddOperationResult::ADDED);
+	}
+
+	ASSERT_TRUE(WaitFor([&]() { return bRan.load(); }));
+	EXPECT_EQ(record->m_value, 1u);
+	ASSERT_TRUE(WaitFor([&]() { return static_cast<bool>(store.Access(1, ELockType::Write)); }));
+}
+
+//Yazma kilidi birakilirken operasyonlar birakan thread'de, kilit hala bu thread'deyken calisir.
+//Executor'a devredilseydi std::shared_mutex sahibi olmayan thread'de birakilir ve sonraki yazicilar kilidi alamazdi.
+TEST_F(CTrackerReleaseTest, WriteReleaseRunsOperationsOnReleasingThread) {
+	TStore store{};
+	store.Emplace(1);
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(1);
+	const TLockID lockID = record->m_mutexID;
+
+	std::thread::id ranOn{};
+	{
+		auto writer = store.Access(1, ELockType::Write);
+		ASSERT_TRUE(writer);
+		ASSERT_EQ(tracker->AddOperationWithData(lockID, [&](std::shared_ptr<TTrackedRecord> _data) {
+			_data->m_value++;
+			ranOn = std::this_thread::get_id();
+		}, record), EAddOperationResult::ADDED);
+	}
+
+	EXPECT_EQ(ranOn, std::this_thread::get_id());
+	EXPECT_EQ(record->m_value, 1u);
+	EXPECT_EQ(CountPublished(lockID), 0u);
+
+	bool bWritten = false;
+	std::thread other([&]() { bWritten = static_cast<bool>(store.Access(1, ELockType::Write)); });
+	other.join();
+	EXPECT_TRUE(bWritten);
+}
+
+//Kayit aramasi tracker kilidini almaz: kayitlar surekli eklenip silinirken okunan kayit ya yoktur ya da dogru kilide aittir.
+//Silinen kaydin kilidi ayni anda birakilir; yazicilar birbirini beklemeden ilerler.
+TEST_F(CTrackerReleaseTest, LookupRacesWithRegisterAndRemove) {
+	constexpr int RECORD_COUNT = 4;
+	constexpr uint32_t ROUNDS = 2000;
+	TStore store{};
+	std::vector<TLockID> lockIDs{};
+	for (int key = 0; key < RECORD_COUNT; ++key) {
+		store.Emplace(key);
+		lockIDs.push_back(store.Find(key)->m_mutexID);
+	}
+	auto tracker = store.GetThreadTracker();
+
+	std::atomic<bool> bStop{ false };
+	std::atomic<uint64_t> found{ 0 };
+	std::atomic<uint64_t> mismatched{ 0 };
+	std::thread reader([&]() {
+		while (!bStop.load()) {
+			for (TLockID lockID : lockIDs) {
+				auto mutexData = tracker->GetMutexData(lockID);
+				if (!mutexData) continue;
+				auto iLock = mutexData->GetILock();
+				if (!iLock || iLock->GetMutexID() != lockID) mismatched.fetch_add(1);
+				found.fetch_add(1);
+			}
+		}
+	});
+
+	std::vector<std::thread> writers{};
+	std::atomic<uint32_t> written{ 0 };
+	for (int key = 0; key < RECORD_COUNT; ++key) {
+		writers.emplace_back([&, key]() {
+			for (uint32_t i = 0; i < ROUNDS; ++i) {
+				auto writer = store.Access(key, ELockType::Write);
+				if (!writer) continue;
+				writer->m_value++;
+				written.fetch_add(1);
+			}
+		});
+	}
+	for (auto& writer : writers) writer.join();
+	bStop.store(true);
+	reader.join();
+
+	EXPECT_EQ(written.load(), RECORD_COUNT * ROUNDS);
+	EXPECT_EQ(mismatched.load(), 0u);
+	for (int key = 0; key < RECORD_COUNT; ++key) {
+		EXPECT_EQ(store.Find(key)->m_value, ROUNDS);
+		EXPECT_EQ(tracker->GetMutexData(lockIDs[key]), nullptr);
+	}
+}
+
+//Kaydin kopyasi baska yerde tutulsa da kayit silinince mutex birakilir; eski kopya ile kilit alinamaz.
+TEST_F(CTrackerReleaseTest, RemovedRecordReleasesMutexWhileCopyIsHeld) {
+	TStore store{};
+	store.Emplace(1);
+	auto tracker = store.GetThreadTracker();
+	auto record = store.Find(1);
+	const TLockID lockID = record->m_mutexID;
+
+	std::shared_ptr<TLockData<std::shared_ptr<TTrackedRecord>>> stale = nullptr;
+	{
+		auto writer = store.Access(1, ELockType::Write);
+		ASSERT_TRUE(writer);
+		stale = tracker->GetMutexData(lockID);
+		ASSERT_NE(stale, nullptr);
+	}
+	auto iLock = stale->GetILock();
+	EXPECT_TRUE(iLock->IsRemoved());
+	EXPECT_EQ(tracker->GetMutexData(lockID), nullptr);
+	ASSERT_TRUE(record->m_mutex.try_lock());
+	record->m_mutex.unlock();
+
+	//Eski kayit uzerinden sahiplik eklenmez.
+	iLock->AddOwnership();
+	EXPECT_TRUE(iLock->ShouldRemove());
+
+	bool bWritten = false;
+	std::thread other([&]() { bWritten = static_cast<bool>(store.Access(1, ELockType::Write)); });
+	other.join();
+	EXPECT_TRUE(bWritten);
+	EXPECT_TRUE(static_cast<bool>(store.Access(1, ELockType::Write)));
+}
+
+//Birakilan kilidi uyanan bekleyenlerden once baskasi alirsa bekleyen tekrar bekler; yazicilar hicbir zaman ust uste binmez.
+TEST_F(CTrackerReleaseTest, WokenWaiterDoesNotOvertakeNewOwner) {
+	constexpr uint32_t THREADS = 4;
+	constexpr uint32_t ROUNDS = 500;
+	TStore store{};
+	store.Emplace(1);
+
+	std::atomic<uint32_t> inside{ 0 };
+	std::atomic<uint32_t> overlaps{ 0 };
+	std::atomic<uint32_t> written{ 0 };
+	std::vector<std::thread> writers{};
+	for (uint32_t t = 0; t < THREADS; ++t) {
+		writers.emplace_back([&]() {
+			for (uint32_t i = 0; i < ROUNDS; ++i) {
+				auto writer = store.Access(1, ELockType::Write);
+				if (!writer) continue;
+				if (inside.fetch_add(1) != 0) overlaps.fetch_add(1);
+				writer->m_value++;
+				std::this_thread::yield();
+				inside.fetch_sub(1);
+				written.fetch_add(1);
+			}
+		});
+	}
+	for (auto& writer : writers) writer.join();
+
+	EXPECT_EQ(overlaps.load(), 0u);
+	EXPECT_EQ(store.Find(1)->m_value, written.load());
+}
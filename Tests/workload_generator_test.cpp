@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <Utility/workload_generator.h>
+
+#include <cmath>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace NUtility;
+
+namespace {
+	constexpr size_t SAMPLES = 200000;
+	constexpr double RATIO_TOLERANCE = 0.01; // 200000 ornekte standart sapmanin ~10 kati
+
+	bool SameTransactions(const std::vector<TWorkloadTransaction>& _left, const std::vector<TWorkloadTransaction>& _right) {
+		if (_left.size() != _right.size()) return false;
+		for (size_t i = 0; i < _left.size(); ++i) {
+			const auto& left = _left[i].m_ops;
+			const auto& right = _right[i].m_ops;
+			if (left.size() != right.size()) return false;
+			for (size_t op = 0; op < left.size(); ++op) {
+				if (left[op].m_key != right[op].m_key || left[op].m_access != right[op].m_access) return false;
+			}
+		}
+		return true;
+	}
+
+	TWorkloadConfig MixedConfig() {
+		TWorkloadConfig config{};
+		config.m_seed = 42;
+		config.m_min_key = 1;
+		config.m_max_key = 100;
+		config.m_distribution = EKeyDistribution::Zipfian;
+		config.m_read_weight = 60;
+		config.m_write_weight = 30;
+		config.m_upgrade_weight = 10;
+		config.m_multi_record_percent = 25;
+		config.m_records_per_transaction = 3;
+		return config;
+	}
+
+	//Anahtar basina erisim sayisi, indeks = anahtar - m_min_key.
+	std::vector<uint64_t> CountKeys(const TWorkloadConfig& _config) {
+		CWorkloadGenerator workload(_config);
+		std::vector<uint64_t> counts(static_cast<size_t>(_config.m_max_key - _config.m_min_key + 1), 0);
+		for (size_t i = 0; i < SAMPLES; ++i) {
+			const int key = workload.next_key();
+			if (key < _config.m_min_key || key > _config.m_max_key) {
+				ADD_FAILURE() << "key out of range: " << key;
+				continue;
+			}
+			counts[static_cast<size_t>(key - _config.m_min_key)]++;
+		}
+		return counts;
+	}
+
+	double Ratio(uint64_t _count, uint64_t _total) {
+		return static_cast<double>(_count) / static_cast<double>(_total);
+	}
+}
+
+//Ayni tohum ve akis ayni diziyi uretir: baska thread'de, reset sonrasinda da. Farkli akis veya tohum farkli dizi uretir.
+TEST(WorkloadGenerator, SeedAndStreamReproduceSequence) {
+	constexpr size_t COUNT = 10000;
+	const TWorkloadConfig config = MixedConfig();
+
+	CWorkloadGenerator first(config, 3);
+	const auto expected = first.generate(COUNT);
+
+	std::vector<TWorkloadTransaction> fromThread{};
+	std::thread other([&]() { fromThread = CWorkloadGenerator(config, 3).generate(COUNT); });
+	other.join();
+	EXPECT_TRUE(SameTransactions(expected, fromThread));
+
+	first.reset();
+	EXPECT_TRUE(SameTransactions(expected, first.generate(COUNT)));
+
+	EXPECT_FALSE(SameTransactions(expected, CWorkloadGenerator(config, 4).generate(COUNT)));
+
+	TWorkloadConfig otherSeed = config;
+	otherSeed.m_seed = 43;
+	EXPECT_FALSE(SameTransactions(expected, CWorkloadGenerator(otherSeed, 3).generate(COUNT)));
+}
+
+//Ilk iki anahtarin olasiligi kesin olarak 1/zeta(n) ve 0.5^theta/zeta(n)'dir; erisimler kucuk anahtarlara yigilir.
+TEST(WorkloadGenerator, ZipfianMatchesExpectedRatios) {
+	TWorkloadConfig config{};
+	config.m_seed = 7;
+	config.m_min_key = 1;
+	config.m_max_key = 1000;
+	config.m_distribution = EKeyDistribution::Zipfian;
+	config.m_zipf_theta = 0.99;
+	const auto counts = CountKeys(config);
+
+	double zeta = 0.0;
+	for (int i = 1; i <= 1000; ++i) zeta += 1.0 / std::pow(static_cast<double>(i), config.m_zipf_theta);
+
+	EXPECT_NEAR(Ratio(counts[0], SAMPLES), 1.0 / zeta, RATIO_TOLERANCE);
+	EXPECT_NEAR(Ratio(counts[1], SAMPLES), std::pow(0.5, config.m_zipf_theta) / zeta, RATIO_TOLERANCE);
+	EXPECT_GT(counts[1], counts[9]);
+
+	uint64_t topTen = 0;
+	for (size_t i = 0; i < 10; ++i) topTen += counts[i];
+	uint64_t lastHundred = 0;
+	for (size_t i = counts.size() - 100; i < counts.size(); ++i) lastHundred += counts[i];
+	EXPECT_GT(topTen, 10 * lastHundred);
+}
+
+//Anahtarlarin m_hot_key_fraction kadari erisimlerin m_hot_access_fraction kadarini alir.
+TEST(WorkloadGenerator, HotspotMatchesConfiguredFractions) {
+	TWorkloadConfig config{};
+	config.m_seed = 11;
+	config.m_min_key = 1;
+	config.m_max_key = 100;
+	config.m_distribution = EKeyDistribution::Hotspot;
+	config.m_hot_key_fraction = 0.2;
+	config.m_hot_access_fraction = 0.8;
+	const auto counts = CountKeys(config);
+
+	uint64_t hot = 0;
+	for (size_t i = 0; i < 20; ++i) hot += counts[i];
+	EXPECT_NEAR(Ratio(hot, SAMPLES), 0.8, RATIO_TOLERANCE);
+
+	//Grup icinde dagilim duzgundur.
+	for (size_t i = 0; i < counts.size(); ++i) {
+		const double expected = i < 20 ? 0.8 / 20 : 0.2 / 80;
+		EXPECT_NEAR(Ratio(counts[i], SAMPLES), expected, expected * 0.2) << "key index " << i;
+	}
+}
+
+//Okuma/yazma/yukseltme agirliklari ve cok kayitli islem yuzdesi uyulur; bir islemde ayni kayit tekrar edilmez.
+TEST(WorkloadGenerator, AccessMixAndMultiRecordRatios) {
+	const TWorkloadConfig config = MixedConfig();
+	CWorkloadGenerator workload(config);
+
+	uint64_t ops = 0;
+	uint64_t reads = 0;
+	uint64_t writes = 0;
+	uint64_t upgrades = 0;
+	uint64_t multi = 0;
+	for (size_t i = 0; i < SAMPLES; ++i) {
+		const TWorkloadTransaction txn = workload.next();
+		ASSERT_TRUE(txn.m_ops.size() == 1 || txn.m_ops.size() == config.m_records_per_transaction);
+		if (txn.m_ops.size() > 1) multi++;
+
+		std::set<int> keys{};
+		for (const auto& op : txn.m_ops) {
+			EXPECT_TRUE(keys.insert(op.m_key).second) << "duplicate key " << op.m_key;
+			ops++;
+			switch (op.m_access) {
+			case EWorkloadAccess::Read: reads++; break;
+			case EWorkloadAccess::Write: writes++; break;
+			case EWorkloadAccess::Upgrade: upgrades++; break;
+			}
+		}
+	}
+
+	EXPECT_NEAR(Ratio(multi, SAMPLES), 0.25, RATIO_TOLERANCE);
+	EXPECT_NEAR(Ratio(reads, ops), 0.6, RATIO_TOLERANCE);
+	EXPECT_NEAR(Ratio(writes, ops), 0.3, RATIO_TOLERANCE);
+	EXPECT_NEAR(Ratio(upgrades, ops), 0.1, RATIO_TOLERANCE);
+}
+
+//Ters verilen anahtar araligi duzeltilir; tek anahtarli aralikta cok kayitli islem o anahtarla sinirlanir.
+TEST(WorkloadGenerator, InvalidConfigIsCorrected) {
+	TWorkloadConfig config{};
+	config.m_min_key = 50;
+	config.m_max_key = 10;
+	config.m_distribution = EKeyDistribution::Zipfian;
+	config.m_zipf_theta = 5.0;
+	CWorkloadGenerator workload(config);
+	EXPECT_EQ(workload.get_config().m_min_key, 10);
+	EXPECT_EQ(workload.get_config().m_max_key, 50);
+	EXPECT_LT(workload.get_config().m_zipf_theta, 1.0);
+	for (int i = 0; i < 10000; ++i) {
+		const int key = workload.next_key();
+		ASSERT_GE(key, 10);
+		ASSERT_LE(key, 50);
+	}
+
+	TWorkloadConfig single{};
+	single.m_min_key = 5;
+	single.m_max_key = 5;
+	single.m_multi_record_percent = 100;
+	CWorkloadGenerator singleKey(single);
+	const TWorkloadTransaction txn = singleKey.next();
+	ASSERT_EQ(txn.m_ops.size(), 1u);
+	EXPECT_EQ(txn.m_ops[0].m_key, 5);
+}